@@ -0,0 +1,203 @@
+#include "bench_compare.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+namespace spectral_gate {
+namespace bench {
+
+namespace {
+    const char* verdict_name(Verdict v) {
+        switch (v) {
+            case Verdict::UNCHANGED: return "ok";
+            case Verdict::REGRESSED: return "REGRESSED";
+            case Verdict::IMPROVED:  return "improved";
+            case Verdict::NEW_CASE:  return "new";
+            case Verdict::MISSING:   return "missing";
+        }
+        return "?";
+    }
+
+    double resampled_median(const std::vector<double>& samples,
+                            std::mt19937& rng,
+                            std::vector<double>& scratch) {
+        std::uniform_int_distribution<size_t> pick(0, samples.size() - 1);
+        scratch.resize(samples.size());
+        for (size_t i = 0; i < samples.size(); ++i) {
+            scratch[i] = samples[pick(rng)];
+        }
+        return median(scratch);
+    }
+
+    double percentile(std::vector<double>& sorted, double p) {
+        if (sorted.empty()) {
+            return 0.0;
+        }
+        double pos = p * static_cast<double>(sorted.size() - 1);
+        size_t lo = static_cast<size_t>(pos);
+        size_t hi = std::min(lo + 1, sorted.size() - 1);
+        double frac = pos - static_cast<double>(lo);
+        return sorted[lo] + frac * (sorted[hi] - sorted[lo]);
+    }
+}
+
+bool load_baseline(const std::string& path, std::vector<BaselineEntry>* out) {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    const std::string text = buffer.str();
+
+    out->clear();
+    const std::string id_key = "\"id\": \"";
+    const std::string samples_key = "\"samples_ns\": [";
+
+    size_t pos = 0;
+    while ((pos = text.find(id_key, pos)) != std::string::npos) {
+        pos += id_key.size();
+        size_t id_end = text.find('"', pos);
+        size_t samples_pos = text.find(samples_key, pos);
+        if (id_end == std::string::npos || samples_pos == std::string::npos) {
+            return false;
+        }
+
+        BaselineEntry entry;
+        entry.id = text.substr(pos, id_end - pos);
+
+        const char* cursor = text.c_str() + samples_pos + samples_key.size();
+        while (*cursor != ']' && *cursor != '\0') {
+            char* next = nullptr;
+            double value = std::strtod(cursor, &next);
+            if (next == cursor) {
+                return false;
+            }
+            entry.samples_ns.push_back(value);
+            cursor = next;
+            while (*cursor == ',' || *cursor == ' ') ++cursor;
+        }
+        if (*cursor != ']' || entry.samples_ns.empty()) {
+            return false;
+        }
+
+        out->push_back(entry);
+        pos = static_cast<size_t>(cursor - text.c_str());
+    }
+    return !out->empty();
+}
+
+CompareOptions get_default_compare_options() {
+    CompareOptions options;
+    options.threshold = 0.05;
+    options.confidence = 0.99;
+    options.resamples = 2000;
+    options.seed = 0x5EC7u;
+    return options;
+}
+
+std::vector<Comparison> compare_results(
+    const std::vector<BaselineEntry>& baseline,
+    const std::vector<BenchResult>& current,
+    const CompareOptions& options
+) {
+    std::vector<Comparison> comparisons;
+    std::mt19937 rng(options.seed);
+    std::vector<double> scratch;
+    std::vector<double> ratios;
+    double alpha = 1.0 - options.confidence;
+
+    for (const auto& result : current) {
+        Comparison c;
+        c.id = result.id();
+        c.current_median_ns = result.median_ns;
+        c.baseline_median_ns = 0.0;
+        c.ratio = c.ci_low = c.ci_high = 0.0;
+        c.verdict = Verdict::NEW_CASE;
+
+        auto it = std::find_if(baseline.begin(), baseline.end(),
+                               [&](const BaselineEntry& b) { return b.id == c.id; });
+        if (it == baseline.end() || result.samples_ns.empty()) {
+            comparisons.push_back(c);
+            continue;
+        }
+
+        c.baseline_median_ns = median(it->samples_ns);
+        c.ratio = (c.baseline_median_ns > 0.0) ? c.current_median_ns / c.baseline_median_ns : 0.0;
+
+        // Percentile bootstrap of the median ratio; both runs are noisy,
+        // so both sample sets are resampled
+        ratios.clear();
+        ratios.reserve(options.resamples);
+        for (size_t r = 0; r < options.resamples; ++r) {
+            double base = resampled_median(it->samples_ns, rng, scratch);
+            double cur = resampled_median(result.samples_ns, rng, scratch);
+            if (base > 0.0) {
+                ratios.push_back(cur / base);
+            }
+        }
+        std::sort(ratios.begin(), ratios.end());
+        c.ci_low = percentile(ratios, alpha / 2.0);
+        c.ci_high = percentile(ratios, 1.0 - alpha / 2.0);
+
+        if (c.ci_low > 1.0 + options.threshold) {
+            c.verdict = Verdict::REGRESSED;
+        } else if (c.ci_high < 1.0 - options.threshold) {
+            c.verdict = Verdict::IMPROVED;
+        } else {
+            c.verdict = Verdict::UNCHANGED;
+        }
+        comparisons.push_back(c);
+    }
+
+    for (const auto& b : baseline) {
+        bool ran = std::any_of(current.begin(), current.end(),
+                               [&](const BenchResult& r) { return r.id() == b.id; });
+        if (!ran) {
+            Comparison c;
+            c.id = b.id;
+            c.baseline_median_ns = median(b.samples_ns);
+            c.current_median_ns = 0.0;
+            c.ratio = c.ci_low = c.ci_high = 0.0;
+            c.verdict = Verdict::MISSING;
+            comparisons.push_back(c);
+        }
+    }
+    return comparisons;
+}
+
+void print_comparison(std::ostream& os, const std::vector<Comparison>& comparisons) {
+    os << std::left << std::setw(64) << "Benchmark"
+       << std::right << std::setw(14) << "base (ns)"
+       << std::setw(14) << "current (ns)"
+       << std::setw(9) << "ratio"
+       << std::setw(20) << "CI"
+       << std::setw(12) << "verdict" << "\n";
+    os << std::string(133, '-') << "\n";
+
+    for (const auto& c : comparisons) {
+        os << std::left << std::setw(64) << c.id
+           << std::right << std::fixed << std::setprecision(1)
+           << std::setw(14) << c.baseline_median_ns
+           << std::setw(14) << c.current_median_ns;
+        if (c.verdict == Verdict::NEW_CASE || c.verdict == Verdict::MISSING) {
+            os << std::setw(9) << "-" << std::setw(20) << "-";
+        } else {
+            std::ostringstream ci;
+            ci << std::fixed << std::setprecision(3) << "[" << c.ci_low << ", " << c.ci_high << "]";
+            os << std::setprecision(3) << std::setw(9) << c.ratio << std::setw(20) << ci.str();
+        }
+        os << std::setw(12) << verdict_name(c.verdict) << "\n";
+    }
+}
+
+size_t count_regressions(const std::vector<Comparison>& comparisons) {
+    return static_cast<size_t>(std::count_if(comparisons.begin(), comparisons.end(),
+        [](const Comparison& c) { return c.verdict == Verdict::REGRESSED; }));
+}
+
+} // namespace bench
+} // namespace spectral_gate
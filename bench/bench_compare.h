@@ -0,0 +1,93 @@
+#ifndef BENCH_COMPARE_H
+#define BENCH_COMPARE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "bench_harness.h"
+
+namespace spectral_gate {
+namespace bench {
+
+/**
+ * @brief One benchmark case read back from a JSON results file
+ */
+struct BaselineEntry {
+    std::string id;
+    std::vector<double> samples_ns;
+};
+
+/**
+ * @brief Load a file written by BenchSuite::write_json()
+ *
+ * Only the fields needed for comparison (id and raw samples) are read;
+ * this is not a general JSON parser.
+ *
+ * @return false if the file is missing or malformed
+ */
+bool load_baseline(const std::string& path, std::vector<BaselineEntry>* out);
+
+/**
+ * @brief Regression gate settings
+ */
+struct CompareOptions {
+    double threshold;       // Relative slowdown tolerated (0.05 = 5%)
+    double confidence;      // Two-sided CI level (e.g. 0.99)
+    size_t resamples;       // Bootstrap resamples per case
+    uint32_t seed;          // Fixed seed keeps verdicts reproducible
+};
+
+/**
+ * @brief Default gate: 5% threshold, 99% CI, 2000 resamples
+ */
+CompareOptions get_default_compare_options();
+
+enum class Verdict : uint8_t {
+    UNCHANGED,      // CI overlaps the tolerance band
+    REGRESSED,      // Whole CI above 1 + threshold
+    IMPROVED,       // Whole CI below 1 - threshold
+    NEW_CASE,       // Not in the baseline
+    MISSING         // In the baseline but not run
+};
+
+/**
+ * @brief Comparison of one benchmark case against its baseline
+ *
+ * ratio is current median / baseline median; ci_low/ci_high bound it
+ * from a percentile bootstrap that resamples both sample sets.
+ */
+struct Comparison {
+    std::string id;
+    double baseline_median_ns;
+    double current_median_ns;
+    double ratio;
+    double ci_low;
+    double ci_high;
+    Verdict verdict;
+};
+
+/**
+ * @brief Compare current results with a baseline case by case
+ */
+std::vector<Comparison> compare_results(
+    const std::vector<BaselineEntry>& baseline,
+    const std::vector<BenchResult>& current,
+    const CompareOptions& options
+);
+
+/**
+ * @brief Print a comparison table
+ */
+void print_comparison(std::ostream& os, const std::vector<Comparison>& comparisons);
+
+/**
+ * @brief Number of cases whose verdict is REGRESSED
+ */
+size_t count_regressions(const std::vector<Comparison>& comparisons);
+
+} // namespace bench
+} // namespace spectral_gate
+
+#endif // BENCH_COMPARE_H
@@ -0,0 +1,222 @@
+#include "bench_harness.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace spectral_gate {
+namespace bench {
+
+BenchOptions get_default_options() {
+    BenchOptions options;
+    options.warmup_reps = 3;
+    options.repetitions = 15;
+    options.min_rep_ns = 500000.0;  // 0.5 ms
+    return options;
+}
+
+std::string BenchResult::id() const {
+    std::string out = name;
+    if (!params.empty()) {
+        out += "[";
+        for (size_t i = 0; i < params.size(); ++i) {
+            if (i > 0) out += ",";
+            out += params[i].key + "=" + std::to_string(params[i].value);
+        }
+        out += "]";
+    }
+    return out;
+}
+
+double median(std::vector<double> values) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    size_t mid = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + mid, values.end());
+    double upper = values[mid];
+    if (values.size() % 2 == 1) {
+        return upper;
+    }
+    double lower = *std::max_element(values.begin(), values.begin() + mid);
+    return 0.5 * (lower + upper);
+}
+
+double median_absolute_deviation(const std::vector<double>& values, double center) {
+    std::vector<double> deviations;
+    deviations.reserve(values.size());
+    for (double v : values) {
+        deviations.push_back(std::fabs(v - center));
+    }
+    return median(deviations);
+}
+
+double BenchResult::ipc() const {
+    size_t cyc = static_cast<size_t>(PerfEvent::CYCLES);
+    size_t ins = static_cast<size_t>(PerfEvent::INSTRUCTIONS);
+    if (!counters.valid[cyc] || !counters.valid[ins] || counters.values[cyc] <= 0.0) {
+        return 0.0;
+    }
+    return counters.values[ins] / counters.values[cyc];
+}
+
+BenchSuite::BenchSuite(const BenchOptions& options)
+    : options_(options),
+      counters_(nullptr)
+{
+}
+
+void BenchSuite::begin_counters() {
+    if (counters_ != nullptr) {
+        counters_->start();
+    }
+}
+
+void BenchSuite::end_counters(BenchResult& result, double total_calls) {
+    for (size_t i = 0; i < NUM_PERF_EVENTS; ++i) {
+        result.counters.valid[i] = false;
+        result.counters.values[i] = 0.0;
+    }
+    if (counters_ == nullptr || total_calls <= 0.0) {
+        return;
+    }
+
+    PerfReading reading = counters_->stop();
+    for (size_t i = 0; i < NUM_PERF_EVENTS; ++i) {
+        result.counters.valid[i] = reading.valid[i];
+        result.counters.values[i] = reading.values[i] / total_calls;
+    }
+}
+
+void BenchSuite::finish(BenchResult& result) {
+    result.median_ns = median(result.samples_ns);
+    result.mad_ns = median_absolute_deviation(result.samples_ns, result.median_ns);
+    result.min_ns = result.samples_ns.empty()
+                    ? 0.0
+                    : *std::min_element(result.samples_ns.begin(), result.samples_ns.end());
+    results_.push_back(result);
+}
+
+void BenchSuite::print_table(std::ostream& os) const {
+    bool with_counters = (counters_ != nullptr);
+
+    os << std::left << std::setw(64) << "Benchmark"
+       << std::right << std::setw(14) << "median (ns)"
+       << std::setw(12) << "MAD (ns)"
+       << std::setw(14) << "min (ns)";
+    if (with_counters) {
+        os << std::setw(14) << "cycles" << std::setw(8) << "IPC"
+           << std::setw(12) << "L1D miss" << std::setw(12) << "LLC miss"
+           << std::setw(12) << "br miss";
+    }
+    os << "\n" << std::string(with_counters ? 162 : 104, '-') << "\n";
+
+    for (const auto& r : results_) {
+        os << std::left << std::setw(64) << r.id()
+           << std::right << std::fixed << std::setprecision(1)
+           << std::setw(14) << r.median_ns
+           << std::setw(12) << r.mad_ns
+           << std::setw(14) << r.min_ns;
+        if (with_counters) {
+            auto cell = [&](PerfEvent e, int width) {
+                size_t i = static_cast<size_t>(e);
+                if (r.counters.valid[i]) {
+                    os << std::setw(width) << r.counters.values[i];
+                } else {
+                    os << std::setw(width) << "n/a";
+                }
+            };
+            cell(PerfEvent::CYCLES, 14);
+            if (r.ipc() > 0.0) {
+                os << std::setw(8) << std::setprecision(2) << r.ipc() << std::setprecision(1);
+            } else {
+                os << std::setw(8) << "n/a";
+            }
+            cell(PerfEvent::L1D_MISSES, 12);
+            cell(PerfEvent::LLC_MISSES, 12);
+            cell(PerfEvent::BRANCH_MISSES, 12);
+        }
+        os << "\n";
+    }
+}
+
+bool BenchSuite::write_json(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+
+    out << std::setprecision(17);
+    out << "{\n  \"suite\": \"spectral_gate_bench\",\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results_.size(); ++i) {
+        const BenchResult& r = results_[i];
+        out << "    {\"id\": \"" << r.id() << "\", \"name\": \"" << r.name << "\", \"params\": {";
+        for (size_t p = 0; p < r.params.size(); ++p) {
+            if (p > 0) out << ", ";
+            out << "\"" << r.params[p].key << "\": " << r.params[p].value;
+        }
+        out << "}, \"iterations\": " << r.iterations
+            << ", \"median_ns\": " << r.median_ns
+            << ", \"mad_ns\": " << r.mad_ns
+            << ", \"min_ns\": " << r.min_ns;
+        if (counters_ != nullptr) {
+            out << ", \"counters\": {";
+            bool first = true;
+            for (size_t c = 0; c < NUM_PERF_EVENTS; ++c) {
+                if (!r.counters.valid[c]) continue;
+                out << (first ? "" : ", ") << "\"" << perf_event_name(static_cast<PerfEvent>(c))
+                    << "\": " << r.counters.values[c];
+                first = false;
+            }
+            if (r.ipc() > 0.0) {
+                out << (first ? "" : ", ") << "\"ipc\": " << r.ipc();
+            }
+            out << "}";
+        }
+        out << ", \"samples_ns\": [";
+        for (size_t s = 0; s < r.samples_ns.size(); ++s) {
+            if (s > 0) out << ", ";
+            out << r.samples_ns[s];
+        }
+        out << "]}" << (i + 1 < results_.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+bool BenchSuite::write_csv(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+
+    out << "id,name,params,iterations,median_ns,mad_ns,min_ns";
+    for (size_t c = 0; c < NUM_PERF_EVENTS; ++c) {
+        out << "," << perf_event_name(static_cast<PerfEvent>(c));
+    }
+    out << ",ipc\n";
+    out << std::setprecision(6) << std::fixed;
+    for (const auto& r : results_) {
+        std::string params;
+        for (size_t p = 0; p < r.params.size(); ++p) {
+            if (p > 0) params += ";";
+            params += r.params[p].key + "=" + std::to_string(r.params[p].value);
+        }
+        out << "\"" << r.id() << "\"," << r.name << "," << params << ","
+            << r.iterations << "," << r.median_ns << "," << r.mad_ns << ","
+            << r.min_ns;
+        // Counter columns stay empty when not collected or unavailable
+        for (size_t c = 0; c < NUM_PERF_EVENTS; ++c) {
+            out << ",";
+            if (r.counters.valid[c]) out << r.counters.values[c];
+        }
+        out << ",";
+        if (r.ipc() > 0.0) out << r.ipc();
+        out << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+} // namespace bench
+} // namespace spectral_gate
@@ -0,0 +1,181 @@
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "perf_counters.h"
+
+namespace spectral_gate {
+namespace bench {
+
+/**
+ * @brief Keep a value alive so the optimizer cannot drop the computation
+ */
+template <typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief Timing policy shared by all benchmarks
+ */
+struct BenchOptions {
+    size_t warmup_reps;         // Repetitions discarded before measuring
+    size_t repetitions;         // Measured repetitions (one sample each)
+    double min_rep_ns;          // Calibrate calls per repetition to at least this
+};
+
+/**
+ * @brief Default policy: 3 warmup + 15 measured repetitions of >= 0.5 ms
+ */
+BenchOptions get_default_options();
+
+/**
+ * @brief Named integer parameter of a benchmark case (e.g. window=256)
+ */
+struct BenchParam {
+    std::string key;
+    long long value;
+};
+
+/**
+ * @brief Timing result of one benchmark case
+ */
+struct BenchResult {
+    std::string name;
+    std::vector<BenchParam> params;
+    size_t iterations;                  // Kernel calls per repetition
+    std::vector<double> samples_ns;     // Per-call time of each repetition
+    double median_ns;
+    double mad_ns;                      // Median absolute deviation
+    double min_ns;
+    PerfReading counters;               // Hardware events per call (if collected)
+
+    /**
+     * @brief Instructions per cycle, or 0 if either counter is missing
+     */
+    double ipc() const;
+
+    /**
+     * @brief Stable identifier: name[key=value,...]
+     */
+    std::string id() const;
+};
+
+/**
+ * @brief Median of a sample set (copy is sorted)
+ */
+double median(std::vector<double> values);
+
+/**
+ * @brief Median absolute deviation around a given median
+ */
+double median_absolute_deviation(const std::vector<double>& values, double center);
+
+/**
+ * @brief Collects timed benchmark cases and emits reports
+ */
+class BenchSuite {
+public:
+    explicit BenchSuite(const BenchOptions& options);
+
+    /**
+     * @brief Time fn() with warmup, calibration and repetitions
+     * @param name Benchmark name (e.g. "spectral/compute_magnitude_spectrum")
+     * @param params Case parameters
+     * @param fn Callable executing one kernel call
+     */
+    template <typename Fn>
+    void run(const std::string& name, const std::vector<BenchParam>& params, Fn&& fn);
+
+    /**
+     * @brief Collect hardware counters over measured repetitions
+     * @param counters Counter set (nullptr disables collection)
+     */
+    void set_perf_counters(PerfCounters* counters) { counters_ = counters; }
+
+    const std::vector<BenchResult>& results() const { return results_; }
+
+    /**
+     * @brief Print a human-readable table
+     */
+    void print_table(std::ostream& os) const;
+
+    /**
+     * @brief Write results (including raw samples) as JSON
+     * @return true on success
+     */
+    bool write_json(const std::string& path) const;
+
+    /**
+     * @brief Write one CSV row per benchmark case
+     * @return true on success
+     */
+    bool write_csv(const std::string& path) const;
+
+private:
+    BenchOptions options_;
+    PerfCounters* counters_;
+    std::vector<BenchResult> results_;
+
+    void begin_counters();
+    void end_counters(BenchResult& result, double total_calls);
+    void finish(BenchResult& result);
+};
+
+template <typename Fn>
+void BenchSuite::run(const std::string& name, const std::vector<BenchParam>& params, Fn&& fn) {
+    using clock = std::chrono::steady_clock;
+
+    auto time_calls = [&fn](size_t calls) {
+        auto start = clock::now();
+        for (size_t i = 0; i < calls; ++i) {
+            fn();
+        }
+        auto stop = clock::now();
+        return static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+    };
+
+    // Calibrate: grow the batch until one repetition is long enough to
+    // swamp clock resolution
+    size_t calls = 1;
+    while (calls < (size_t(1) << 30)) {
+        double elapsed = time_calls(calls);
+        if (elapsed >= options_.min_rep_ns) {
+            break;
+        }
+        calls *= 2;
+    }
+
+    for (size_t r = 0; r < options_.warmup_reps; ++r) {
+        time_calls(calls);
+    }
+
+    BenchResult result;
+    result.name = name;
+    result.params = params;
+    result.iterations = calls;
+    result.samples_ns.reserve(options_.repetitions);
+    begin_counters();
+    for (size_t r = 0; r < options_.repetitions; ++r) {
+        result.samples_ns.push_back(time_calls(calls) / static_cast<double>(calls));
+    }
+    end_counters(result, static_cast<double>(calls) * static_cast<double>(options_.repetitions));
+
+    finish(result);
+}
+
+} // namespace bench
+} // namespace spectral_gate
+
+#endif // BENCH_HARNESS_H
@@ -0,0 +1,390 @@
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench_compare.h"
+#include "bench_harness.h"
+#include "bench_sweep.h"
+#include "perf_counters.h"
+#include "core/decision.h"
+#include "core/inference.h"
+#include "core/latency_probe.h"
+#include "core/pipeline.h"
+#include "core/prefilter.h"
+#include "core/spectral.h"
+#include "core/trace.h"
+#include "host/trace_export.h"
+
+using namespace spectral_gate;
+
+/**
+ * @brief Spectral-Gate micro/macro benchmark suite
+ * 
+ * Times each kernel of the per-window path across window and bin sizes,
+ * plus the end-to-end WindowPipeline. No external dependencies.
+ */
+
+namespace {
+
+struct BenchCliOptions {
+    bench::BenchOptions timing;
+    std::string json_path;
+    std::string csv_path;
+    std::string filter;
+    std::string baseline_path;
+    std::string sweep_path;
+    std::string trace_path;
+    bench::CompareOptions compare;
+    bool quick;
+    bool perf;
+    bool latency;
+};
+
+// Deterministic multi-tone window with LCG noise (same data every run)
+std::vector<int16_t> make_window(size_t length) {
+    std::vector<int16_t> window(length);
+    uint32_t lcg = 12345;
+    for (size_t i = 0; i < length; ++i) {
+        lcg = lcg * 1664525u + 1013904223u;
+        int32_t noise = static_cast<int32_t>((lcg >> 16) & 0x3FF) - 512;
+        double t = static_cast<double>(i) / 1000.0;
+        double value = 4000.0 * std::sin(2.0 * 3.14159265358979 * 50.0 * t) +
+                       2400.0 * std::sin(2.0 * 3.14159265358979 * 150.0 * t) +
+                       3200.0 * std::sin(2.0 * 3.14159265358979 * 237.0 * t);
+        window[i] = static_cast<int16_t>(value + noise);
+    }
+    return window;
+}
+
+bool selected(const BenchCliOptions& cli, const std::string& name) {
+    return cli.filter.empty() || name.find(cli.filter) != std::string::npos;
+}
+
+void register_spectral(bench::BenchSuite& suite, const BenchCliOptions& cli) {
+    const std::vector<size_t> windows = cli.quick ? std::vector<size_t>{256}
+                                                  : std::vector<size_t>{128, 256, 512, 1024};
+    const std::vector<size_t> bin_counts = cli.quick ? std::vector<size_t>{64}
+                                                     : std::vector<size_t>{32, 64, 128};
+
+    for (size_t window_length : windows) {
+        std::vector<int16_t> window = make_window(window_length);
+
+        for (size_t bins : bin_counts) {
+            core::SpectralProcessor proc(bins, 1000);
+            std::vector<hal::fixed_t> magnitudes(bins);
+            std::vector<bench::BenchParam> params = {
+                {"window", static_cast<long long>(window_length)},
+                {"bins", static_cast<long long>(bins)}
+            };
+
+            if (selected(cli, "spectral/compute_magnitude_spectrum")) {
+                suite.run("spectral/compute_magnitude_spectrum", params, [&] {
+                    proc.compute_magnitude_spectrum(window.data(), window.size(), magnitudes.data());
+                    bench::do_not_optimize(magnitudes[0]);
+                });
+            }
+
+            if (selected(cli, "spectral/extract_features")) {
+                suite.run("spectral/extract_features", params, [&] {
+                    size_t n = proc.extract_features(window.data(), window.size(),
+                                                     magnitudes.data(), magnitudes.size());
+                    bench::do_not_optimize(n);
+                });
+            }
+
+            if (selected(cli, "spectral/process")) {
+                suite.run("spectral/process", params, [&] {
+                    core::SpectralResult r = proc.process(window.data(), window.size());
+                    bench::do_not_optimize(r);
+                });
+            }
+        }
+    }
+
+    // Peak search depends only on the bin count
+    for (size_t bins : bin_counts) {
+        if (!selected(cli, "spectral/find_peaks")) break;
+
+        core::SpectralProcessor proc(bins, 1000);
+        std::vector<int16_t> window = make_window(256);
+        std::vector<hal::fixed_t> magnitudes(bins);
+        proc.compute_magnitude_spectrum(window.data(), window.size(), magnitudes.data());
+        hal::fixed_t threshold = magnitudes[1] / 5;
+
+        suite.run("spectral/find_peaks", {{"bins", static_cast<long long>(bins)}}, [&] {
+            uint8_t peaks = proc.find_peaks(magnitudes.data(), magnitudes.size(), threshold);
+            bench::do_not_optimize(peaks);
+        });
+    }
+}
+
+void register_inference(bench::BenchSuite& suite, const BenchCliOptions& cli) {
+    if (!selected(cli, "inference/run")) return;
+
+    core::InferenceEngine engine = core::create_default_engine();
+    core::SpectralProcessor proc(engine.get_input_size(), 1000);
+    std::vector<int16_t> window = make_window(256);
+    std::vector<hal::fixed_t> features(engine.get_input_size());
+    proc.extract_features(window.data(), window.size(), features.data(), features.size());
+
+    suite.run("inference/run", {{"inputs", static_cast<long long>(features.size())}}, [&] {
+        core::InferenceResult r = engine.run(features.data(), features.size());
+        bench::do_not_optimize(r);
+    });
+}
+
+void register_decision(bench::BenchSuite& suite, const BenchCliOptions& cli) {
+    if (!selected(cli, "decision/evaluate_structure")) return;
+
+    core::ThresholdConfig config = core::get_default_config();
+    core::SpectralResult spectral{};
+    spectral.num_peaks = 3;
+    spectral.peak_magnitude = hal::float_to_fixed(0.5f);
+    core::InferenceResult inference{};
+    inference.confidence = hal::float_to_fixed(0.6f);
+    inference.predicted_class = 1;
+
+    // Cycle through battery tiers so every branch is exercised
+    const uint16_t batteries[] = {4100, 3200, 2900, 3500};
+    size_t tick = 0;
+
+    suite.run("decision/evaluate_structure", {}, [&] {
+        uint16_t battery = batteries[tick++ & 3];
+        bench::do_not_optimize(battery);
+        core::Decision d = core::evaluate_structure(spectral, inference, battery, config);
+        bench::do_not_optimize(d);
+    });
+}
+
+void register_latency_probe(bench::BenchSuite& suite, const BenchCliOptions& cli) {
+#if defined(SPECTRAL_GATE_LATENCY_PROBES)
+    if (!selected(cli, "latency/probe")) return;
+
+    // Cost of one empty probe scope (two tick reads + histogram update)
+    suite.run("latency/probe", {}, [&] {
+        SG_LATENCY_PROBE(DECISION);
+    });
+    core::latency::reset();
+#else
+    (void)suite;
+    (void)cli;
+#endif
+}
+
+void print_latency(std::ostream& os) {
+    os << "\nPer-stage latency (process_window probes, ns)\n";
+    os << std::left << std::setw(12) << "stage" << std::right
+       << std::setw(12) << "count" << std::setw(12) << "mean"
+       << std::setw(12) << "p50" << std::setw(12) << "p99"
+       << std::setw(12) << "p99.9" << std::setw(12) << "max" << "\n";
+    for (size_t s = 0; s < core::NUM_LATENCY_STAGES; ++s) {
+        core::LatencyStage stage = static_cast<core::LatencyStage>(s);
+        core::LatencySummary l = core::latency::get_summary(stage);
+        os << std::left << std::setw(12) << core::latency_stage_name(stage) << std::right
+           << std::fixed << std::setprecision(0)
+           << std::setw(12) << l.count << std::setw(12) << l.mean_ns
+           << std::setw(12) << l.p50_ns << std::setw(12) << l.p99_ns
+           << std::setw(12) << l.p999_ns << std::setw(12) << l.max_ns << "\n";
+    }
+}
+
+bool finish_trace(const BenchCliOptions& cli) {
+    if (cli.trace_path.empty()) {
+        return true;
+    }
+    core::trace::set_enabled(false);
+    if (!host::write_chrome_trace(cli.trace_path)) {
+        std::cerr << "Failed to write trace " << cli.trace_path << "\n";
+        return false;
+    }
+    return true;
+}
+
+void register_pipeline(bench::BenchSuite& suite, const BenchCliOptions& cli) {
+    if (!selected(cli, "pipeline/process_window")) return;
+
+    const std::vector<size_t> windows = cli.quick ? std::vector<size_t>{256}
+                                                  : std::vector<size_t>{128, 256, 512, 1024};
+
+    core::InferenceEngine engine = core::create_default_engine();
+    core::SpectralProcessor proc(engine.get_input_size(), 1000);
+
+    for (size_t window_length : windows) {
+        std::vector<int16_t> source = make_window(window_length);
+        std::vector<int16_t> window(window_length);
+
+        for (int prefiltered = 0; prefiltered <= 1; ++prefiltered) {
+            core::PreFilter prefilter = core::create_default_prefilter(1000, 50);
+            core::WindowPipeline pipeline(proc, engine, core::get_default_config());
+            if (prefiltered) {
+                pipeline.set_prefilter(&prefilter);
+            }
+
+            suite.run("pipeline/process_window",
+                      {{"window", static_cast<long long>(window_length)},
+                       {"prefilter", prefiltered}},
+                      [&] {
+                std::memcpy(window.data(), source.data(), window_length * sizeof(int16_t));
+                core::WindowOutcome o = pipeline.process_window(
+                    window.data(), window_length, hal::BATTERY_NOMINAL_MV);
+                bench::do_not_optimize(o);
+            });
+        }
+    }
+}
+
+void print_usage() {
+    std::cout << "Usage: spectral_gate_bench [options]\n"
+              << "  --json PATH      Write JSON results (with raw samples)\n"
+              << "  --csv PATH       Write CSV summary\n"
+              << "  --filter TEXT    Only run benchmarks whose name contains TEXT\n"
+              << "  --reps N         Measured repetitions (default 15)\n"
+              << "  --warmup N       Warmup repetitions (default 3)\n"
+              << "  --min-rep-us N   Minimum time per repetition (default 500)\n"
+              << "  --quick          Reduced case matrix for smoke runs\n"
+              << "  --perf           Collect hardware counters (Linux perf_event_open)\n"
+              << "  --latency        Print per-stage probe histograms after the run\n"
+              << "  --compare PATH   Compare with a baseline JSON; exit 2 on regression\n"
+              << "  --threshold PCT  Regression threshold for --compare (default 5)\n"
+              << "  --sweep PATH     Run the window/bins/batch/threads scaling sweep to CSV\n"
+              << "  --trace PATH     Write a Chrome trace (Perfetto) of the run\n";
+}
+
+bool parse_args(int argc, char* argv[], BenchCliOptions* cli) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--quick") {
+            cli->quick = true;
+            continue;
+        }
+        if (arg == "--perf") {
+            cli->perf = true;
+            continue;
+        }
+        if (arg == "--latency") {
+            cli->latency = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return false;
+        }
+        std::string value = argv[++i];
+        if (arg == "--json") {
+            cli->json_path = value;
+        } else if (arg == "--csv") {
+            cli->csv_path = value;
+        } else if (arg == "--filter") {
+            cli->filter = value;
+        } else if (arg == "--reps") {
+            cli->timing.repetitions = std::strtoul(value.c_str(), nullptr, 10);
+        } else if (arg == "--warmup") {
+            cli->timing.warmup_reps = std::strtoul(value.c_str(), nullptr, 10);
+        } else if (arg == "--compare") {
+            cli->baseline_path = value;
+        } else if (arg == "--trace") {
+            cli->trace_path = value;
+        } else if (arg == "--sweep") {
+            cli->sweep_path = value;
+        } else if (arg == "--threshold") {
+            cli->compare.threshold = std::strtod(value.c_str(), nullptr) / 100.0;
+        } else if (arg == "--min-rep-us") {
+            cli->timing.min_rep_ns = std::strtod(value.c_str(), nullptr) * 1000.0;
+        } else {
+            return false;
+        }
+    }
+    return cli->timing.repetitions > 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchCliOptions cli;
+    cli.timing = bench::get_default_options();
+    cli.compare = bench::get_default_compare_options();
+    cli.quick = false;
+    cli.perf = false;
+    cli.latency = false;
+
+    if (!parse_args(argc, argv, &cli)) {
+        print_usage();
+        return 1;
+    }
+
+    if (!cli.trace_path.empty()) {
+        core::trace::set_enabled(true);
+        SG_TRACE_THREAD_NAME("bench main");
+    }
+
+    if (!cli.sweep_path.empty()) {
+        if (!bench::run_sweep(cli.timing, bench::get_default_sweep_grid(cli.quick), cli.sweep_path)) {
+            std::cerr << "Failed to write " << cli.sweep_path << "\n";
+            return 1;
+        }
+        return finish_trace(cli) ? 0 : 1;
+    }
+
+    // Load the baseline up front so a bad path fails before the long run
+    std::vector<bench::BaselineEntry> baseline;
+    if (!cli.baseline_path.empty() && !bench::load_baseline(cli.baseline_path, &baseline)) {
+        std::cerr << "Failed to load baseline " << cli.baseline_path << "\n";
+        return 1;
+    }
+
+    bench::BenchSuite suite(cli.timing);
+
+    bench::PerfCounters counters;
+    if (cli.perf) {
+        if (counters.available()) {
+            suite.set_perf_counters(&counters);
+        } else {
+            std::cerr << "Hardware counters unavailable (perf_event_paranoid, seccomp "
+                         "or no PMU); reporting wall-clock only\n";
+        }
+    }
+    register_spectral(suite, cli);
+    register_inference(suite, cli);
+    register_decision(suite, cli);
+    register_latency_probe(suite, cli);
+    register_pipeline(suite, cli);
+
+    suite.print_table(std::cout);
+    if (!finish_trace(cli)) {
+        return 1;
+    }
+    if (cli.latency) {
+        if (core::latency::ENABLED) {
+            print_latency(std::cout);
+        } else {
+            std::cerr << "Latency probes compiled out (SPECTRAL_GATE_LATENCY_PROBES=OFF)\n";
+        }
+    }
+
+    if (!cli.json_path.empty() && !suite.write_json(cli.json_path)) {
+        std::cerr << "Failed to write " << cli.json_path << "\n";
+        return 1;
+    }
+    if (!cli.csv_path.empty() && !suite.write_csv(cli.csv_path)) {
+        std::cerr << "Failed to write " << cli.csv_path << "\n";
+        return 1;
+    }
+
+    if (!baseline.empty()) {
+        std::vector<bench::Comparison> comparisons =
+            bench::compare_results(baseline, suite.results(), cli.compare);
+        std::cout << "\n";
+        bench::print_comparison(std::cout, comparisons);
+
+        size_t regressions = bench::count_regressions(comparisons);
+        if (regressions > 0) {
+            std::cerr << regressions << " benchmark(s) regressed beyond "
+                      << cli.compare.threshold * 100.0 << "%\n";
+            return 2;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,158 @@
+#include "bench_sweep.h"
+#include "parallel.h"
+#include "core/inference.h"
+#include "core/spectral.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+namespace spectral_gate {
+namespace bench {
+
+namespace {
+    struct SweepRow {
+        const char* path;
+        size_t window;
+        size_t bins;
+        size_t batch;
+        unsigned threads;
+        BenchResult result;
+    };
+
+    // Same deterministic tone mix as the main suite, offset per window so
+    // batch members differ
+    std::vector<int16_t> make_batch(size_t window, size_t batch) {
+        std::vector<int16_t> samples(window * batch);
+        uint32_t lcg = 12345;
+        for (size_t i = 0; i < samples.size(); ++i) {
+            lcg = lcg * 1664525u + 1013904223u;
+            int32_t noise = static_cast<int32_t>((lcg >> 16) & 0x3FF) - 512;
+            double t = static_cast<double>(i) / 1000.0;
+            double value = 4000.0 * std::sin(2.0 * 3.14159265358979 * 50.0 * t) +
+                           3200.0 * std::sin(2.0 * 3.14159265358979 * 237.0 * t);
+            samples[i] = static_cast<int16_t>(value + noise);
+        }
+        return samples;
+    }
+
+    bool write_rows(const std::string& path, const std::vector<SweepRow>& rows) {
+        std::ofstream out(path);
+        if (!out) {
+            return false;
+        }
+        out << "path,window,bins,batch,threads,median_ns,mad_ns,"
+               "ns_per_window,windows_per_sec,ns_per_sample_bin\n";
+        for (const auto& row : rows) {
+            double per_window = row.result.median_ns / static_cast<double>(row.batch);
+            out << row.path << ","
+                << row.window << ","
+                << row.bins << ","
+                << row.batch << ","
+                << row.threads << ","
+                << row.result.median_ns << ","
+                << row.result.mad_ns << ","
+                << per_window << ","
+                << ((per_window > 0.0) ? 1e9 / per_window : 0.0) << ",";
+            // DFT cost normalized by window x bins (left empty for inference)
+            if (row.window > 0) {
+                out << per_window / static_cast<double>(row.window * row.bins);
+            }
+            out << "\n";
+        }
+        return static_cast<bool>(out);
+    }
+}
+
+SweepGrid get_default_sweep_grid(bool quick) {
+    SweepGrid grid;
+    if (quick) {
+        grid.windows = {128, 1024};
+        grid.bin_counts = {64};
+        grid.batch_sizes = {1, 8};
+        grid.thread_counts = {1, 2};
+        return grid;
+    }
+
+    grid.windows = {128, 256, 512, 1024, 2048, 4096, 8192};
+    grid.bin_counts = {32, 64, 128};
+    grid.batch_sizes = {1, 8, 64};
+
+    unsigned hw = host::resolve_thread_count(0);
+    for (unsigned t = 1; t < hw; t *= 2) {
+        grid.thread_counts.push_back(t);
+    }
+    grid.thread_counts.push_back(hw);
+    return grid;
+}
+
+bool run_sweep(const BenchOptions& options, const SweepGrid& grid, const std::string& path) {
+    BenchSuite suite(options);
+    std::vector<SweepRow> rows;
+
+    for (size_t window : grid.windows) {
+        size_t max_batch = *std::max_element(grid.batch_sizes.begin(), grid.batch_sizes.end());
+        std::vector<int16_t> samples = make_batch(window, max_batch);
+
+        for (size_t bins : grid.bin_counts) {
+            std::vector<hal::fixed_t> magnitudes(bins * max_batch);
+
+            for (size_t batch : grid.batch_sizes) {
+                for (unsigned threads : grid.thread_counts) {
+                    std::cerr << "sweep spectral window=" << window << " bins=" << bins
+                              << " batch=" << batch << " threads=" << threads << "\n";
+
+                    suite.run("sweep/spectral", {}, [&] {
+                        host::parallel_for(batch, threads, 1,
+                            [&](size_t begin, size_t end, unsigned /*worker*/) {
+                                core::SpectralProcessor proc(bins, 1000);
+                                for (size_t b = begin; b < end; ++b) {
+                                    proc.compute_magnitude_spectrum(
+                                        &samples[b * window], window, &magnitudes[b * bins]);
+                                }
+                            });
+                        do_not_optimize(magnitudes[0]);
+                    });
+                    rows.push_back({"spectral", window, bins, batch, threads,
+                                    suite.results().back()});
+                }
+            }
+        }
+    }
+
+    // Inference cost does not depend on the window; features come from
+    // the smallest one
+    core::InferenceEngine engine = core::create_default_engine();
+    size_t inputs = engine.get_input_size();
+    size_t max_batch = *std::max_element(grid.batch_sizes.begin(), grid.batch_sizes.end());
+    size_t feature_window = grid.windows.empty() ? 256 : grid.windows.front();
+    std::vector<int16_t> samples = make_batch(feature_window, max_batch);
+    std::vector<hal::fixed_t> features(inputs * max_batch);
+    std::vector<core::InferenceResult> results(max_batch);
+    core::SpectralProcessor proc(inputs, 1000);
+    for (size_t b = 0; b < max_batch; ++b) {
+        proc.extract_features(&samples[b * feature_window], feature_window,
+                              &features[b * inputs], inputs);
+    }
+
+    for (size_t batch : grid.batch_sizes) {
+        for (unsigned threads : grid.thread_counts) {
+            std::cerr << "sweep inference batch=" << batch << " threads=" << threads << "\n";
+
+            suite.run("sweep/inference", {}, [&] {
+                host::parallel_for(batch, threads, core::InferenceEngine::BATCH_TILE,
+                    [&](size_t begin, size_t end, unsigned /*worker*/) {
+                        engine.run_batch(&features[begin * inputs], inputs,
+                                         end - begin, &results[begin]);
+                    });
+                do_not_optimize(results[0]);
+            });
+            rows.push_back({"inference", 0, inputs, batch, threads, suite.results().back()});
+        }
+    }
+
+    return write_rows(path, rows);
+}
+
+} // namespace bench
+} // namespace spectral_gate
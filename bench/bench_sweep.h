@@ -0,0 +1,46 @@
+#ifndef BENCH_SWEEP_H
+#define BENCH_SWEEP_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "bench_harness.h"
+
+namespace spectral_gate {
+namespace bench {
+
+/**
+ * @brief Parameter grid for the scaling sweep
+ */
+struct SweepGrid {
+    std::vector<size_t> windows;        // Samples per window
+    std::vector<size_t> bin_counts;     // Spectral bins
+    std::vector<size_t> batch_sizes;    // Windows handed over per call
+    std::vector<unsigned> thread_counts;
+};
+
+/**
+ * @brief Full grid: windows 128-8192, bins 32-128, batches 1-64, threads 1..hw
+ * @param quick Reduced grid for smoke runs
+ */
+SweepGrid get_default_sweep_grid(bool quick);
+
+/**
+ * @brief Time the spectral and inference paths over the grid
+ *
+ * Each point processes one batch per call, split across workers with
+ * host::parallel_for (threads are spawned per call, as in the STFT tool).
+ * Results are written as one tidy CSV row per (path, window, bins, batch,
+ * threads) point with per-window cost and throughput.
+ *
+ * @param options Timing policy
+ * @param grid Parameter grid
+ * @param path Output CSV path
+ * @return false if the CSV could not be written
+ */
+bool run_sweep(const BenchOptions& options, const SweepGrid& grid, const std::string& path);
+
+} // namespace bench
+} // namespace spectral_gate
+
+#endif // BENCH_SWEEP_H
@@ -0,0 +1,136 @@
+#include "perf_counters.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+namespace spectral_gate {
+namespace bench {
+
+const char* perf_event_name(PerfEvent event) {
+    switch (event) {
+        case PerfEvent::CYCLES:        return "cycles";
+        case PerfEvent::INSTRUCTIONS:  return "instructions";
+        case PerfEvent::L1D_MISSES:    return "l1d_misses";
+        case PerfEvent::LLC_MISSES:    return "llc_misses";
+        case PerfEvent::BRANCH_MISSES: return "branch_misses";
+        default:                       return "unknown";
+    }
+}
+
+#if defined(__linux__)
+
+namespace {
+    struct EventSpec {
+        uint32_t type;
+        uint64_t config;
+    };
+
+    const EventSpec EVENT_SPECS[NUM_PERF_EVENTS] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                             (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    };
+
+    int open_event(const EventSpec& spec) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = spec.type;
+        attr.config = spec.config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;    // Allowed at perf_event_paranoid <= 2
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        long fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        return static_cast<int>(fd);
+    }
+}
+
+PerfCounters::PerfCounters() {
+    for (size_t i = 0; i < NUM_PERF_EVENTS; ++i) {
+        fds_[i] = open_event(EVENT_SPECS[i]);
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (size_t i = 0; i < NUM_PERF_EVENTS; ++i) {
+        if (fds_[i] >= 0) close(fds_[i]);
+    }
+}
+
+bool PerfCounters::available() const {
+    for (size_t i = 0; i < NUM_PERF_EVENTS; ++i) {
+        if (fds_[i] >= 0) return true;
+    }
+    return false;
+}
+
+void PerfCounters::start() {
+    for (size_t i = 0; i < NUM_PERF_EVENTS; ++i) {
+        if (fds_[i] < 0) continue;
+        ioctl(fds_[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(fds_[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+PerfReading PerfCounters::stop() {
+    PerfReading reading;
+    for (size_t i = 0; i < NUM_PERF_EVENTS; ++i) {
+        reading.valid[i] = false;
+        reading.values[i] = 0.0;
+        if (fds_[i] < 0) continue;
+
+        ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, 0);
+
+        // value, time_enabled, time_running
+        uint64_t data[3] = {0, 0, 0};
+        if (read(fds_[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) {
+            continue;
+        }
+        if (data[2] == 0) {
+            continue;  // Never scheduled on the PMU
+        }
+
+        // Scale up if the kernel multiplexed this event
+        reading.values[i] = static_cast<double>(data[0]) *
+                            static_cast<double>(data[1]) / static_cast<double>(data[2]);
+        reading.valid[i] = true;
+    }
+    return reading;
+}
+
+#else
+
+PerfCounters::PerfCounters() {
+    for (size_t i = 0; i < NUM_PERF_EVENTS; ++i) fds_[i] = -1;
+}
+
+PerfCounters::~PerfCounters() = default;
+
+bool PerfCounters::available() const { return false; }
+
+void PerfCounters::start() {}
+
+PerfReading PerfCounters::stop() {
+    PerfReading reading;
+    for (size_t i = 0; i < NUM_PERF_EVENTS; ++i) {
+        reading.valid[i] = false;
+        reading.values[i] = 0.0;
+    }
+    return reading;
+}
+
+#endif
+
+} // namespace bench
+} // namespace spectral_gate
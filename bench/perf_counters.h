@@ -0,0 +1,74 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace spectral_gate {
+namespace bench {
+
+/**
+ * @brief Hardware events collected per benchmark
+ */
+enum class PerfEvent : uint8_t {
+    CYCLES = 0,
+    INSTRUCTIONS = 1,
+    L1D_MISSES = 2,
+    LLC_MISSES = 3,
+    BRANCH_MISSES = 4
+};
+
+constexpr size_t NUM_PERF_EVENTS = 5;
+
+/**
+ * @brief Get short event name for reports (e.g. "cycles")
+ */
+const char* perf_event_name(PerfEvent event);
+
+/**
+ * @brief Counter values over one measured interval
+ */
+struct PerfReading {
+    bool valid[NUM_PERF_EVENTS];        // Event could be opened and was scheduled
+    double values[NUM_PERF_EVENTS];     // Multiplexing-scaled counts
+};
+
+/**
+ * @brief Linux perf_event_open wrapper (user-space events only)
+ *
+ * Each event is opened independently so a container that exposes only
+ * some PMU events still reports those. On non-Linux hosts, or when
+ * perf_event_paranoid / seccomp deny access, every event reports
+ * invalid and benchmarks fall back to wall-clock only.
+ */
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /**
+     * @brief True if at least one event is usable
+     */
+    bool available() const;
+
+    /**
+     * @brief Reset and enable all usable events
+     */
+    void start();
+
+    /**
+     * @brief Disable events and return counts since start()
+     */
+    PerfReading stop();
+
+private:
+    int fds_[NUM_PERF_EVENTS];
+};
+
+} // namespace bench
+} // namespace spectral_gate
+
+#endif // PERF_COUNTERS_H
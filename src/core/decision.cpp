@@ -1,4 +1,5 @@
 #include "decision.h"
+#include "op_counter.h"
 
 namespace spectral_gate {
 namespace core {
@@ -11,32 +12,40 @@ ThresholdConfig get_default_config() {
     config.low_battery_multiplier = float_to_fixed(1.2f);           // 20% higher when low
     config.critical_battery_multiplier = float_to_fixed(1.5f);      // 50% higher when critical
     config.min_peaks_for_detection = 2;
+    config.min_peak_magnitude = float_to_fixed(0.1f);
     return config;
 }
 
+fixed_t get_effective_threshold(uint16_t battery_mv, const ThresholdConfig& config) {
+    if (battery_mv < BATTERY_CRITICAL_MV) {
+        // Critical battery: significantly raise threshold
+        return fixed_mul(config.base_confidence_threshold, config.critical_battery_multiplier);
+    } else if (battery_mv < BATTERY_LOW_MV) {
+        // Low battery: moderately raise threshold
+        return fixed_mul(config.base_confidence_threshold, config.low_battery_multiplier);
+    }
+    return config.base_confidence_threshold;
+}
+
 Decision evaluate_structure(
     const SpectralResult& spectral,
     const InferenceResult& inference,
     uint16_t battery_mv,
     const ThresholdConfig& config
 ) {
-    // Step 1: Determine effective threshold based on battery level
-    fixed_t effective_threshold = config.base_confidence_threshold;
+    // A handful of field loads, compares and at most two fixed_mul()
+    SG_OP_STAGE(DECISION);
+    SG_COUNT_OPS(LOAD, 6);
+    SG_COUNT_OPS(BRANCH, 6);
+    SG_COUNT_OPS(MAC, 2);
     
-    if (battery_mv < BATTERY_CRITICAL_MV) {
-        // Critical battery: significantly raise threshold
-        effective_threshold = fixed_mul(config.base_confidence_threshold, 
-                                        config.critical_battery_multiplier);
-    } else if (battery_mv < BATTERY_LOW_MV) {
-        // Low battery: moderately raise threshold
-        effective_threshold = fixed_mul(config.base_confidence_threshold,
-                                        config.low_battery_multiplier);
-    }
+    // Step 1: Determine effective threshold based on battery level
+    fixed_t effective_threshold = get_effective_threshold(battery_mv, config);
     
     // Step 2: Check if spectral analysis shows sufficient activity
     bool sufficient_spectral_activity = 
         (spectral.num_peaks >= config.min_peaks_for_detection) &&
-        (spectral.peak_magnitude > float_to_fixed(0.1f));
+        (spectral.peak_magnitude > config.min_peak_magnitude);
     
     // Step 3: Early exit if no significant spectral activity
     if (!sufficient_spectral_activity) {
@@ -78,6 +87,79 @@ Decision evaluate_structure(
     return Decision::SLEEP;
 }
 
+void evaluate_structure_batch(
+    const SpectralResult* spectral,
+    const InferenceResult* inference,
+    const uint16_t* battery_mv,
+    size_t count,
+    const ThresholdConfig& config,
+    Decision* decisions
+) {
+    SG_OP_STAGE(DECISION);
+    SG_COUNT_OPS(MAC, 6);
+    SG_COUNT_OPS(LOAD, 6 * count);
+    SG_COUNT_OPS(BRANCH, 6 * count);
+    
+    // Effective and uncertain thresholds per battery regime:
+    // [0] nominal, [1] low, [2] critical
+    fixed_t alert_threshold[3];
+    alert_threshold[0] = config.base_confidence_threshold;
+    alert_threshold[1] = fixed_mul(config.base_confidence_threshold, config.low_battery_multiplier);
+    alert_threshold[2] = fixed_mul(config.base_confidence_threshold, config.critical_battery_multiplier);
+    fixed_t uncertain_threshold[3];
+    for (size_t r = 0; r < 3; ++r) {
+        uncertain_threshold[r] = fixed_mul(alert_threshold[r], float_to_fixed(0.7f));
+    }
+    
+    for (size_t i = 0; i < count; ++i) {
+        const SpectralResult& s = spectral[i];
+        const InferenceResult& inf = inference[i];
+        uint16_t mv = battery_mv[i];
+        size_t regime = (mv < BATTERY_CRITICAL_MV) ? 2 : (mv < BATTERY_LOW_MV) ? 1 : 0;
+        
+        Decision d = Decision::SLEEP;
+        if (s.num_peaks >= config.min_peaks_for_detection &&
+            s.peak_magnitude > config.min_peak_magnitude) {
+            if (inf.predicted_class == 1) {
+                if (inf.confidence >= alert_threshold[regime]) {
+                    d = Decision::TX_ALERT;
+                } else if (inf.confidence >= uncertain_threshold[regime]) {
+                    d = Decision::TX_UNCERTAIN;
+                }
+            } else if (inf.predicted_class == 2) {
+                if (regime == 0 && s.num_peaks >= (config.min_peaks_for_detection + 1)) {
+                    d = Decision::TX_UNCERTAIN;
+                }
+            }
+        }
+        decisions[i] = d;
+    }
+}
+
+DecisionReason get_decision_reason(
+    Decision decision,
+    const InferenceResult& inference,
+    uint16_t battery_mv,
+    fixed_t threshold
+) {
+    switch (decision) {
+        case Decision::TX_UNCERTAIN:
+            return DecisionReason::ACTIVE_LEARNING;
+        case Decision::TX_ALERT:
+            return DecisionReason::SAFETY_CRITICAL;
+        case Decision::SLEEP:
+        default:
+            if (inference.predicted_class == 2 && battery_mv < BATTERY_LOW_MV) {
+                return DecisionReason::ENERGY_VETO;
+            } else if (inference.predicted_class == 1 && inference.confidence < threshold) {
+                return DecisionReason::LOW_CONFIDENCE;
+            } else if (inference.predicted_class == 0) {
+                return DecisionReason::NORMAL_OPERATION;
+            }
+            return DecisionReason::CONSERVE;
+    }
+}
+
 const char* decision_to_string(Decision d) {
     switch (d) {
         case Decision::SLEEP:        return "SLEEP";
@@ -87,5 +169,17 @@ const char* decision_to_string(Decision d) {
     }
 }
 
+const char* decision_reason_to_string(DecisionReason r) {
+    switch (r) {
+        case DecisionReason::NORMAL_OPERATION: return "Normal Op";
+        case DecisionReason::LOW_CONFIDENCE:   return "Low Conf";
+        case DecisionReason::ENERGY_VETO:      return "Energy Veto";
+        case DecisionReason::CONSERVE:         return "Conserve";
+        case DecisionReason::ACTIVE_LEARNING:  return "Active Learn";
+        case DecisionReason::SAFETY_CRITICAL:  return "Safety Crit";
+        default:                               return "Unknown";
+    }
+}
+
 } // namespace core
 } // namespace spectral_gate
@@ -2,6 +2,7 @@
 #define DECISION_H
 
 #include <cstdint>
+#include <cstddef>
 #include "hal/hal_interface.h"
 
 namespace spectral_gate {
@@ -16,6 +17,18 @@ enum class Decision : uint8_t {
     TX_UNCERTAIN = 2    // Uncertain detection, transmit for cloud analysis
 };
 
+/**
+ * @brief Why evaluate_structure() reached its decision (for logs and display)
+ */
+enum class DecisionReason : uint8_t {
+    NORMAL_OPERATION = 0,   // SLEEP: model reports normal operation
+    LOW_CONFIDENCE = 1,     // SLEEP: anomaly below the effective threshold
+    ENERGY_VETO = 2,        // SLEEP: uncertain window vetoed on low battery
+    CONSERVE = 3,           // SLEEP: anything else (e.g. no spectral activity)
+    ACTIVE_LEARNING = 4,    // TX_UNCERTAIN
+    SAFETY_CRITICAL = 5     // TX_ALERT
+};
+
 /**
  * @brief Spectral analysis result structure
  */
@@ -42,6 +55,7 @@ struct ThresholdConfig {
     hal::fixed_t low_battery_multiplier;        // Multiplier when battery is low
     hal::fixed_t critical_battery_multiplier;   // Multiplier when battery is critical
     uint8_t min_peaks_for_detection;            // Minimum spectral peaks required
+    hal::fixed_t min_peak_magnitude;            // Spectral activity gate on the peak magnitude
 };
 
 /**
@@ -65,6 +79,41 @@ Decision evaluate_structure(
     const ThresholdConfig& config
 );
 
+/**
+ * @brief Evaluate many windows against one configuration
+ * 
+ * Same result as evaluate_structure() per window; the battery-scaled
+ * thresholds are computed once per call instead of once per window.
+ * Used for offline threshold sweeps over cached stage outputs.
+ * 
+ * @param decisions Output array of count entries
+ */
+void evaluate_structure_batch(
+    const SpectralResult* spectral,
+    const InferenceResult* inference,
+    const uint16_t* battery_mv,
+    size_t count,
+    const ThresholdConfig& config,
+    Decision* decisions
+);
+
+/**
+ * @brief Confidence threshold evaluate_structure() applies at a battery level
+ * @return Base threshold scaled by the low/critical multiplier
+ */
+hal::fixed_t get_effective_threshold(uint16_t battery_mv, const ThresholdConfig& config);
+
+/**
+ * @brief Classify a decision for display
+ * @param threshold Effective threshold the decision was made against
+ */
+DecisionReason get_decision_reason(
+    Decision decision,
+    const InferenceResult& inference,
+    uint16_t battery_mv,
+    hal::fixed_t threshold
+);
+
 /**
  * @brief Get default threshold configuration
  * @return Default ThresholdConfig values
@@ -78,6 +127,11 @@ ThresholdConfig get_default_config();
  */
 const char* decision_to_string(Decision d);
 
+/**
+ * @brief Short label for a DecisionReason (at most 13 characters)
+ */
+const char* decision_reason_to_string(DecisionReason r);
+
 } // namespace core
 } // namespace spectral_gate
 
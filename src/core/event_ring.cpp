@@ -0,0 +1,230 @@
+#include "event_ring.h"
+
+namespace spectral_gate {
+namespace core {
+
+using namespace hal;
+
+namespace {
+    constexpr uint32_t RING_MAGIC = 0x53474552;     // "SGER"
+
+    // Largest batch spill_events() builds on the stack
+    constexpr size_t SPILL_BATCH_BYTES = 256;
+
+    // Delta value announcing a u32 absolute time
+    constexpr uint16_t TIME_ESCAPE = 0xFFFF;
+
+    void put_u16(uint8_t* p, uint16_t v) {
+        p[0] = static_cast<uint8_t>(v & 0xFF);
+        p[1] = static_cast<uint8_t>(v >> 8);
+    }
+
+    void put_u32(uint8_t* p, uint32_t v) {
+        for (int i = 0; i < 4; ++i) p[i] = static_cast<uint8_t>((v >> (8 * i)) & 0xFF);
+    }
+
+    uint32_t mix(uint32_t hash, uint32_t value) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            hash ^= (value >> shift) & 0xFF;
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+}
+
+EventRecord make_event_record(
+    uint32_t time_s,
+    uint16_t battery_mv,
+    const InferenceResult& inference,
+    Decision decision,
+    DecisionReason reason
+) {
+    int64_t pct = (static_cast<int64_t>(inference.confidence) * 100 + FIXED_ONE / 2) >> FIXED_SHIFT;
+    pct = (pct < 0) ? 0 : (pct > 100) ? 100 : pct;
+
+    EventRecord e;
+    e.time_s = time_s;
+    e.battery_mv = battery_mv;
+    e.confidence_pct = static_cast<uint8_t>(pct);
+    e.flags = static_cast<uint8_t>((static_cast<uint8_t>(decision) & 0x03) |
+                                   ((static_cast<uint8_t>(reason) & 0x07) << 2) |
+                                   ((inference.predicted_class & 0x03) << 5));
+    return e;
+}
+
+EventRing::EventRing(uint8_t* area, size_t size)
+    : header_(reinterpret_cast<Header*>(area)),
+      records_(reinterpret_cast<EventRecord*>(area + sizeof(Header))),
+      capacity_((size > sizeof(Header)) ? (size - sizeof(Header)) / sizeof(EventRecord) : 0)
+{
+    // head/count are 16-bit
+    if (capacity_ > 0xFFFF) {
+        capacity_ = 0xFFFF;
+    }
+}
+
+uint32_t EventRing::compute_check() const {
+    uint32_t hash = 2166136261u;
+    hash = mix(hash, header_->magic);
+    hash = mix(hash, header_->next_sequence);
+    hash = mix(hash, header_->dropped);
+    hash = mix(hash, header_->head);
+    hash = mix(hash, header_->count);
+    hash = mix(hash, header_->capacity);
+    return hash;
+}
+
+void EventRing::seal() {
+    header_->check = compute_check();
+}
+
+bool EventRing::restore() {
+    if (capacity_ > 0 &&
+        header_->magic == RING_MAGIC &&
+        header_->capacity == capacity_ &&
+        header_->head < capacity_ &&
+        header_->count <= capacity_ &&
+        header_->check == compute_check()) {
+        return true;
+    }
+    reset();
+    return false;
+}
+
+void EventRing::reset() {
+    header_->magic = RING_MAGIC;
+    header_->next_sequence = 0;
+    header_->dropped = 0;
+    header_->head = 0;
+    header_->count = 0;
+    header_->capacity = static_cast<uint32_t>(capacity_);
+    seal();
+}
+
+void EventRing::push(const EventRecord& record) {
+    if (capacity_ == 0) {
+        return;
+    }
+    if (header_->count == capacity_) {
+        header_->head = static_cast<uint16_t>((header_->head + 1) % capacity_);
+        --header_->count;
+        ++header_->dropped;
+    }
+    records_[(header_->head + header_->count) % capacity_] = record;
+    ++header_->count;
+    ++header_->next_sequence;
+    seal();
+}
+
+size_t EventRing::pending() const {
+    return header_->count;
+}
+
+uint32_t EventRing::get_dropped() const {
+    return header_->dropped;
+}
+
+bool EventRing::needs_spill() const {
+    return header_->count * 4 >= capacity_ * 3;
+}
+
+size_t EventRing::encode_batch(uint8_t* out, size_t max_bytes, size_t* num_records) const {
+    *num_records = 0;
+    const size_t count = header_->count;
+    if (count == 0 || max_bytes < EVENT_BATCH_HEADER_BYTES + EVENT_BATCH_RECORD_BYTES) {
+        return 0;
+    }
+
+    const EventRecord& first = records_[header_->head];
+    size_t length = EVENT_BATCH_HEADER_BYTES;
+    uint32_t previous = first.time_s;
+    size_t n = 0;
+    while (n < count && n < 255) {
+        const EventRecord& e = records_[(header_->head + n) % capacity_];
+        uint32_t delta = e.time_s - previous;
+        bool escape = (e.time_s < previous) || (delta >= TIME_ESCAPE);
+        size_t needed = EVENT_BATCH_RECORD_BYTES + (escape ? 4 : 0);
+        if (length + needed > max_bytes) {
+            break;
+        }
+        uint8_t* p = out + length;
+        put_u16(p, escape ? TIME_ESCAPE : static_cast<uint16_t>(delta));
+        p += 2;
+        if (escape) {
+            put_u32(p, e.time_s);
+            p += 4;
+        }
+        put_u16(p, e.battery_mv);
+        p[2] = e.confidence_pct;
+        p[3] = e.flags;
+        length += needed;
+        previous = e.time_s;
+        ++n;
+    }
+
+    out[0] = EVENT_BATCH_TAG;
+    out[1] = static_cast<uint8_t>(n);
+    put_u32(out + 2, header_->next_sequence - static_cast<uint32_t>(count));
+    put_u32(out + 6, first.time_s);
+    *num_records = n;
+    return length;
+}
+
+void EventRing::commit(size_t num_records) {
+    if (num_records > header_->count) {
+        num_records = header_->count;
+    }
+    if (num_records == 0) {
+        return;
+    }
+    header_->head = static_cast<uint16_t>((header_->head + num_records) % capacity_);
+    header_->count = static_cast<uint16_t>(header_->count - num_records);
+    seal();
+}
+
+bool transmit_alert_with_events(
+    IHardwareAbstraction& hw,
+    EventRing& ring,
+    uint8_t alert_type,
+    uint8_t confidence,
+    uint32_t time_s
+) {
+    uint8_t frame[MAX_FRAME_BYTES];
+    frame[0] = ALERT_FRAME_SYNC;
+    frame[1] = alert_type;
+    frame[2] = confidence;
+    put_u32(&frame[3], time_s);
+    frame[7] = 0x00;                // CRC placeholder (as in the plain alert packet)
+
+    size_t num_records = 0;
+    size_t length = ALERT_HEADER_BYTES +
+                    ring.encode_batch(&frame[ALERT_HEADER_BYTES], sizeof(frame) - ALERT_HEADER_BYTES,
+                                      &num_records);
+    if (!hw.transmit_frame(frame, length)) {
+        return false;
+    }
+    ring.commit(num_records);
+    return true;
+}
+
+size_t spill_events(IHardwareAbstraction& hw, EventRing& ring, bool force) {
+    if (!force && !ring.needs_spill()) {
+        return 0;
+    }
+
+    size_t written = 0;
+    uint8_t batch[SPILL_BATCH_BYTES];
+    while (ring.pending() > 0) {
+        size_t num_records = 0;
+        size_t length = ring.encode_batch(batch, sizeof(batch), &num_records);
+        if (length == 0 || !hw.store_event_batch(batch, length)) {
+            break;
+        }
+        ring.commit(num_records);
+        written += num_records;
+    }
+    return written;
+}
+
+} // namespace core
+} // namespace spectral_gate
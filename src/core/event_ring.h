@@ -0,0 +1,172 @@
+#ifndef EVENT_RING_H
+#define EVENT_RING_H
+
+#include <cstdint>
+#include <cstddef>
+#include "hal/hal_interface.h"
+#include "decision.h"
+
+namespace spectral_gate {
+namespace core {
+
+/**
+ * @brief Compact per-window decision record (8 bytes in the ring)
+ */
+struct EventRecord {
+    uint32_t time_s;            // Node time in seconds
+    uint16_t battery_mv;
+    uint8_t confidence_pct;     // Model confidence, 0-100
+    uint8_t flags;              // decision | reason << 2 | predicted_class << 5
+};
+
+/**
+ * @brief Pack one window's outcome into an EventRecord
+ */
+EventRecord make_event_record(
+    uint32_t time_s,
+    uint16_t battery_mv,
+    const InferenceResult& inference,
+    Decision decision,
+    DecisionReason reason
+);
+
+inline Decision event_decision(const EventRecord& e) {
+    return static_cast<Decision>(e.flags & 0x03);
+}
+
+inline DecisionReason event_reason(const EventRecord& e) {
+    return static_cast<DecisionReason>((e.flags >> 2) & 0x07);
+}
+
+inline uint8_t event_predicted_class(const EventRecord& e) {
+    return static_cast<uint8_t>((e.flags >> 5) & 0x03);
+}
+
+// Event batch wire format (radio piggyback and flash log):
+//   u8 tag (EVENT_BATCH_TAG), u8 count, u32 sequence of the first record,
+//   u32 time of the first record, then per record:
+//   u16 seconds since the previous record (0xFFFF: u32 absolute time
+//   follows), u16 battery_mv, u8 confidence_pct, u8 flags.
+// All fields little-endian. Erased flash (0xFF) between batches is padding.
+constexpr uint8_t EVENT_BATCH_TAG = 0xE1;
+constexpr size_t EVENT_BATCH_HEADER_BYTES = 10;
+constexpr size_t EVENT_BATCH_RECORD_BYTES = 6;
+
+// Alert frame: the 8-byte alert packet (sync ALERT_FRAME_SYNC) followed
+// by an optional event batch
+constexpr uint8_t ALERT_FRAME_SYNC = 0xAB;
+constexpr size_t ALERT_HEADER_BYTES = 8;
+
+/**
+ * @brief Fixed-size ring of EventRecords in retained RAM
+ *
+ * The ring lives entirely inside a caller-provided area (the HAL's
+ * SRAM2 block on target): a small header followed by the records. The
+ * header carries a magic and a check word, so after a warm reset
+ * restore() keeps every record that was not yet flushed. When the ring
+ * is full the oldest record is overwritten and counted as dropped;
+ * sequence numbers in each batch let the decoder see the gap.
+ *
+ * Records leave the ring in two steps: encode_batch() copies the oldest
+ * ones into a buffer, and commit() removes them once the radio or flash
+ * write succeeded, so a failed transmission loses nothing.
+ */
+class EventRing {
+public:
+    /**
+     * @brief Bind to a retained area without touching its contents
+     * @param area 4-byte aligned storage
+     * @param size Size of the area in bytes
+     */
+    EventRing(uint8_t* area, size_t size);
+
+    /**
+     * @brief Keep the retained contents if their header is intact,
+     *        otherwise start empty
+     * @return true if retained records were kept
+     */
+    bool restore();
+
+    /**
+     * @brief Discard all records and counters
+     */
+    void reset();
+
+    /**
+     * @brief Append a record, overwriting the oldest when full
+     */
+    void push(const EventRecord& record);
+
+    size_t capacity() const { return capacity_; }
+    size_t pending() const;
+    uint32_t get_dropped() const;
+
+    /**
+     * @brief True once pending() reaches three quarters of capacity
+     */
+    bool needs_spill() const;
+
+    /**
+     * @brief Encode the oldest pending records as one batch
+     * @param out Output buffer
+     * @param max_bytes Space available in out
+     * @param num_records Receives how many records were encoded
+     * @return Batch length in bytes (0 if nothing fits or nothing is pending)
+     */
+    size_t encode_batch(uint8_t* out, size_t max_bytes, size_t* num_records) const;
+
+    /**
+     * @brief Remove the oldest num_records after they were delivered
+     */
+    void commit(size_t num_records);
+
+private:
+    struct Header {
+        uint32_t magic;
+        uint32_t next_sequence;     // Sequence number of the next pushed record
+        uint32_t dropped;           // Records overwritten before delivery
+        uint16_t head;              // Slot of the oldest pending record
+        uint16_t count;             // Pending records
+        uint32_t capacity;
+        uint32_t check;
+    };
+
+    uint32_t compute_check() const;
+    void seal();
+
+    Header* header_;
+    EventRecord* records_;
+    size_t capacity_;
+};
+
+/**
+ * @brief Transmit an alert with pending events piggybacked on the frame
+ *
+ * Fills the rest of the frame (up to MAX_FRAME_BYTES) with the oldest
+ * pending events and commits them once transmit_frame() succeeds, so
+ * the node's history rides along on transmissions it makes anyway.
+ *
+ * @return true if the frame was transmitted
+ */
+bool transmit_alert_with_events(
+    hal::IHardwareAbstraction& hw,
+    EventRing& ring,
+    uint8_t alert_type,
+    uint8_t confidence,
+    uint32_t time_s
+);
+
+/**
+ * @brief Move pending events to the flash log in batches
+ *
+ * Does nothing below the high-water mark unless force is set; flash
+ * writes cost far less than a dedicated transmission.
+ *
+ * @return Number of records written to flash
+ */
+size_t spill_events(hal::IHardwareAbstraction& hw, EventRing& ring, bool force);
+
+} // namespace core
+} // namespace spectral_gate
+
+#endif // EVENT_RING_H
@@ -1,5 +1,6 @@
 #include "inference.h"
 #include "model_weights.h"
+#include "op_counter.h"
 #include <algorithm>
 
 namespace spectral_gate {
@@ -24,6 +25,12 @@ InferenceEngine::InferenceEngine(
 fixed_t InferenceEngine::dot_product(const fixed_t* input, size_t output_idx) {
     int64_t accumulator = 0;
     
+    // Per input: feature and weight loads, one MAC; then scale and bias
+    SG_COUNT_OPS(LOAD, 2 * input_size_ + 1);
+    SG_COUNT_OPS(MAC, input_size_ + 1);
+    SG_COUNT_OPS(BRANCH, input_size_);
+    SG_COUNT_OPS(ALU, 4);
+    
     // Compute weighted sum for this output neuron
     for (size_t i = 0; i < input_size_; ++i) {
         // Weight index: output_idx * input_size + i (row-major)
@@ -41,7 +48,7 @@ fixed_t InferenceEngine::dot_product(const fixed_t* input, size_t output_idx) {
     
     // Add bias (scaled from int8)
     int8_t bias = biases_[output_idx];
-    result += static_cast<fixed_t>(bias) << (FIXED_SHIFT - 7);
+    result += static_cast<fixed_t>(bias) * (fixed_t(1) << (FIXED_SHIFT - 7));
     
     return result;
 }
@@ -50,6 +57,14 @@ void InferenceEngine::normalize_outputs(fixed_t* outputs, size_t count) {
     // Simple normalization: find max and scale to [0, 1]
     // This is a simplified softmax approximation for embedded use
     
+    // Range scan, scale (one divide), per-output MAC and 64-bit divide
+    SG_COUNT_OPS(LOAD, 3 * count);
+    SG_COUNT_OPS(ALU, 4 * count);
+    SG_COUNT_OPS(BRANCH, 3 * count);
+    SG_COUNT_OPS(MAC, count);
+    SG_COUNT_OPS(DIVIDE, count + 1);
+    SG_COUNT_OPS(STORE, 2 * count);
+    
     fixed_t max_val = outputs[0];
     fixed_t min_val = outputs[0];
     
@@ -59,8 +74,9 @@ void InferenceEngine::normalize_outputs(fixed_t* outputs, size_t count) {
     }
     
     fixed_t range = max_val - min_val;
-    if (range < float_to_fixed(0.001f)) {
-        // Uniform distribution if outputs are nearly equal
+    if (range < float_to_fixed(0.001f) || (range >> 8) == 0) {
+        // Uniform distribution if outputs are nearly equal (the scale
+        // below divides by range >> 8, which is zero under ~0.004)
         fixed_t uniform = FIXED_ONE / static_cast<fixed_t>(count);
         for (size_t i = 0; i < count; ++i) {
             outputs[i] = uniform;
@@ -89,6 +105,9 @@ uint8_t InferenceEngine::argmax(const fixed_t* outputs, size_t count) {
     uint8_t max_idx = 0;
     fixed_t max_val = outputs[0];
     
+    SG_COUNT_OPS(LOAD, count);
+    SG_COUNT_OPS(BRANCH, count);
+    
     for (size_t i = 1; i < count; ++i) {
         if (outputs[i] > max_val) {
             max_val = outputs[i];
@@ -99,7 +118,30 @@ uint8_t InferenceEngine::argmax(const fixed_t* outputs, size_t count) {
     return max_idx;
 }
 
+InferenceResult InferenceEngine::finish(fixed_t* outputs, size_t count) {
+    InferenceResult result;
+    
+    // Apply activation approximation (ReLU-like, then normalize)
+    for (size_t i = 0; i < count; ++i) {
+        if (outputs[i] < 0) outputs[i] = 0;
+    }
+    
+    normalize_outputs(outputs, count);
+    
+    // Find predicted class and confidence
+    result.predicted_class = argmax(outputs, count);
+    result.confidence = outputs[result.predicted_class];
+    
+    // Clamp confidence to [0, 1]
+    if (result.confidence > FIXED_ONE) result.confidence = FIXED_ONE;
+    if (result.confidence < 0) result.confidence = 0;
+    
+    return result;
+}
+
 InferenceResult InferenceEngine::run(const fixed_t* features, size_t num_features) {
+    SG_OP_STAGE(INFERENCE);
+    
     InferenceResult result;
     result.confidence = 0;
     result.predicted_class = 0;
@@ -110,7 +152,6 @@ InferenceResult InferenceEngine::run(const fixed_t* features, size_t num_feature
     }
     
     // Compute output for each class
-    constexpr size_t MAX_OUTPUTS = 8;
     fixed_t outputs[MAX_OUTPUTS];
     size_t actual_outputs = (output_size_ < MAX_OUTPUTS) ? output_size_ : MAX_OUTPUTS;
     
@@ -118,22 +159,66 @@ InferenceResult InferenceEngine::run(const fixed_t* features, size_t num_feature
         outputs[i] = dot_product(features, i);
     }
     
-    // Apply activation approximation (ReLU-like, then normalize)
-    for (size_t i = 0; i < actual_outputs; ++i) {
-        if (outputs[i] < 0) outputs[i] = 0;
-    }
+    return finish(outputs, actual_outputs);
+}
+
+void InferenceEngine::run_batch(
+    const fixed_t* features,
+    size_t num_features,
+    size_t batch_size,
+    InferenceResult* results
+) {
+    SG_OP_STAGE(INFERENCE);
     
-    normalize_outputs(outputs, actual_outputs);
+    if (num_features != input_size_) {
+        for (size_t b = 0; b < batch_size; ++b) {
+            results[b].confidence = 0;
+            results[b].predicted_class = 0;
+        }
+        return;
+    }
     
-    // Find predicted class and confidence
-    result.predicted_class = argmax(outputs, actual_outputs);
-    result.confidence = outputs[result.predicted_class];
+    size_t actual_outputs = (output_size_ < MAX_OUTPUTS) ? output_size_ : MAX_OUTPUTS;
+    fixed_t outputs[BATCH_TILE][MAX_OUTPUTS];
     
-    // Clamp confidence to [0, 1]
-    if (result.confidence > FIXED_ONE) result.confidence = FIXED_ONE;
-    if (result.confidence < 0) result.confidence = 0;
+    for (size_t base = 0; base < batch_size; base += BATCH_TILE) {
+        size_t tile = (batch_size - base < BATCH_TILE) ? batch_size - base : BATCH_TILE;
+        
+        // Output-major: one weight row serves the whole tile
+        for (size_t o = 0; o < actual_outputs; ++o) {
+            for (size_t w = 0; w < tile; ++w) {
+                outputs[w][o] = dot_product(&features[(base + w) * num_features], o);
+            }
+        }
+        
+        for (size_t w = 0; w < tile; ++w) {
+            results[base + w] = finish(outputs[w], actual_outputs);
+        }
+    }
+}
+
+uint32_t InferenceEngine::get_model_checksum() const {
+    uint32_t hash = 2166136261u;
+    auto mix = [&hash](uint8_t byte) {
+        hash ^= byte;
+        hash *= 16777619u;
+    };
+    auto mix_word = [&mix](uint32_t word) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            mix(static_cast<uint8_t>(word >> shift));
+        }
+    };
     
-    return result;
+    mix_word(static_cast<uint32_t>(input_size_));
+    mix_word(static_cast<uint32_t>(output_size_));
+    mix_word(static_cast<uint32_t>(scale_factor_));
+    for (size_t i = 0; i < input_size_ * output_size_; ++i) {
+        mix(static_cast<uint8_t>(weights_[i]));
+    }
+    for (size_t i = 0; i < output_size_; ++i) {
+        mix(static_cast<uint8_t>(biases_[i]));
+    }
+    return hash;
 }
 
 InferenceEngine create_default_engine() {
@@ -17,6 +17,9 @@ namespace core {
  */
 class InferenceEngine {
 public:
+    static constexpr size_t MAX_OUTPUTS = 8;    // Output neurons evaluated per window
+    static constexpr size_t BATCH_TILE = 8;     // Windows sharing a weight-row pass
+
     /**
      * @brief Initialize the inference engine with model weights
      * @param weights Pointer to quantized weight array (int8)
@@ -41,6 +44,25 @@ public:
      */
     InferenceResult run(const hal::fixed_t* features, size_t num_features);
 
+    /**
+     * @brief Run inference on a batch of feature vectors
+     * 
+     * Windows are processed in small tiles so each weight row is reused
+     * across the tile while it is still in cache. Results match run()
+     * for every window.
+     * 
+     * @param features batch_size feature vectors, back to back
+     * @param num_features Features per window (must match input_size)
+     * @param batch_size Number of windows
+     * @param results Receives batch_size results
+     */
+    void run_batch(
+        const hal::fixed_t* features,
+        size_t num_features,
+        size_t batch_size,
+        InferenceResult* results
+    );
+
     /**
      * @brief Get input size expected by the model
      */
@@ -51,6 +73,13 @@ public:
      */
     size_t get_output_size() const { return output_size_; }
 
+    /**
+     * @brief FNV-1a hash of the weights, biases, dimensions and scale
+     * 
+     * Identifies the loaded model in logs, metrics and golden vectors.
+     */
+    uint32_t get_model_checksum() const;
+
 private:
     const int8_t* weights_;
     const int8_t* biases_;
@@ -72,6 +101,11 @@ private:
      * @brief Find argmax of output array
      */
     uint8_t argmax(const hal::fixed_t* outputs, size_t count);
+
+    /**
+     * @brief Activation, normalization and class selection on raw outputs
+     */
+    InferenceResult finish(hal::fixed_t* outputs, size_t count);
 };
 
 /**
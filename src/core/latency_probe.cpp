@@ -0,0 +1,274 @@
+#include "latency_probe.h"
+
+#if defined(SPECTRAL_GATE_LATENCY_PROBES)
+#include <atomic>
+#include <chrono>
+#if defined(__x86_64__) || defined(_M_X64)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define SG_LATENCY_USE_TSC 1
+#endif
+#endif
+
+namespace spectral_gate {
+namespace core {
+
+const char* latency_stage_name(LatencyStage stage) {
+    switch (stage) {
+        case LatencyStage::PREFILTER:  return "prefilter";
+        case LatencyStage::SPECTRAL:   return "spectral";
+        case LatencyStage::SIMILARITY: return "similarity";
+        case LatencyStage::INFERENCE:  return "inference";
+        case LatencyStage::DECISION:   return "decision";
+        case LatencyStage::WINDOW:     return "window";
+    }
+    return "?";
+}
+
+namespace latency_buckets {
+
+size_t index_of(uint64_t value) {
+    if (value < SUB_BUCKETS) {
+        return static_cast<size_t>(value);
+    }
+
+    uint32_t exponent = 0;
+#if defined(__GNUC__) || defined(__clang__)
+    exponent = 63u - static_cast<uint32_t>(__builtin_clzll(value));
+#else
+    for (uint64_t v = value; v > 1; v >>= 1) ++exponent;
+#endif
+    if (exponent >= MAX_EXPONENT) {
+        return NUM_BUCKETS - 1;
+    }
+
+    uint32_t shift = exponent - SUB_BUCKET_BITS;
+    size_t sub = static_cast<size_t>(value >> shift) - SUB_BUCKETS;
+    return SUB_BUCKETS + shift * SUB_BUCKETS + sub;
+}
+
+uint64_t lower_bound(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+    size_t shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+    size_t sub = (index - SUB_BUCKETS) % SUB_BUCKETS;
+    return static_cast<uint64_t>(SUB_BUCKETS + sub) << shift;
+}
+
+} // namespace latency_buckets
+
+namespace latency {
+
+#if defined(SPECTRAL_GATE_LATENCY_PROBES)
+
+namespace {
+    using latency_buckets::NUM_BUCKETS;
+
+    // Live threads past MAX_SHARDS share the overflow shard (atomic adds)
+    constexpr size_t MAX_SHARDS = 32;
+
+    struct Shard {
+        std::atomic<uint64_t> buckets[NUM_LATENCY_STAGES][NUM_BUCKETS];
+        std::atomic<uint64_t> sum_ticks[NUM_LATENCY_STAGES];
+        std::atomic<bool> in_use;
+    };
+
+    std::atomic<Shard*> g_shards[MAX_SHARDS];
+    std::atomic<size_t> g_next_shard{0};
+    Shard g_overflow_shard;
+
+    struct ShardHandle {
+        Shard* shard;
+        bool exclusive;
+    };
+
+    // Constant-initialized so the hot path needs no TLS init guard
+    thread_local ShardHandle t_handle = {nullptr, false};
+
+    // Hands the shard back when its thread exits, counts intact, so the
+    // next thread keeps adding to them. Only touched on the slow path.
+    struct ShardOwner {
+        Shard* shard = nullptr;
+        ~ShardOwner() {
+            if (shard != nullptr) {
+                shard->in_use.store(false, std::memory_order_release);
+            }
+        }
+    };
+    thread_local ShardOwner t_owner;
+
+    Shard* claim_shard() {
+        // A shard left by a finished thread first: short-lived workers
+        // (one set per parallel_for call) would use up the slots otherwise
+        size_t allocated = g_next_shard.load(std::memory_order_acquire);
+        for (size_t i = 0; i < allocated && i < MAX_SHARDS; ++i) {
+            Shard* shard = g_shards[i].load(std::memory_order_acquire);
+            bool expected = false;
+            if (shard != nullptr &&
+                shard->in_use.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                return shard;
+            }
+        }
+
+        size_t index = g_next_shard.fetch_add(1, std::memory_order_acq_rel);
+        if (index >= MAX_SHARDS) {
+            return nullptr;
+        }
+        // Shards are never freed: a finished thread's samples stay readable
+        Shard* shard = new Shard();
+        shard->in_use.store(true, std::memory_order_relaxed);
+        g_shards[index].store(shard, std::memory_order_release);
+        return shard;
+    }
+
+    void acquire_shard(ShardHandle* handle) {
+        Shard* shard = claim_shard();
+        if (shard == nullptr) {
+            *handle = ShardHandle{&g_overflow_shard, false};
+            return;
+        }
+        t_owner.shard = shard;
+        *handle = ShardHandle{shard, true};
+    }
+
+    inline void bump(std::atomic<uint64_t>& counter, uint64_t amount, bool exclusive) {
+        if (exclusive) {
+            // Single writer: plain load/store, no locked instruction
+            counter.store(counter.load(std::memory_order_relaxed) + amount,
+                          std::memory_order_relaxed);
+        } else {
+            counter.fetch_add(amount, std::memory_order_relaxed);
+        }
+    }
+
+    template <typename Fn>
+    void for_each_shard(Fn fn) {
+        for (size_t i = 0; i < MAX_SHARDS; ++i) {
+            Shard* shard = g_shards[i].load(std::memory_order_acquire);
+            if (shard != nullptr) fn(*shard);
+        }
+        fn(g_overflow_shard);
+    }
+
+    double ns_per_tick() {
+#if defined(SG_LATENCY_USE_TSC)
+        // Invariant TSC: measure its rate against steady_clock once
+        static const double ratio = [] {
+            using clock = std::chrono::steady_clock;
+            auto wall_start = clock::now();
+            uint64_t tsc_start = __rdtsc();
+            while (clock::now() - wall_start < std::chrono::milliseconds(5)) {
+            }
+            uint64_t tsc_end = __rdtsc();
+            double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                clock::now() - wall_start).count());
+            return (tsc_end > tsc_start) ? ns / static_cast<double>(tsc_end - tsc_start) : 1.0;
+        }();
+        return ratio;
+#else
+        return 1.0;
+#endif
+    }
+
+    double percentile_ticks(const uint64_t* merged, uint64_t count, double fraction) {
+        uint64_t rank = static_cast<uint64_t>(fraction * static_cast<double>(count));
+        if (rank >= count) rank = count - 1;
+        uint64_t seen = 0;
+        for (size_t b = 0; b < NUM_BUCKETS; ++b) {
+            seen += merged[b];
+            if (seen > rank) {
+                // Bucket midpoint
+                uint64_t lo = latency_buckets::lower_bound(b);
+                uint64_t hi = (b + 1 < NUM_BUCKETS) ? latency_buckets::lower_bound(b + 1) : lo;
+                return 0.5 * static_cast<double>(lo + hi);
+            }
+        }
+        return 0.0;
+    }
+}
+
+uint64_t now_ticks() {
+#if defined(SG_LATENCY_USE_TSC)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+void record(LatencyStage stage, uint64_t ticks) {
+    ShardHandle& handle = t_handle;
+    if (handle.shard == nullptr) {
+        acquire_shard(&handle);
+    }
+    size_t s = static_cast<size_t>(stage);
+    bump(handle.shard->buckets[s][latency_buckets::index_of(ticks)], 1, handle.exclusive);
+    bump(handle.shard->sum_ticks[s], ticks, handle.exclusive);
+}
+
+LatencySummary get_summary(LatencyStage stage) {
+    LatencySummary summary = {0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    size_t s = static_cast<size_t>(stage);
+
+    static thread_local uint64_t merged[NUM_BUCKETS];
+    uint64_t sum = 0;
+    for (size_t b = 0; b < NUM_BUCKETS; ++b) merged[b] = 0;
+    for_each_shard([&](Shard& shard) {
+        for (size_t b = 0; b < NUM_BUCKETS; ++b) {
+            merged[b] += shard.buckets[s][b].load(std::memory_order_relaxed);
+        }
+        sum += shard.sum_ticks[s].load(std::memory_order_relaxed);
+    });
+
+    for (size_t b = 0; b < NUM_BUCKETS; ++b) summary.count += merged[b];
+    if (summary.count == 0) {
+        return summary;
+    }
+
+    double scale = ns_per_tick();
+    summary.mean_ns = scale * static_cast<double>(sum) / static_cast<double>(summary.count);
+    summary.p50_ns = scale * percentile_ticks(merged, summary.count, 0.50);
+    summary.p90_ns = scale * percentile_ticks(merged, summary.count, 0.90);
+    summary.p99_ns = scale * percentile_ticks(merged, summary.count, 0.99);
+    summary.p999_ns = scale * percentile_ticks(merged, summary.count, 0.999);
+
+    for (size_t b = NUM_BUCKETS; b-- > 0;) {
+        if (merged[b] != 0) {
+            uint64_t top = (b + 1 < NUM_BUCKETS) ? latency_buckets::lower_bound(b + 1)
+                                                 : latency_buckets::lower_bound(b);
+            summary.max_ns = scale * static_cast<double>(top);
+            break;
+        }
+    }
+    return summary;
+}
+
+void reset() {
+    for_each_shard([](Shard& shard) {
+        for (size_t s = 0; s < NUM_LATENCY_STAGES; ++s) {
+            for (size_t b = 0; b < NUM_BUCKETS; ++b) {
+                shard.buckets[s][b].store(0, std::memory_order_relaxed);
+            }
+            shard.sum_ticks[s].store(0, std::memory_order_relaxed);
+        }
+    });
+}
+
+#else
+
+LatencySummary get_summary(LatencyStage /*stage*/) {
+    return LatencySummary{0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+}
+
+void reset() {
+}
+
+#endif
+
+} // namespace latency
+} // namespace core
+} // namespace spectral_gate
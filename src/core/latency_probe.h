@@ -0,0 +1,136 @@
+#ifndef LATENCY_PROBE_H
+#define LATENCY_PROBE_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace spectral_gate {
+namespace core {
+
+/**
+ * @brief Pipeline stages timed by latency probes
+ */
+enum class LatencyStage : uint8_t {
+    PREFILTER = 0,
+    SPECTRAL,
+    SIMILARITY,
+    INFERENCE,
+    DECISION,
+    WINDOW          // Whole process_window() call
+};
+
+constexpr size_t NUM_LATENCY_STAGES = 6;
+
+const char* latency_stage_name(LatencyStage stage);
+
+/**
+ * @brief Log-linear (HDR-style) bucket layout shared by all histograms
+ *
+ * Values below 2^SUB_BUCKET_BITS get one bucket each; every power of two
+ * above that is split into 2^SUB_BUCKET_BITS linear sub-buckets, so any
+ * recorded value is known to within 1/16 (6.25%). Values at or above
+ * 2^MAX_EXPONENT land in the last bucket.
+ */
+namespace latency_buckets {
+    constexpr uint32_t SUB_BUCKET_BITS = 4;
+    constexpr uint32_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+    constexpr uint32_t MAX_EXPONENT = 40;
+    constexpr size_t NUM_BUCKETS = SUB_BUCKETS + (MAX_EXPONENT - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+    /**
+     * @brief Bucket holding value
+     */
+    size_t index_of(uint64_t value);
+
+    /**
+     * @brief Smallest value mapped to bucket index
+     */
+    uint64_t lower_bound(size_t index);
+}
+
+/**
+ * @brief Summary of one stage's merged histogram (nanoseconds)
+ */
+struct LatencySummary {
+    uint64_t count;
+    double mean_ns;
+    double p50_ns;
+    double p90_ns;
+    double p99_ns;
+    double p999_ns;
+    double max_ns;      // Upper edge of the highest occupied bucket
+};
+
+/**
+ * @brief Latency probe runtime (host builds with SPECTRAL_GATE_LATENCY_PROBES)
+ *
+ * Each thread records into its own shard of fixed-bucket histograms with
+ * single-writer relaxed stores, so probes never contend or lock. Readers
+ * merge all shards. A finished thread's shard, counts intact, goes to the
+ * next new thread, so short-lived workers do not use up the shards. Probes record raw ticks (TSC on x86-64, steady_clock
+ * nanoseconds elsewhere); conversion to nanoseconds happens on read.
+ *
+ * Without the define every call below is a no-op and SG_LATENCY_PROBE
+ * expands to nothing, so firmware carries no code or storage for it.
+ */
+namespace latency {
+
+#if defined(SPECTRAL_GATE_LATENCY_PROBES)
+constexpr bool ENABLED = true;
+
+/**
+ * @brief Current tick count
+ */
+uint64_t now_ticks();
+
+/**
+ * @brief Record a duration in ticks for the calling thread
+ */
+void record(LatencyStage stage, uint64_t ticks);
+
+/**
+ * @brief Times the enclosing scope into a stage histogram
+ */
+class ScopedProbe {
+public:
+    explicit ScopedProbe(LatencyStage stage) : stage_(stage), start_(now_ticks()) {}
+    ~ScopedProbe() { record(stage_, now_ticks() - start_); }
+
+    ScopedProbe(const ScopedProbe&) = delete;
+    ScopedProbe& operator=(const ScopedProbe&) = delete;
+
+private:
+    LatencyStage stage_;
+    uint64_t start_;
+};
+#else
+constexpr bool ENABLED = false;
+#endif
+
+/**
+ * @brief Merge all thread shards for a stage
+ * @return Summary (all zero when probes are compiled out)
+ */
+LatencySummary get_summary(LatencyStage stage);
+
+/**
+ * @brief Clear all histograms (call while no probes are running)
+ */
+void reset();
+
+} // namespace latency
+
+#if defined(SPECTRAL_GATE_LATENCY_PROBES)
+#define SG_LATENCY_PROBE_CONCAT_(a, b) a##b
+#define SG_LATENCY_PROBE_NAME_(line) SG_LATENCY_PROBE_CONCAT_(sg_latency_probe_, line)
+#define SG_LATENCY_PROBE(stage) \
+    ::spectral_gate::core::latency::ScopedProbe SG_LATENCY_PROBE_NAME_(__LINE__)( \
+        ::spectral_gate::core::LatencyStage::stage)
+#else
+#define SG_LATENCY_PROBE(stage) ((void)0)
+#endif
+
+} // namespace core
+} // namespace spectral_gate
+
+#endif // LATENCY_PROBE_H
@@ -0,0 +1,142 @@
+#ifndef OP_COUNTER_H
+#define OP_COUNTER_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace spectral_gate {
+namespace core {
+
+/**
+ * @brief Abstract operation classes counted by the instrumented build
+ *
+ * Counts follow the source-level work a Cortex-M33 would execute (one
+ * MAC per 32x32->64 multiply-accumulate, one DIVIDE per integer divide
+ * that survives as a divide instruction or libcall), not the host
+ * compiler's output, so they are the same on every host.
+ */
+enum class OpClass : uint8_t {
+    MAC = 0,        // Multiply / multiply-accumulate
+    LOAD,           // Memory read
+    STORE,          // Memory write
+    BRANCH,         // Loop back-edge or data-dependent branch
+    DIVIDE,         // Integer divide
+    ALU             // Add/sub/shift/compare/select
+};
+
+constexpr size_t NUM_OP_CLASSES = 6;
+
+/**
+ * @brief Pipeline stage the counted operations are attributed to
+ */
+enum class OpStage : uint8_t {
+    OTHER = 0,      // Outside any instrumented stage
+    PREFILTER,
+    SPECTRAL,
+    SIMILARITY,
+    INFERENCE,
+    DECISION
+};
+
+constexpr size_t NUM_OP_STAGES = 6;
+
+/**
+ * @brief Operation counts for one stage
+ */
+struct OpCounts {
+    uint64_t ops[NUM_OP_CLASSES];
+};
+
+inline const char* op_class_name(OpClass op) {
+    switch (op) {
+        case OpClass::MAC:    return "mac";
+        case OpClass::LOAD:   return "load";
+        case OpClass::STORE:  return "store";
+        case OpClass::BRANCH: return "branch";
+        case OpClass::DIVIDE: return "divide";
+        case OpClass::ALU:    return "alu";
+    }
+    return "?";
+}
+
+inline const char* op_stage_name(OpStage stage) {
+    switch (stage) {
+        case OpStage::OTHER:      return "other";
+        case OpStage::PREFILTER:  return "prefilter";
+        case OpStage::SPECTRAL:   return "spectral";
+        case OpStage::SIMILARITY: return "similarity";
+        case OpStage::INFERENCE:  return "inference";
+        case OpStage::DECISION:   return "decision";
+    }
+    return "?";
+}
+
+/**
+ * @brief Per-thread counter state (only touched by the instrumented build)
+ */
+namespace ops {
+
+struct CounterState {
+    OpCounts stages[NUM_OP_STAGES];
+    OpStage current;
+};
+
+inline CounterState& state() {
+    static thread_local CounterState s = {};
+    return s;
+}
+
+inline void add(OpClass op, uint64_t count) {
+    CounterState& s = state();
+    s.stages[static_cast<size_t>(s.current)].ops[static_cast<size_t>(op)] += count;
+}
+
+inline void reset() {
+    state() = CounterState{};
+}
+
+inline OpCounts get(OpStage stage) {
+    return state().stages[static_cast<size_t>(stage)];
+}
+
+/**
+ * @brief Attribute operations to a stage for the lifetime of the scope
+ */
+class StageScope {
+public:
+    explicit StageScope(OpStage stage) : previous_(state().current) {
+        state().current = stage;
+    }
+    ~StageScope() { state().current = previous_; }
+
+    StageScope(const StageScope&) = delete;
+    StageScope& operator=(const StageScope&) = delete;
+
+private:
+    OpStage previous_;
+};
+
+} // namespace ops
+
+/**
+ * @brief True when kernels were built with SPECTRAL_GATE_OP_COUNT
+ */
+#if defined(SPECTRAL_GATE_OP_COUNT)
+constexpr bool OP_COUNTING_ENABLED = true;
+
+#define SG_COUNT_OPS(op, n) \
+    ::spectral_gate::core::ops::add(::spectral_gate::core::OpClass::op, static_cast<uint64_t>(n))
+#define SG_OP_STAGE(stage) \
+    ::spectral_gate::core::ops::StageScope sg_op_stage_scope_(::spectral_gate::core::OpStage::stage)
+#else
+constexpr bool OP_COUNTING_ENABLED = false;
+
+// Compile out completely: arguments are not evaluated
+#define SG_COUNT_OPS(op, n) ((void)0)
+#define SG_OP_STAGE(stage) ((void)0)
+#endif
+
+} // namespace core
+} // namespace spectral_gate
+
+#endif // OP_COUNTER_H
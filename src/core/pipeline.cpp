@@ -0,0 +1,88 @@
+#include "pipeline.h"
+#include "latency_probe.h"
+#include "trace.h"
+
+namespace spectral_gate {
+namespace core {
+
+using namespace hal;
+
+WindowPipeline::WindowPipeline(
+    SpectralProcessor& spectral,
+    InferenceEngine& engine,
+    const ThresholdConfig& config
+) : spectral_(&spectral),
+    engine_(&engine),
+    prefilter_(nullptr),
+    similarity_cache_(nullptr),
+    config_(config)
+{
+}
+
+void WindowPipeline::set_engine(InferenceEngine& engine) {
+    SG_TRACE_INSTANT(MODEL, "model_swap");
+    engine_ = &engine;
+    if (similarity_cache_ != nullptr) {
+        similarity_cache_->clear();
+    }
+}
+
+WindowOutcome WindowPipeline::process_window(
+    int16_t* samples,
+    size_t num_samples,
+    uint16_t battery_mv
+) {
+    SG_LATENCY_PROBE(WINDOW);
+    SG_TRACE_SCOPE(STAGE, "window");
+    WindowOutcome outcome;
+    
+    // Stage 0: remove DC/drift ahead of the spectral stage
+    if (prefilter_ != nullptr) {
+        SG_LATENCY_PROBE(PREFILTER);
+        SG_TRACE_SCOPE(STAGE, "prefilter");
+        prefilter_->process(samples, samples, num_samples);
+    }
+    
+    // Stage 1: spectrum and features from a single DFT pass
+    fixed_t features[MAX_FEATURES];
+    size_t num_features = 0;
+    {
+        SG_LATENCY_PROBE(SPECTRAL);
+        SG_TRACE_SCOPE(STAGE, "spectral");
+        outcome.spectral = spectral_->process_with_features(
+            samples, num_samples, features, MAX_FEATURES, &num_features
+        );
+    }
+    
+    // Stage 2: inference, unless a recent window had the same signature
+    bool reused = false;
+    uint32_t signature = 0;
+    if (similarity_cache_ != nullptr) {
+        SG_LATENCY_PROBE(SIMILARITY);
+        SG_TRACE_SCOPE(STAGE, "similarity");
+        signature = compute_band_signature(features, num_features);
+        reused = similarity_cache_->lookup(signature, &outcome.inference);
+    }
+    if (!reused) {
+        SG_LATENCY_PROBE(INFERENCE);
+        SG_TRACE_SCOPE(STAGE, "inference");
+        outcome.inference = engine_->run(features, num_features);
+        if (similarity_cache_ != nullptr) {
+            similarity_cache_->insert(signature, outcome.inference);
+        }
+    }
+    
+    // Stage 3: battery-aware decision
+    {
+        SG_LATENCY_PROBE(DECISION);
+        SG_TRACE_SCOPE(STAGE, "decision");
+        outcome.decision = evaluate_structure(
+            outcome.spectral, outcome.inference, battery_mv, config_
+        );
+    }
+    
+    return outcome;
+}
+
+} // namespace core
+} // namespace spectral_gate
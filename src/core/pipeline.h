@@ -0,0 +1,97 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <cstdint>
+#include <cstddef>
+#include "hal/hal_interface.h"
+#include "decision.h"
+#include "inference.h"
+#include "prefilter.h"
+#include "similarity.h"
+#include "spectral.h"
+
+namespace spectral_gate {
+namespace core {
+
+/**
+ * @brief Per-window output of the full processing chain
+ */
+struct WindowOutcome {
+    SpectralResult spectral;
+    InferenceResult inference;
+    Decision decision;
+};
+
+/**
+ * @brief End-to-end window pipeline: pre-filter -> spectral -> inference -> decision
+ * 
+ * Holds non-owning references to the stage objects so firmware can keep
+ * them in static storage. No heap allocation on the per-window path.
+ */
+class WindowPipeline {
+public:
+    // Stack budget for the per-window feature vector
+    static constexpr size_t MAX_FEATURES = 128;
+
+    /**
+     * @brief Build pipeline over existing stage objects
+     * @param spectral Spectral processor
+     * @param engine Inference engine
+     * @param config Threshold configuration
+     */
+    WindowPipeline(
+        SpectralProcessor& spectral,
+        InferenceEngine& engine,
+        const ThresholdConfig& config
+    );
+
+    /**
+     * @brief Attach a streaming pre-filter (nullptr to bypass)
+     */
+    void set_prefilter(PreFilter* prefilter) { prefilter_ = prefilter; }
+
+    /**
+     * @brief Attach a similarity cache to skip inference on repeated
+     *        spectra (nullptr to always run the model)
+     */
+    void set_similarity_cache(SimilarityCache* cache) { similarity_cache_ = cache; }
+
+    /**
+     * @brief Swap in a different inference model
+     * 
+     * Clears the attached similarity cache, since its results came from
+     * the previous model.
+     */
+    void set_engine(InferenceEngine& engine);
+
+    /**
+     * @brief Replace threshold configuration
+     */
+    void set_config(const ThresholdConfig& config) { config_ = config; }
+
+    /**
+     * @brief Get threshold configuration
+     */
+    const ThresholdConfig& get_config() const { return config_; }
+
+    /**
+     * @brief Run one window through the chain
+     * @param samples Raw samples; filtered in place when a pre-filter is attached
+     * @param num_samples Number of samples
+     * @param battery_mv Current battery voltage in millivolts
+     * @return Spectral, inference and decision results
+     */
+    WindowOutcome process_window(int16_t* samples, size_t num_samples, uint16_t battery_mv);
+
+private:
+    SpectralProcessor* spectral_;
+    InferenceEngine* engine_;
+    PreFilter* prefilter_;
+    SimilarityCache* similarity_cache_;
+    ThresholdConfig config_;
+};
+
+} // namespace core
+} // namespace spectral_gate
+
+#endif // PIPELINE_H
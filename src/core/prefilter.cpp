@@ -0,0 +1,185 @@
+#include "prefilter.h"
+#include "op_counter.h"
+#include <cmath>
+
+namespace spectral_gate {
+namespace core {
+
+using namespace hal;
+
+namespace {
+    constexpr double PI = 3.14159265358979323846;
+
+    // Coefficient design runs once at configuration time, so float math
+    // is acceptable here (Cortex-M33 has a single-precision FPU)
+    int32_t to_biquad_q(double value) {
+        return static_cast<int32_t>(std::lround(value * (1 << BIQUAD_SHIFT)));
+    }
+
+    BiquadCoeffs normalize(double b0, double b1, double b2,
+                           double a0, double a1, double a2) {
+        BiquadCoeffs c;
+        c.b0 = to_biquad_q(b0 / a0);
+        c.b1 = to_biquad_q(b1 / a0);
+        c.b2 = to_biquad_q(b2 / a0);
+        c.a1 = to_biquad_q(a1 / a0);
+        c.a2 = to_biquad_q(a2 / a0);
+        return c;
+    }
+
+    int16_t saturate_int16(int32_t value) {
+        if (value > INT16_MAX) return INT16_MAX;
+        if (value < INT16_MIN) return INT16_MIN;
+        return static_cast<int16_t>(value);
+    }
+
+    // One Direct Form I step with second-order error feedback
+    // (noise transfer (1 - z^-1)^2 / A(z), zero at DC); state holds
+    // unsaturated output
+    int32_t biquad_step(const BiquadCoeffs& c, BiquadState& s, int32_t x) {
+        int64_t acc = static_cast<int64_t>(c.b0) * x +
+                      static_cast<int64_t>(c.b1) * s.x1 +
+                      static_cast<int64_t>(c.b2) * s.x2 -
+                      static_cast<int64_t>(c.a1) * s.y1 -
+                      static_cast<int64_t>(c.a2) * s.y2 +
+                      2 * static_cast<int64_t>(s.e1) - s.e2;
+        int32_t y = static_cast<int32_t>(acc >> BIQUAD_SHIFT);
+        int32_t e = static_cast<int32_t>(acc - static_cast<int64_t>(y) * (int64_t(1) << BIQUAD_SHIFT));
+
+        s.x2 = s.x1;
+        s.x1 = x;
+        s.y2 = s.y1;
+        s.y1 = y;
+        s.e2 = s.e1;
+        s.e1 = e;
+        return y;
+    }
+}
+
+BiquadCoeffs design_dc_blocker(float pole) {
+    return normalize(1.0, -1.0, 0.0, 1.0, -static_cast<double>(pole), 0.0);
+}
+
+BiquadCoeffs design_highpass(float cutoff_hz, uint32_t sample_rate, float q) {
+    double w0 = 2.0 * PI * cutoff_hz / sample_rate;
+    double cos_w0 = std::cos(w0);
+    double alpha = std::sin(w0) / (2.0 * q);
+
+    return normalize((1.0 + cos_w0) / 2.0, -(1.0 + cos_w0), (1.0 + cos_w0) / 2.0,
+                     1.0 + alpha, -2.0 * cos_w0, 1.0 - alpha);
+}
+
+BiquadCoeffs design_notch(float center_hz, uint32_t sample_rate, float q) {
+    double w0 = 2.0 * PI * center_hz / sample_rate;
+    double cos_w0 = std::cos(w0);
+    double alpha = std::sin(w0) / (2.0 * q);
+
+    return normalize(1.0, -2.0 * cos_w0, 1.0,
+                     1.0 + alpha, -2.0 * cos_w0, 1.0 - alpha);
+}
+
+PreFilter::PreFilter()
+    : coeffs_{}, state_{}, num_sections_(0)
+{
+}
+
+bool PreFilter::add_section(const BiquadCoeffs& coeffs) {
+    if (num_sections_ >= MAX_SECTIONS) {
+        return false;
+    }
+    coeffs_[num_sections_] = coeffs;
+    for (size_t a = 0; a < NUM_AXES; ++a) {
+        state_[num_sections_][a] = BiquadState{0, 0, 0, 0, 0, 0};
+    }
+    ++num_sections_;
+    return true;
+}
+
+void PreFilter::reset() {
+    for (size_t s = 0; s < MAX_SECTIONS; ++s) {
+        for (size_t a = 0; a < NUM_AXES; ++a) {
+            state_[s][a] = BiquadState{0, 0, 0, 0, 0, 0};
+        }
+    }
+}
+
+void PreFilter::process(const int16_t* input, int16_t* output, size_t count) {
+    if (num_sections_ == 0) {
+        if (input != output) {
+            for (size_t i = 0; i < count; ++i) output[i] = input[i];
+        }
+        return;
+    }
+
+    // Per sample and section: five MACs, error feedback, shift/residue,
+    // saturation compares, loop branch
+    SG_OP_STAGE(PREFILTER);
+    SG_COUNT_OPS(MAC, 5 * num_sections_ * count);
+    SG_COUNT_OPS(ALU, 6 * num_sections_ * count);
+    SG_COUNT_OPS(LOAD, num_sections_ * count);
+    SG_COUNT_OPS(STORE, num_sections_ * count);
+    SG_COUNT_OPS(BRANCH, num_sections_ * count);
+    
+    // Section-major: run the whole block through one section at a time
+    const int16_t* src = input;
+    for (size_t s = 0; s < num_sections_; ++s) {
+        const BiquadCoeffs c = coeffs_[s];
+        BiquadState st = state_[s][0];
+
+        for (size_t i = 0; i < count; ++i) {
+            output[i] = saturate_int16(biquad_step(c, st, src[i]));
+        }
+
+        state_[s][0] = st;
+        src = output;
+    }
+}
+
+void PreFilter::process_frames(const int16_t* input, int16_t* output, size_t num_frames) {
+    size_t count = num_frames * NUM_AXES;
+
+    if (num_sections_ == 0) {
+        if (input != output) {
+            for (size_t i = 0; i < count; ++i) output[i] = input[i];
+        }
+        return;
+    }
+
+    SG_OP_STAGE(PREFILTER);
+    SG_COUNT_OPS(MAC, 5 * num_sections_ * count);
+    SG_COUNT_OPS(ALU, 6 * num_sections_ * count);
+    SG_COUNT_OPS(LOAD, num_sections_ * count);
+    SG_COUNT_OPS(STORE, num_sections_ * count);
+    SG_COUNT_OPS(BRANCH, num_sections_ * num_frames);
+    
+    const int16_t* src = input;
+    for (size_t s = 0; s < num_sections_; ++s) {
+        const BiquadCoeffs c = coeffs_[s];
+        BiquadState st[NUM_AXES];
+        for (size_t a = 0; a < NUM_AXES; ++a) st[a] = state_[s][a];
+
+        // Axes advance in lockstep through the section
+        for (size_t n = 0; n < num_frames; ++n) {
+            for (size_t a = 0; a < NUM_AXES; ++a) {
+                size_t idx = n * NUM_AXES + a;
+                output[idx] = saturate_int16(biquad_step(c, st[a], src[idx]));
+            }
+        }
+
+        for (size_t a = 0; a < NUM_AXES; ++a) state_[s][a] = st[a];
+        src = output;
+    }
+}
+
+PreFilter create_default_prefilter(uint32_t sample_rate, uint32_t mains_hz) {
+    PreFilter filter;
+    filter.add_section(design_dc_blocker(0.995f));
+    filter.add_section(design_highpass(2.0f, sample_rate, 0.7071f));
+    if (mains_hz > 0 && mains_hz * 2 < sample_rate) {
+        filter.add_section(design_notch(static_cast<float>(mains_hz), sample_rate, 10.0f));
+    }
+    return filter;
+}
+
+} // namespace core
+} // namespace spectral_gate
@@ -0,0 +1,131 @@
+#ifndef PREFILTER_H
+#define PREFILTER_H
+
+#include <cstdint>
+#include <cstddef>
+#include "hal/hal_interface.h"
+
+namespace spectral_gate {
+namespace core {
+
+// Biquad coefficient format: Q4.28 (range +/-8, a0 normalized to 1)
+constexpr int BIQUAD_SHIFT = 28;
+
+/**
+ * @brief Fixed-point biquad coefficients (Direct Form I)
+ *
+ * y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] - a1*y[n-1] - a2*y[n-2]
+ */
+struct BiquadCoeffs {
+    int32_t b0;
+    int32_t b1;
+    int32_t b2;
+    int32_t a1;
+    int32_t a2;
+};
+
+/**
+ * @brief Persistent Direct Form I state for one channel
+ *
+ * e1/e2 hold the last truncation residues for second-order error
+ * feedback, which keeps quantization noise out of the low bins when
+ * poles sit close to z = 1 (DC blocker, low-corner high-pass).
+ */
+struct BiquadState {
+    int32_t x1;
+    int32_t x2;
+    int32_t y1;
+    int32_t y2;
+    int32_t e1;
+    int32_t e2;
+};
+
+/**
+ * @brief First-order DC blocker: H(z) = (1 - z^-1) / (1 - pole*z^-1)
+ * @param pole Pole radius (e.g. 0.995); closer to 1 = lower corner
+ */
+BiquadCoeffs design_dc_blocker(float pole);
+
+/**
+ * @brief Second-order Butterworth-style high-pass (RBJ cookbook)
+ * @param cutoff_hz Corner frequency in Hz
+ * @param sample_rate Sample rate in Hz
+ * @param q Quality factor (0.7071 = maximally flat)
+ */
+BiquadCoeffs design_highpass(float cutoff_hz, uint32_t sample_rate, float q);
+
+/**
+ * @brief Second-order notch (RBJ cookbook), e.g. for mains hum
+ * @param center_hz Notch frequency in Hz
+ * @param sample_rate Sample rate in Hz
+ * @param q Quality factor (higher = narrower notch)
+ */
+BiquadCoeffs design_notch(float center_hz, uint32_t sample_rate, float q);
+
+/**
+ * @brief Streaming biquad cascade applied ahead of the spectral stage
+ *
+ * Filter state persists across windows so consecutive windows see a
+ * continuous signal. Blocks are processed section by section, keeping one
+ * section's coefficients in registers for the whole block; tri-axial
+ * frames run all axes of a section in lockstep.
+ */
+class PreFilter {
+public:
+    static constexpr size_t MAX_SECTIONS = 4;
+
+    PreFilter();
+
+    /**
+     * @brief Append a section to the cascade
+     * @return false if the cascade is full
+     */
+    bool add_section(const BiquadCoeffs& coeffs);
+
+    /**
+     * @brief Clear filter state (e.g. after a sensor restart)
+     */
+    void reset();
+
+    /**
+     * @brief Filter a single-channel block (in-place allowed)
+     * @param input Input samples
+     * @param output Output samples (saturated to int16)
+     * @param count Number of samples
+     */
+    void process(const int16_t* input, int16_t* output, size_t count);
+
+    /**
+     * @brief Filter interleaved X/Y/Z frames (in-place allowed)
+     * @param input Interleaved input frames
+     * @param output Interleaved output frames
+     * @param num_frames Number of frames
+     */
+    void process_frames(const int16_t* input, int16_t* output, size_t num_frames);
+
+    /**
+     * @brief Get number of active sections
+     */
+    size_t get_num_sections() const { return num_sections_; }
+
+private:
+    BiquadCoeffs coeffs_[MAX_SECTIONS];
+    BiquadState state_[MAX_SECTIONS][hal::NUM_AXES];   // Axis 0 doubles as the mono channel
+    size_t num_sections_;
+};
+
+/**
+ * @brief Create the default pre-filter cascade
+ *
+ * DC blocker followed by a 2 Hz high-pass for drift, plus an optional
+ * mains notch.
+ *
+ * @param sample_rate Sample rate in Hz
+ * @param mains_hz Mains frequency to notch (50/60), or 0 to disable
+ */
+PreFilter create_default_prefilter(uint32_t sample_rate, uint32_t mains_hz);
+
+} // namespace core
+} // namespace spectral_gate
+
+#endif // PREFILTER_H
@@ -0,0 +1,148 @@
+#include "similarity.h"
+#include "op_counter.h"
+
+namespace spectral_gate {
+namespace core {
+
+using namespace hal;
+
+namespace {
+    constexpr size_t NUM_BANDS = 16;
+    
+    // Gray code for levels 0..3: adjacent levels differ by one bit
+    constexpr uint32_t GRAY_LEVEL[4] = {0x0, 0x1, 0x3, 0x2};
+    
+    uint32_t quantize_level(fixed_t band_mean) {
+        // Log-spaced thresholds: 1/8, 1/4, 1/2 of full scale
+        if (band_mean < (FIXED_ONE >> 3)) return 0;
+        if (band_mean < (FIXED_ONE >> 2)) return 1;
+        if (band_mean < (FIXED_ONE >> 1)) return 2;
+        return 3;
+    }
+}
+
+uint32_t compute_band_signature(const fixed_t* features, size_t count) {
+    uint32_t signature = 0;
+    
+    if (features == nullptr || count == 0) {
+        return signature;
+    }
+    
+    size_t bands = (count < NUM_BANDS) ? count : NUM_BANDS;
+    
+    // Band sums, then per band: edge and mean divides, level compares
+    SG_OP_STAGE(SIMILARITY);
+    SG_COUNT_OPS(LOAD, count);
+    SG_COUNT_OPS(ALU, count + 6 * bands);
+    SG_COUNT_OPS(BRANCH, count + 4 * bands);
+    SG_COUNT_OPS(DIVIDE, 3 * bands);
+    
+    for (size_t b = 0; b < bands; ++b) {
+        size_t begin = (b * count) / bands;
+        size_t end = ((b + 1) * count) / bands;
+        
+        int64_t sum = 0;
+        for (size_t i = begin; i < end; ++i) {
+            sum += features[i];
+        }
+        fixed_t mean = static_cast<fixed_t>(sum / static_cast<int64_t>(end - begin));
+        
+        signature |= GRAY_LEVEL[quantize_level(mean)] << (2 * b);
+    }
+    
+    return signature;
+}
+
+uint8_t signature_distance(uint32_t a, uint32_t b) {
+    uint32_t diff = a ^ b;
+    uint8_t bits = 0;
+    while (diff != 0) {
+        diff &= diff - 1;  // Clear lowest set bit
+        ++bits;
+    }
+    return bits;
+}
+
+SimilarityCache::SimilarityCache(uint8_t max_distance)
+    : entries_{},
+      max_distance_(max_distance),
+      clock_(0),
+      stats_{0, 0, 0}
+{
+}
+
+bool SimilarityCache::lookup(uint32_t signature, InferenceResult* result) {
+    ++stats_.lookups;
+    ++clock_;
+    
+    // Entry scan with a popcount of up to 32 iterations per valid entry
+    SG_OP_STAGE(SIMILARITY);
+    SG_COUNT_OPS(LOAD, 2 * CAPACITY);
+    SG_COUNT_OPS(BRANCH, 2 * CAPACITY);
+    
+    // Pick the closest valid entry within range
+    size_t best = CAPACITY;
+    unsigned best_distance = static_cast<unsigned>(max_distance_) + 1;  // No wrap at 255
+    
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        if (!entries_[i].valid) continue;
+        
+        uint8_t distance = signature_distance(entries_[i].signature, signature);
+        SG_COUNT_OPS(ALU, 3 * distance + 2);
+        SG_COUNT_OPS(BRANCH, distance);
+        if (distance < best_distance) {
+            best_distance = distance;
+            best = i;
+        }
+    }
+    
+    if (best == CAPACITY) {
+        return false;
+    }
+    
+    entries_[best].last_used = clock_;
+    *result = entries_[best].result;
+    ++stats_.hits;
+    return true;
+}
+
+void SimilarityCache::insert(uint32_t signature, const InferenceResult& result) {
+    // Prefer an empty slot, otherwise evict the least recently used
+    SG_OP_STAGE(SIMILARITY);
+    SG_COUNT_OPS(LOAD, 2 * CAPACITY);
+    SG_COUNT_OPS(BRANCH, 2 * CAPACITY);
+    SG_COUNT_OPS(STORE, 4);
+    
+    size_t victim = 0;
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        if (!entries_[i].valid) {
+            victim = i;
+            break;
+        }
+        if (entries_[i].last_used < entries_[victim].last_used) {
+            victim = i;
+        }
+    }
+    
+    entries_[victim].signature = signature;
+    entries_[victim].last_used = clock_;
+    entries_[victim].result = result;
+    entries_[victim].valid = true;
+    ++stats_.insertions;
+}
+
+void SimilarityCache::clear() {
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        entries_[i].valid = false;
+    }
+}
+
+uint8_t SimilarityCache::get_hit_rate_percent() const {
+    if (stats_.lookups == 0) {
+        return 0;
+    }
+    return static_cast<uint8_t>((static_cast<uint64_t>(stats_.hits) * 100) / stats_.lookups);
+}
+
+} // namespace core
+} // namespace spectral_gate
@@ -0,0 +1,103 @@
+#ifndef SIMILARITY_H
+#define SIMILARITY_H
+
+#include <cstdint>
+#include <cstddef>
+#include "hal/hal_interface.h"
+#include "decision.h"
+
+namespace spectral_gate {
+namespace core {
+
+/**
+ * @brief Compute a locality-sensitive band signature of a feature vector
+ * 
+ * Features are split into 16 bands; each band mean is quantized to four
+ * log-spaced levels and Gray-coded into 2 bits. Adjacent levels differ in
+ * exactly one bit, so the Hamming distance between signatures tracks how
+ * far two spectra are apart.
+ * 
+ * @param features Normalized feature vector (fixed-point, 0.0 to 1.0)
+ * @param count Number of features
+ * @return 32-bit signature
+ */
+uint32_t compute_band_signature(const hal::fixed_t* features, size_t count);
+
+/**
+ * @brief Hamming distance between two signatures
+ */
+uint8_t signature_distance(uint32_t a, uint32_t b);
+
+/**
+ * @brief Similarity cache hit statistics
+ */
+struct SimilarityStats {
+    uint32_t lookups;       // Windows checked against the cache
+    uint32_t hits;          // Windows that reused a cached result
+    uint32_t insertions;    // Results stored after a miss
+};
+
+/**
+ * @brief Small cache of recent signatures mapped to inference results
+ * 
+ * During steady operation consecutive windows have nearly identical
+ * spectra; a window whose signature is within max_distance of a cached
+ * one reuses that InferenceResult instead of running the model.
+ * Least-recently-used entries are evicted.
+ */
+class SimilarityCache {
+public:
+    static constexpr size_t CAPACITY = 8;
+
+    /**
+     * @brief Create cache
+     * @param max_distance Maximum Hamming distance treated as a match
+     */
+    explicit SimilarityCache(uint8_t max_distance);
+
+    /**
+     * @brief Find a cached result for a signature
+     * @param signature Window signature
+     * @param result Receives the cached result on hit
+     * @return true on hit
+     */
+    bool lookup(uint32_t signature, InferenceResult* result);
+
+    /**
+     * @brief Store a freshly computed result
+     */
+    void insert(uint32_t signature, const InferenceResult& result);
+
+    /**
+     * @brief Drop all entries (e.g. after a model change); keeps statistics
+     */
+    void clear();
+
+    /**
+     * @brief Get hit statistics
+     */
+    const SimilarityStats& get_stats() const { return stats_; }
+
+    /**
+     * @brief Get hit rate in percent (0-100)
+     */
+    uint8_t get_hit_rate_percent() const;
+
+private:
+    struct Entry {
+        uint32_t signature;
+        uint32_t last_used;
+        InferenceResult result;
+        bool valid;
+    };
+
+    Entry entries_[CAPACITY];
+    uint8_t max_distance_;
+    uint32_t clock_;
+    SimilarityStats stats_;
+};
+
+} // namespace core
+} // namespace spectral_gate
+
+#endif // SIMILARITY_H
@@ -1,4 +1,5 @@
 #include "spectral.h"
+#include "op_counter.h"
 #include <cmath>
 
 namespace spectral_gate {
@@ -34,6 +35,73 @@ namespace {
     fixed_t fast_cos(uint32_t angle_256) {
         return fast_sin(angle_256 + 64);  // cos(x) = sin(x + π/2)
     }
+    
+    // Stack budget for per-window magnitude buffers
+    constexpr size_t MAX_BINS = 128;
+    
+    // Accumulator lanes for multi-axis processing (NUM_AXES padded to a
+    // power of two so hosts can keep all axes in one vector register)
+    constexpr size_t AXIS_LANES = 4;
+    static_assert(NUM_AXES <= AXIS_LANES, "axis count exceeds accumulator lanes");
+    
+    // Normalize DFT sums and apply the magnitude approximation
+    // |z| ≈ max(|Re|,|Im|) + 0.4*min(|Re|,|Im|)
+    fixed_t magnitude_from_sums(int64_t real_sum, int64_t imag_sum, size_t num_samples) {
+        real_sum /= static_cast<int64_t>(num_samples);
+        imag_sum /= static_cast<int64_t>(num_samples);
+        
+        int64_t abs_real = (real_sum >= 0) ? real_sum : -real_sum;
+        int64_t abs_imag = (imag_sum >= 0) ? imag_sum : -imag_sum;
+        
+        int64_t max_val = (abs_real > abs_imag) ? abs_real : abs_imag;
+        int64_t min_val = (abs_real < abs_imag) ? abs_real : abs_imag;
+        
+        return static_cast<fixed_t>((max_val + (min_val * 4) / 10) >> FIXED_SHIFT);
+    }
+    
+    // Scale a spectrum block so its maximum maps to FIXED_ONE
+    void normalize_block(fixed_t* values, size_t count) {
+        SG_OP_STAGE(SPECTRAL);
+        SG_COUNT_OPS(LOAD, count);
+        SG_COUNT_OPS(BRANCH, count);
+        
+        fixed_t max_val = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (values[i] > max_val) max_val = values[i];
+        }
+        
+        if (max_val > 0) {
+            // One 64-bit divide per feature
+            SG_COUNT_OPS(LOAD, count);
+            SG_COUNT_OPS(ALU, count);
+            SG_COUNT_OPS(DIVIDE, count);
+            SG_COUNT_OPS(STORE, count);
+            SG_COUNT_OPS(BRANCH, count);
+            for (size_t i = 0; i < count; ++i) {
+                values[i] = (static_cast<int64_t>(values[i]) * FIXED_ONE) / max_val;
+            }
+        }
+    }
+    
+    // Integer square root (bitwise, no division)
+    uint32_t isqrt64(uint64_t value) {
+        uint64_t result = 0;
+        uint64_t bit = uint64_t(1) << 62;
+        
+        while (bit > value) bit >>= 2;
+        
+        while (bit != 0) {
+            if (value >= result + bit) {
+                value -= result + bit;
+                result = (result >> 1) + bit;
+            } else {
+                result >>= 1;
+            }
+            bit >>= 2;
+        }
+        
+        return static_cast<uint32_t>(result);
+    }
 }
 
 SpectralProcessor::SpectralProcessor(size_t num_bins, uint32_t sample_rate)
@@ -41,14 +109,26 @@ SpectralProcessor::SpectralProcessor(size_t num_bins, uint32_t sample_rate)
 {
 }
 
+template <typename SampleT>
 void SpectralProcessor::compute_magnitude_spectrum(
-    const int16_t* samples,
+    const SampleT* samples,
     size_t num_samples,
     fixed_t* magnitudes
 ) {
     // Simplified DFT for select frequency bins
     // In production, would use optimized FFT or Goertzel algorithm
     
+    // Per sample and bin: sample load, two MACs, angle update plus two
+    // triangle-wave evaluations, loop branch. Per bin: bin frequency
+    // divide and magnitude_from_sums() (two divides, abs/min/max)
+    SG_OP_STAGE(SPECTRAL);
+    SG_COUNT_OPS(LOAD, num_bins_ * num_samples);
+    SG_COUNT_OPS(MAC, 2 * num_bins_ * num_samples);
+    SG_COUNT_OPS(ALU, num_bins_ * (14 * num_samples + 8));
+    SG_COUNT_OPS(BRANCH, num_bins_ * (num_samples + 1));
+    SG_COUNT_OPS(DIVIDE, 3 * num_bins_);
+    SG_COUNT_OPS(STORE, num_bins_);
+    
     for (size_t k = 0; k < num_bins_; ++k) {
         int64_t real_sum = 0;
         int64_t imag_sum = 0;
@@ -62,25 +142,83 @@ void SpectralProcessor::compute_magnitude_spectrum(
             fixed_t cos_val = fast_cos(angle);
             fixed_t sin_val = fast_sin(angle);
             
-            // Accumulate (sample is int16, result scaled to fixed-point)
-            real_sum += static_cast<int64_t>(samples[n]) * cos_val;
-            imag_sum += static_cast<int64_t>(samples[n]) * sin_val;
+            // Accumulate (sample converted in-loop, result scaled to fixed-point)
+            int32_t sample = SampleTraits<SampleT>::to_acc(samples[n]);
+            real_sum += static_cast<int64_t>(sample) * cos_val;
+            imag_sum += static_cast<int64_t>(sample) * sin_val;
         }
         
-        // Normalize by sample count
-        real_sum /= static_cast<int64_t>(num_samples);
-        imag_sum /= static_cast<int64_t>(num_samples);
+        magnitudes[k] = magnitude_from_sums(real_sum, imag_sum, num_samples);
+    }
+}
+
+template <typename SampleT>
+void SpectralProcessor::compute_frame_spectra(
+    const SampleT* frames,
+    size_t num_frames,
+    fixed_t* magnitudes
+) {
+    size_t actual_bins = (num_bins_ < MAX_BINS) ? num_bins_ : MAX_BINS;
+    
+    // As compute_magnitude_spectrum(), with the twiddle shared by all axes
+    SG_OP_STAGE(SPECTRAL);
+    SG_COUNT_OPS(LOAD, actual_bins * num_frames * NUM_AXES);
+    SG_COUNT_OPS(MAC, 2 * actual_bins * num_frames * NUM_AXES);
+    SG_COUNT_OPS(ALU, actual_bins * (14 * num_frames + 8 * NUM_AXES));
+    SG_COUNT_OPS(BRANCH, actual_bins * (num_frames + 1));
+    SG_COUNT_OPS(DIVIDE, actual_bins * (1 + 2 * NUM_AXES));
+    SG_COUNT_OPS(STORE, actual_bins * NUM_AXES);
+    
+    for (size_t k = 0; k < actual_bins; ++k) {
+        // One accumulator lane per axis; the padding lane stays zero
+        int64_t real_sum[AXIS_LANES] = {0, 0, 0, 0};
+        int64_t imag_sum[AXIS_LANES] = {0, 0, 0, 0};
         
-        // Compute magnitude: sqrt(real² + imag²)
-        // Using approximation: |z| ≈ max(|Re|,|Im|) + 0.4*min(|Re|,|Im|)
-        int64_t abs_real = (real_sum >= 0) ? real_sum : -real_sum;
-        int64_t abs_imag = (imag_sum >= 0) ? imag_sum : -imag_sum;
+        uint32_t freq_mult = (k * 256) / num_bins_;
         
-        int64_t max_val = (abs_real > abs_imag) ? abs_real : abs_imag;
-        int64_t min_val = (abs_real < abs_imag) ? abs_real : abs_imag;
+        for (size_t n = 0; n < num_frames; ++n) {
+            uint32_t angle = (freq_mult * n) % 256;
+            
+            // Twiddle evaluated once, shared by all axes
+            fixed_t cos_val = fast_cos(angle);
+            fixed_t sin_val = fast_sin(angle);
+            
+            // Deinterleave on the fly
+            const SampleT* frame = frames + n * NUM_AXES;
+            for (size_t a = 0; a < NUM_AXES; ++a) {
+                int32_t sample = SampleTraits<SampleT>::to_acc(frame[a]);
+                real_sum[a] += static_cast<int64_t>(sample) * cos_val;
+                imag_sum[a] += static_cast<int64_t>(sample) * sin_val;
+            }
+        }
         
-        // Magnitude approximation
-        magnitudes[k] = static_cast<fixed_t>((max_val + (min_val * 4) / 10) >> FIXED_SHIFT);
+        for (size_t a = 0; a < NUM_AXES; ++a) {
+            magnitudes[a * actual_bins + k] = magnitude_from_sums(real_sum[a], imag_sum[a], num_frames);
+        }
+    }
+}
+
+void SpectralProcessor::compute_vector_magnitude(
+    const fixed_t* axis_magnitudes,
+    fixed_t* magnitudes
+) {
+    size_t actual_bins = (num_bins_ < MAX_BINS) ? num_bins_ : MAX_BINS;
+    
+    // isqrt64() runs up to 32 iterations of compare/subtract/shift
+    SG_OP_STAGE(SPECTRAL);
+    SG_COUNT_OPS(LOAD, actual_bins * NUM_AXES);
+    SG_COUNT_OPS(MAC, actual_bins * NUM_AXES);
+    SG_COUNT_OPS(ALU, actual_bins * 4 * 32);
+    SG_COUNT_OPS(BRANCH, actual_bins * (NUM_AXES + 32));
+    SG_COUNT_OPS(STORE, actual_bins);
+    
+    for (size_t k = 0; k < actual_bins; ++k) {
+        uint64_t energy = 0;
+        for (size_t a = 0; a < NUM_AXES; ++a) {
+            int64_t m = axis_magnitudes[a * actual_bins + k];
+            energy += static_cast<uint64_t>(m * m);
+        }
+        magnitudes[k] = static_cast<fixed_t>(isqrt64(energy));
     }
 }
 
@@ -91,6 +229,10 @@ uint8_t SpectralProcessor::find_peaks(
 ) {
     uint8_t peak_count = 0;
     
+    SG_OP_STAGE(SPECTRAL);
+    SG_COUNT_OPS(LOAD, (count > 2) ? 3 * (count - 2) : 0);
+    SG_COUNT_OPS(BRANCH, (count > 2) ? 4 * (count - 2) : 0);
+    
     for (size_t i = 1; i < count - 1; ++i) {
         // Check if this bin is a local maximum above threshold
         if (magnitudes[i] > threshold &&
@@ -110,6 +252,13 @@ fixed_t SpectralProcessor::compute_centroid(
     int64_t weighted_sum = 0;
     int64_t magnitude_sum = 0;
     
+    SG_OP_STAGE(SPECTRAL);
+    SG_COUNT_OPS(LOAD, count);
+    SG_COUNT_OPS(MAC, count);
+    SG_COUNT_OPS(ALU, count);
+    SG_COUNT_OPS(BRANCH, count);
+    SG_COUNT_OPS(DIVIDE, 1);
+    
     for (size_t i = 0; i < count; ++i) {
         weighted_sum += static_cast<int64_t>(magnitudes[i]) * static_cast<int64_t>(i);
         magnitude_sum += magnitudes[i];
@@ -123,7 +272,8 @@ fixed_t SpectralProcessor::compute_centroid(
     return static_cast<fixed_t>((weighted_sum * FIXED_ONE) / magnitude_sum);
 }
 
-SpectralResult SpectralProcessor::process(const int16_t* samples, size_t num_samples) {
+template <typename SampleT>
+SpectralResult SpectralProcessor::process(const SampleT* samples, size_t num_samples) {
     SpectralResult result;
     result.dominant_frequency = 0;
     result.peak_magnitude = 0;
@@ -135,18 +285,35 @@ SpectralResult SpectralProcessor::process(const int16_t* samples, size_t num_sam
     }
     
     // Allocate magnitude buffer (stack allocation for embedded)
-    constexpr size_t MAX_BINS = 128;
     fixed_t magnitudes[MAX_BINS];
     size_t actual_bins = (num_bins_ < MAX_BINS) ? num_bins_ : MAX_BINS;
     
     // Compute spectrum
     compute_magnitude_spectrum(samples, num_samples, magnitudes);
     
+    return analyze_spectrum(magnitudes, actual_bins);
+}
+
+SpectralResult SpectralProcessor::analyze_spectrum(const fixed_t* magnitudes, size_t count) {
+    SpectralResult result;
+    result.dominant_frequency = 0;
+    result.peak_magnitude = 0;
+    result.spectral_centroid = 0;
+    result.num_peaks = 0;
+    
+    // Peak search, dominant frequency (one divide), peak threshold
+    SG_OP_STAGE(SPECTRAL);
+    SG_COUNT_OPS(LOAD, count);
+    SG_COUNT_OPS(BRANCH, count);
+    SG_COUNT_OPS(ALU, count);
+    SG_COUNT_OPS(MAC, 3);
+    SG_COUNT_OPS(DIVIDE, 1);
+    
     // Find peak magnitude and dominant frequency bin
     fixed_t max_mag = 0;
     size_t max_bin = 0;
     
-    for (size_t i = 1; i < actual_bins; ++i) {  // Skip DC bin
+    for (size_t i = 1; i < count; ++i) {  // Skip DC bin
         if (magnitudes[i] > max_mag) {
             max_mag = magnitudes[i];
             max_bin = i;
@@ -159,21 +326,70 @@ SpectralResult SpectralProcessor::process(const int16_t* samples, size_t num_sam
     // freq = bin * sample_rate / (2 * num_bins)
     result.dominant_frequency = static_cast<fixed_t>(
         (static_cast<int64_t>(max_bin) * sample_rate_ * FIXED_ONE) / 
-        (2 * actual_bins)
+        (2 * count)
     );
     
     // Find peaks above 20% of max
     fixed_t peak_threshold = fixed_mul(max_mag, float_to_fixed(0.2f));
-    result.num_peaks = find_peaks(magnitudes, actual_bins, peak_threshold);
+    result.num_peaks = find_peaks(magnitudes, count, peak_threshold);
     
     // Compute spectral centroid
-    result.spectral_centroid = compute_centroid(magnitudes, actual_bins);
+    result.spectral_centroid = compute_centroid(magnitudes, count);
+    
+    return result;
+}
+
+template <typename SampleT>
+SpectralResult SpectralProcessor::process_with_features(
+    const SampleT* samples,
+    size_t num_samples,
+    fixed_t* features,
+    size_t max_features,
+    size_t* num_features
+) {
+    *num_features = 0;
+    
+    if (max_features < num_bins_ || num_samples == 0 || samples == nullptr) {
+        return process(samples, num_samples);
+    }
+    
+    size_t actual_bins = (num_bins_ < MAX_BINS) ? num_bins_ : MAX_BINS;
+    
+    // Analyze the raw spectrum, then normalize it in place as features
+    compute_magnitude_spectrum(samples, num_samples, features);
+    SpectralResult result = analyze_spectrum(features, actual_bins);
+    normalize_block(features, num_bins_);
     
+    *num_features = num_bins_;
     return result;
 }
 
+template <typename SampleT>
+MultiAxisResult SpectralProcessor::process_frames(const SampleT* frames, size_t num_frames) {
+    MultiAxisResult result = {};
+    
+    if (num_frames == 0 || frames == nullptr) {
+        return result;
+    }
+    
+    fixed_t axis_magnitudes[NUM_AXES * MAX_BINS];
+    fixed_t vector_magnitudes[MAX_BINS];
+    size_t actual_bins = (num_bins_ < MAX_BINS) ? num_bins_ : MAX_BINS;
+    
+    compute_frame_spectra(frames, num_frames, axis_magnitudes);
+    compute_vector_magnitude(axis_magnitudes, vector_magnitudes);
+    
+    for (size_t a = 0; a < NUM_AXES; ++a) {
+        result.axes[a] = analyze_spectrum(&axis_magnitudes[a * actual_bins], actual_bins);
+    }
+    result.vector_magnitude = analyze_spectrum(vector_magnitudes, actual_bins);
+    
+    return result;
+}
+
+template <typename SampleT>
 size_t SpectralProcessor::extract_features(
-    const int16_t* samples,
+    const SampleT* samples,
     size_t num_samples,
     fixed_t* features,
     size_t max_features
@@ -186,19 +402,51 @@ size_t SpectralProcessor::extract_features(
     compute_magnitude_spectrum(samples, num_samples, features);
     
     // Normalize features
-    fixed_t max_val = 0;
-    for (size_t i = 0; i < num_bins_; ++i) {
-        if (features[i] > max_val) max_val = features[i];
+    normalize_block(features, num_bins_);
+    
+    return num_bins_;
+}
+
+template <typename SampleT>
+size_t SpectralProcessor::extract_frame_features(
+    const SampleT* frames,
+    size_t num_frames,
+    fixed_t* features,
+    size_t max_features
+) {
+    constexpr size_t NUM_BLOCKS = NUM_AXES + 1;
+    
+    if (num_bins_ > MAX_BINS || max_features < NUM_BLOCKS * num_bins_) {
+        return 0;
     }
     
-    if (max_val > 0) {
-        for (size_t i = 0; i < num_bins_; ++i) {
-            features[i] = (static_cast<int64_t>(features[i]) * FIXED_ONE) / max_val;
-        }
+    // Per-axis spectra land directly in their feature blocks
+    compute_frame_spectra(frames, num_frames, features);
+    compute_vector_magnitude(features, &features[NUM_AXES * num_bins_]);
+    
+    for (size_t b = 0; b < NUM_BLOCKS; ++b) {
+        normalize_block(&features[b * num_bins_], num_bins_);
     }
     
-    return num_bins_;
+    return NUM_BLOCKS * num_bins_;
 }
 
+// Explicit instantiations for supported sample types. SampleTraits<int16_t>
+// is an identity conversion, so the int16 path compiles to the original loop.
+#define SPECTRAL_INSTANTIATE(SampleT) \
+    template void SpectralProcessor::compute_magnitude_spectrum<SampleT>(const SampleT*, size_t, fixed_t*); \
+    template SpectralResult SpectralProcessor::process<SampleT>(const SampleT*, size_t); \
+    template size_t SpectralProcessor::extract_features<SampleT>(const SampleT*, size_t, fixed_t*, size_t); \
+    template SpectralResult SpectralProcessor::process_with_features<SampleT>(const SampleT*, size_t, fixed_t*, size_t, size_t*); \
+    template MultiAxisResult SpectralProcessor::process_frames<SampleT>(const SampleT*, size_t); \
+    template size_t SpectralProcessor::extract_frame_features<SampleT>(const SampleT*, size_t, fixed_t*, size_t);
+
+SPECTRAL_INSTANTIATE(int16_t)
+SPECTRAL_INSTANTIATE(int24_t)
+SPECTRAL_INSTANTIATE(int32_t)
+SPECTRAL_INSTANTIATE(float)
+
+#undef SPECTRAL_INSTANTIATE
+
 } // namespace core
 } // namespace spectral_gate
@@ -9,6 +9,14 @@
 namespace spectral_gate {
 namespace core {
 
+/**
+ * @brief Spectral analysis result for a tri-axial window
+ */
+struct MultiAxisResult {
+    SpectralResult axes[hal::NUM_AXES];     // Per-axis spectral result (X, Y, Z)
+    SpectralResult vector_magnitude;        // Result over the combined |XYZ| spectrum
+};
+
 /**
  * @brief Spectral analysis processor
  * 
@@ -27,11 +35,17 @@ public:
 
     /**
      * @brief Process raw vibration data and extract spectral features
-     * @param samples Raw ADC samples (int16)
+     * 
+     * Instantiated for int16_t, hal::int24_t, int32_t and float samples.
+     * Magnitudes are in int16 counts for int16 input and in 24-bit counts
+     * for wider types (see hal::SampleTraits).
+     * 
+     * @param samples Raw ADC samples
      * @param num_samples Number of samples
      * @return Spectral analysis result
      */
-    SpectralResult process(const int16_t* samples, size_t num_samples);
+    template <typename SampleT>
+    SpectralResult process(const SampleT* samples, size_t num_samples);
 
     /**
      * @brief Extract feature vector for inference
@@ -41,34 +55,87 @@ public:
      * @param max_features Maximum features to extract
      * @return Number of features extracted
      */
+    template <typename SampleT>
     size_t extract_features(
-        const int16_t* samples,
+        const SampleT* samples,
         size_t num_samples,
         hal::fixed_t* features,
         size_t max_features
     );
 
     /**
-     * @brief Get number of frequency bins
+     * @brief Process a window and extract its feature vector in one pass
+     * 
+     * Equivalent to process() followed by extract_features(), but the
+     * magnitude spectrum is computed only once.
+     * 
+     * @param samples Raw ADC samples
+     * @param num_samples Number of samples
+     * @param features Output feature array (fixed-point)
+     * @param max_features Maximum features to extract
+     * @param num_features Receives number of features extracted (0 if
+     *                     max_features is too small)
+     * @return Spectral analysis result
      */
-    size_t get_num_bins() const { return num_bins_; }
+    template <typename SampleT>
+    SpectralResult process_with_features(
+        const SampleT* samples,
+        size_t num_samples,
+        hal::fixed_t* features,
+        size_t max_features,
+        size_t* num_features
+    );
+
+    /**
+     * @brief Process interleaved tri-axial frames
+     * 
+     * Axes are deinterleaved on the fly; each twiddle is evaluated once
+     * and applied to all axes. Per-axis results are identical to calling
+     * process() on each deinterleaved channel.
+     * 
+     * @param frames Interleaved X/Y/Z samples (num_frames * NUM_AXES)
+     * @param num_frames Number of frames
+     * @return Per-axis and vector-magnitude spectral results
+     */
+    template <typename SampleT>
+    MultiAxisResult process_frames(const SampleT* frames, size_t num_frames);
+
+    /**
+     * @brief Extract tri-axial feature vector for inference
+     * 
+     * Layout: [X bins][Y bins][Z bins][|XYZ| bins], each block normalized
+     * like extract_features().
+     * 
+     * @param frames Interleaved X/Y/Z samples (num_frames * NUM_AXES)
+     * @param num_frames Number of frames
+     * @param features Output feature array (fixed-point)
+     * @param max_features Maximum features to extract
+     * @return Number of features extracted ((NUM_AXES + 1) * num_bins)
+     */
+    template <typename SampleT>
+    size_t extract_frame_features(
+        const SampleT* frames,
+        size_t num_frames,
+        hal::fixed_t* features,
+        size_t max_features
+    );
 
-private:
-    size_t num_bins_;
-    uint32_t sample_rate_;
-    
     /**
      * @brief Compute magnitude spectrum using simplified DFT
-     * For embedded use, only computes select frequency bins
+     * For embedded use, only computes select frequency bins.
+     * Sample conversion is fused into the accumulation loop.
+     * @param magnitudes Output array of get_num_bins() entries
      */
+    template <typename SampleT>
     void compute_magnitude_spectrum(
-        const int16_t* samples,
+        const SampleT* samples,
         size_t num_samples,
         hal::fixed_t* magnitudes
     );
 
     /**
      * @brief Find peaks in magnitude spectrum
+     * @return Number of local maxima above threshold
      */
     uint8_t find_peaks(
         const hal::fixed_t* magnitudes,
@@ -83,6 +150,48 @@ private:
         const hal::fixed_t* magnitudes,
         size_t count
     );
+
+    /**
+     * @brief Get number of frequency bins
+     */
+    size_t get_num_bins() const { return num_bins_; }
+
+    /**
+     * @brief Get sample rate in Hz
+     */
+    uint32_t get_sample_rate() const { return sample_rate_; }
+
+private:
+    size_t num_bins_;
+    uint32_t sample_rate_;
+    
+    /**
+     * @brief Compute per-axis magnitude spectra from interleaved frames
+     * @param magnitudes Output array laid out as [NUM_AXES][bins]
+     */
+    template <typename SampleT>
+    void compute_frame_spectra(
+        const SampleT* frames,
+        size_t num_frames,
+        hal::fixed_t* magnitudes
+    );
+
+    /**
+     * @brief Combine per-axis spectra into a vector-magnitude spectrum
+     */
+    void compute_vector_magnitude(
+        const hal::fixed_t* axis_magnitudes,
+        hal::fixed_t* magnitudes
+    );
+
+    /**
+     * @brief Derive peak, dominant frequency, peaks and centroid
+     */
+    SpectralResult analyze_spectrum(
+        const hal::fixed_t* magnitudes,
+        size_t count
+    );
+
 };
 
 } // namespace core
@@ -0,0 +1,175 @@
+#include "trace.h"
+
+#if defined(SPECTRAL_GATE_TRACE)
+#include <atomic>
+#include <chrono>
+#endif
+
+namespace spectral_gate {
+namespace core {
+
+const char* trace_category_name(TraceCategory category) {
+    switch (category) {
+        case TraceCategory::STAGE:  return "stage";
+        case TraceCategory::QUEUE:  return "queue";
+        case TraceCategory::MODEL:  return "model";
+        case TraceCategory::WORKER: return "worker";
+    }
+    return "?";
+}
+
+#if defined(SPECTRAL_GATE_TRACE)
+
+namespace trace {
+
+namespace {
+    struct Ring {
+        TraceEvent events[RING_CAPACITY];
+        std::atomic<uint64_t> written;      // Total events ever written
+        std::atomic<const char*> name;
+        std::atomic<bool> in_use;           // Owned by a live thread
+        uint32_t tid;
+    };
+
+    std::atomic<bool> g_enabled{false};
+    std::atomic<Ring*> g_rings[MAX_THREADS];
+    std::atomic<uint32_t> g_next_ring{0};
+
+    // Constant-initialized: no TLS guard on the hot path
+    thread_local Ring* t_ring = nullptr;
+    thread_local bool t_ring_exhausted = false;
+
+    // Hands the ring back when its thread exits. Only touched on the slow
+    // path, so the TLS destructor registration stays off the hot path.
+    struct RingOwner {
+        Ring* ring = nullptr;
+        ~RingOwner() {
+            if (ring != nullptr) {
+                ring->in_use.store(false, std::memory_order_release);
+            }
+        }
+    };
+    thread_local RingOwner t_owner;
+
+    Ring* claim_ring() {
+        // A ring left by a finished thread first: short-lived workers
+        // (one set per parallel_for call) take over the same tracks
+        uint32_t allocated = g_next_ring.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < allocated && i < MAX_THREADS; ++i) {
+            Ring* ring = g_rings[i].load(std::memory_order_acquire);
+            bool expected = false;
+            if (ring != nullptr &&
+                ring->in_use.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                ring->name.store(nullptr, std::memory_order_relaxed);
+                return ring;
+            }
+        }
+
+        uint32_t index = g_next_ring.fetch_add(1, std::memory_order_acq_rel);
+        if (index >= MAX_THREADS) {
+            // Bounded memory: more than MAX_THREADS live threads are not traced
+            return nullptr;
+        }
+        // Rings outlive their threads so late exports still see them
+        Ring* ring = new Ring();
+        ring->tid = index + 1;
+        ring->in_use.store(true, std::memory_order_relaxed);
+        g_rings[index].store(ring, std::memory_order_release);
+        return ring;
+    }
+
+    Ring* ring_for_thread() {
+        if (t_ring != nullptr || t_ring_exhausted) {
+            return t_ring;
+        }
+        Ring* ring = claim_ring();
+        if (ring == nullptr) {
+            t_ring_exhausted = true;
+            return nullptr;
+        }
+        t_owner.ring = ring;
+        t_ring = ring;
+        return ring;
+    }
+
+    void append(const TraceEvent& event) {
+        Ring* ring = ring_for_thread();
+        if (ring == nullptr) {
+            return;
+        }
+        uint64_t n = ring->written.load(std::memory_order_relaxed);
+        ring->events[n % RING_CAPACITY] = event;
+        ring->written.store(n + 1, std::memory_order_release);
+    }
+}
+
+void set_enabled(bool enabled) {
+    g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool is_enabled() {
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+void set_thread_name(const char* name) {
+    // No ring is allocated for threads that never record
+    if (!is_enabled()) {
+        return;
+    }
+    Ring* ring = ring_for_thread();
+    if (ring != nullptr) {
+        ring->name.store(name, std::memory_order_relaxed);
+    }
+}
+
+uint64_t now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void record(TraceCategory category, const char* name, uint64_t start_ns, uint64_t duration_ns) {
+    append(TraceEvent{name, start_ns, duration_ns, category, false});
+}
+
+void record_instant(TraceCategory category, const char* name) {
+    append(TraceEvent{name, now_ns(), 0, category, true});
+}
+
+std::vector<ThreadTrace> snapshot() {
+    std::vector<ThreadTrace> threads;
+    for (size_t i = 0; i < MAX_THREADS; ++i) {
+        Ring* ring = g_rings[i].load(std::memory_order_acquire);
+        if (ring == nullptr) {
+            continue;
+        }
+
+        ThreadTrace t;
+        t.tid = ring->tid;
+        t.name = ring->name.load(std::memory_order_relaxed);
+        uint64_t written = ring->written.load(std::memory_order_acquire);
+        uint64_t kept = (written < RING_CAPACITY) ? written : RING_CAPACITY;
+        t.dropped = written - kept;
+        t.events.reserve(static_cast<size_t>(kept));
+        for (uint64_t n = written - kept; n < written; ++n) {
+            t.events.push_back(ring->events[n % RING_CAPACITY]);
+        }
+        threads.push_back(std::move(t));
+    }
+    return threads;
+}
+
+void clear() {
+    for (size_t i = 0; i < MAX_THREADS; ++i) {
+        Ring* ring = g_rings[i].load(std::memory_order_acquire);
+        if (ring != nullptr) {
+            ring->written.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+} // namespace trace
+
+#endif
+
+} // namespace core
+} // namespace spectral_gate
@@ -0,0 +1,155 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <cstdint>
+#include <cstddef>
+
+#if defined(SPECTRAL_GATE_TRACE)
+#include <vector>
+#endif
+
+namespace spectral_gate {
+namespace core {
+
+/**
+ * @brief Trace event categories (Chrome trace "cat" field)
+ */
+enum class TraceCategory : uint8_t {
+    STAGE = 0,      // Pipeline stages
+    QUEUE,          // Waiting on work or on other workers
+    MODEL,          // Model load / swap
+    WORKER          // Host worker chunks
+};
+
+const char* trace_category_name(TraceCategory category);
+
+/**
+ * @brief Execution trace recorder (host builds with SPECTRAL_GATE_TRACE)
+ *
+ * Every thread appends to its own fixed-size ring, so memory is bounded
+ * (RING_CAPACITY events per thread, MAX_THREADS live threads) and the
+ * oldest events are overwritten first. A thread's ring is released when
+ * it exits and reused, events and thread id included, by the next thread
+ * that records, so short-lived workers share tracks instead of running
+ * out of rings. Scopes are stored as complete events
+ * (begin timestamp + duration), which keeps begin/end pairs intact when
+ * the ring wraps. Recording is off until set_enabled(true); while off a
+ * probe costs one relaxed load. Without the define the macros expand to
+ * nothing.
+ *
+ * Export with host::write_chrome_trace() once workers have stopped.
+ */
+namespace trace {
+
+constexpr size_t RING_CAPACITY = 8192;
+constexpr size_t MAX_THREADS = 64;
+
+/**
+ * @brief One recorded event
+ */
+struct TraceEvent {
+    const char* name;           // Static string
+    uint64_t start_ns;          // steady_clock
+    uint64_t duration_ns;       // 0 for instant events
+    TraceCategory category;
+    bool instant;
+};
+
+#if defined(SPECTRAL_GATE_TRACE)
+constexpr bool COMPILED_IN = true;
+
+/**
+ * @brief Events recorded by one thread, oldest first
+ */
+struct ThreadTrace {
+    uint32_t tid;
+    const char* name;
+    std::vector<TraceEvent> events;
+    uint64_t dropped;           // Overwritten by ring wrap
+};
+
+/**
+ * @brief Start or stop recording (process-wide)
+ */
+void set_enabled(bool enabled);
+
+bool is_enabled();
+
+/**
+ * @brief Label the calling thread in the exported trace (no-op while
+ *        recording is off)
+ * @param name Static string
+ */
+void set_thread_name(const char* name);
+
+uint64_t now_ns();
+
+/**
+ * @brief Record a complete event for the calling thread
+ */
+void record(TraceCategory category, const char* name, uint64_t start_ns, uint64_t duration_ns);
+
+/**
+ * @brief Record an instant event for the calling thread
+ */
+void record_instant(TraceCategory category, const char* name);
+
+/**
+ * @brief Copy all rings (call while no thread is recording)
+ */
+std::vector<ThreadTrace> snapshot();
+
+/**
+ * @brief Drop all recorded events
+ */
+void clear();
+
+/**
+ * @brief Records the enclosing scope as one complete event
+ */
+class TraceScope {
+public:
+    TraceScope(TraceCategory category, const char* name)
+        : category_(category), name_(name), start_(is_enabled() ? now_ns() : 0) {}
+    ~TraceScope() {
+        if (start_ != 0) record(category_, name_, start_, now_ns() - start_);
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    TraceCategory category_;
+    const char* name_;
+    uint64_t start_;
+};
+#else
+constexpr bool COMPILED_IN = false;
+#endif
+
+} // namespace trace
+
+#if defined(SPECTRAL_GATE_TRACE)
+#define SG_TRACE_CONCAT_(a, b) a##b
+#define SG_TRACE_NAME_(line) SG_TRACE_CONCAT_(sg_trace_scope_, line)
+#define SG_TRACE_SCOPE(category, name) \
+    ::spectral_gate::core::trace::TraceScope SG_TRACE_NAME_(__LINE__)( \
+        ::spectral_gate::core::TraceCategory::category, name)
+#define SG_TRACE_INSTANT(category, name) \
+    do { \
+        if (::spectral_gate::core::trace::is_enabled()) { \
+            ::spectral_gate::core::trace::record_instant( \
+                ::spectral_gate::core::TraceCategory::category, name); \
+        } \
+    } while (0)
+#define SG_TRACE_THREAD_NAME(name) ::spectral_gate::core::trace::set_thread_name(name)
+#else
+#define SG_TRACE_SCOPE(category, name) ((void)0)
+#define SG_TRACE_INSTANT(category, name) ((void)0)
+#define SG_TRACE_THREAD_NAME(name) ((void)0)
+#endif
+
+} // namespace core
+} // namespace spectral_gate
+
+#endif // TRACE_H
@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <cstddef>
+#include "sample_types.h"
 
 namespace spectral_gate {
 namespace hal {
@@ -31,6 +32,15 @@ inline fixed_t fixed_mul(fixed_t a, fixed_t b) {
 constexpr size_t VIBRATION_BUFFER_SIZE = 256;
 constexpr size_t NUM_SPECTRAL_BINS = 64;
 
+// Tri-axial MEMS sensors deliver interleaved X/Y/Z frames
+constexpr size_t NUM_AXES = 3;
+
+// Retained-RAM area reserved for the decision event ring (SRAM2 on target)
+constexpr size_t EVENT_RING_AREA_BYTES = 2048;
+
+// Largest radio frame payload (LoRa, EU868 DR5)
+constexpr size_t MAX_FRAME_BYTES = 222;
+
 // Battery voltage thresholds (in millivolts)
 constexpr uint16_t BATTERY_CRITICAL_MV = 3000;
 constexpr uint16_t BATTERY_LOW_MV = 3300;
@@ -55,6 +65,26 @@ public:
      */
     virtual size_t read_vibration_data(int16_t* buffer, size_t buffer_size) = 0;
 
+    /**
+     * @brief Read vibration data at full ADC resolution
+     * @param buffer Pointer to buffer for storing sign-extended 24-bit samples
+     * @param buffer_size Size of buffer in samples
+     * @return Number of samples actually read
+     */
+    virtual size_t read_vibration_data_wide(int32_t* buffer, size_t buffer_size) = 0;
+
+    /**
+     * @brief Read interleaved tri-axial vibration frames
+     * 
+     * Each frame holds NUM_AXES consecutive samples (X, Y, Z), matching
+     * the register burst order of tri-axial MEMS accelerometers.
+     * 
+     * @param frames Buffer of at least num_frames * NUM_AXES samples
+     * @param num_frames Number of frames requested
+     * @return Number of frames actually read
+     */
+    virtual size_t read_vibration_frames(int16_t* frames, size_t num_frames) = 0;
+
     /**
      * @brief Get current battery voltage
      * @return Battery voltage in millivolts
@@ -81,6 +111,32 @@ public:
      */
     virtual bool transmit_alert(uint8_t alert_type, uint8_t confidence) = 0;
 
+    /**
+     * @brief Transmit a pre-built radio frame
+     * @param frame Frame bytes (at most MAX_FRAME_BYTES)
+     * @param length Frame length in bytes
+     * @return true if transmission successful
+     */
+    virtual bool transmit_frame(const uint8_t* frame, size_t length) = 0;
+
+    /**
+     * @brief Append an encoded event batch to the on-board flash log
+     * @param batch Batch bytes
+     * @param length Batch length in bytes
+     * @return true if the batch was written
+     */
+    virtual bool store_event_batch(const uint8_t* batch, size_t length) = 0;
+
+    /**
+     * @brief Retained memory for the decision event ring
+     * 
+     * Survives sleep and warm resets, so events recorded between
+     * transmissions are not lost. 4-byte aligned.
+     * 
+     * @return EVENT_RING_AREA_BYTES bytes of storage
+     */
+    virtual uint8_t* get_event_ring_area() = 0;
+
     /**
      * @brief Check if external interrupt (wake) occurred
      * @return true if wake event pending
@@ -93,6 +149,69 @@ public:
     virtual void clear_wake_event() = 0;
 };
 
+/**
+ * @brief Fixed-capacity acquisition buffer templated on sample type
+ */
+template <typename SampleT, size_t Capacity>
+struct AcquisitionBuffer {
+    SampleT samples[Capacity];
+    size_t count = 0;
+
+    static constexpr size_t capacity() { return Capacity; }
+};
+
+// Per-type acquisition: int16 and int32 map straight onto the HAL, packed
+// int24 and float are converted from wide reads in small stack chunks
+inline size_t acquire_samples(IHardwareAbstraction& hw, int16_t* out, size_t n) {
+    return hw.read_vibration_data(out, n);
+}
+
+inline size_t acquire_samples(IHardwareAbstraction& hw, int32_t* out, size_t n) {
+    return hw.read_vibration_data_wide(out, n);
+}
+
+inline size_t acquire_samples(IHardwareAbstraction& hw, int24_t* out, size_t n) {
+    constexpr size_t CHUNK = 32;
+    int32_t wide[CHUNK];
+    size_t total = 0;
+    while (total < n) {
+        size_t want = (n - total < CHUNK) ? (n - total) : CHUNK;
+        size_t got = hw.read_vibration_data_wide(wide, want);
+        for (size_t i = 0; i < got; ++i) {
+            out[total + i] = int24_t::from_int32(wide[i]);
+        }
+        total += got;
+        if (got < want) break;
+    }
+    return total;
+}
+
+inline size_t acquire_samples(IHardwareAbstraction& hw, float* out, size_t n) {
+    constexpr size_t CHUNK = 32;
+    int32_t wide[CHUNK];
+    size_t total = 0;
+    while (total < n) {
+        size_t want = (n - total < CHUNK) ? (n - total) : CHUNK;
+        size_t got = hw.read_vibration_data_wide(wide, want);
+        for (size_t i = 0; i < got; ++i) {
+            out[total + i] = static_cast<float>(wide[i]) / 8388608.0f;
+        }
+        total += got;
+        if (got < want) break;
+    }
+    return total;
+}
+
+/**
+ * @brief Fill an acquisition buffer from the HAL
+ * @return Number of samples acquired
+ */
+template <typename SampleT, size_t Capacity>
+size_t acquire(IHardwareAbstraction& hw, AcquisitionBuffer<SampleT, Capacity>& buffer) {
+    buffer.count = acquire_samples(hw, buffer.samples, Capacity);
+    return buffer.count;
+}
+
 } // namespace hal
 } // namespace spectral_gate
 
@@ -16,6 +16,10 @@ MockHAL::MockHAL()
       transmit_count_(0),
       total_sleep_ms_(0),
       sample_phase_(0),
+      virtual_clock_(false),
+      virtual_time_ms_(0),
+      verbose_(true),
+      event_ring_area_{},
       rng_(std::random_device{}()),
       start_time_(std::chrono::steady_clock::now())
 {
@@ -31,6 +35,10 @@ MockHAL::MockHAL(uint16_t initial_battery_mv)
       transmit_count_(0),
       total_sleep_ms_(0),
       sample_phase_(0),
+      virtual_clock_(false),
+      virtual_time_ms_(0),
+      verbose_(true),
+      event_ring_area_{},
       rng_(std::random_device{}()),
       start_time_(std::chrono::steady_clock::now())
 {
@@ -81,36 +89,82 @@ int16_t MockHAL::generate_anomaly() {
     return signal;
 }
 
+int16_t MockHAL::generate_sample() {
+    switch (vibration_pattern_) {
+        case 0:  // Pure noise
+            return generate_noise();
+        case 1:  // Sinusoidal
+            return generate_sinusoid();
+        case 2:  // Anomaly pattern
+            return generate_anomaly();
+        default:
+            return generate_noise();
+    }
+}
+
 size_t MockHAL::read_vibration_data(int16_t* buffer, size_t buffer_size) {
     if (buffer == nullptr || buffer_size == 0) {
         return 0;
     }
     
     for (size_t i = 0; i < buffer_size; ++i) {
-        switch (vibration_pattern_) {
-            case 0:  // Pure noise
-                buffer[i] = generate_noise();
-                break;
-            case 1:  // Sinusoidal
-                buffer[i] = generate_sinusoid();
-                break;
-            case 2:  // Anomaly pattern
-                buffer[i] = generate_anomaly();
-                break;
-            default:
-                buffer[i] = generate_noise();
-                break;
-        }
+        buffer[i] = generate_sample();
+    }
+    
+    return buffer_size;
+}
+
+size_t MockHAL::read_vibration_data_wide(int32_t* buffer, size_t buffer_size) {
+    if (buffer == nullptr || buffer_size == 0) {
+        return 0;
+    }
+    
+    // Emulate a 24-bit ADC: pattern in the top 16 bits plus sub-LSB noise
+    std::uniform_int_distribution<int32_t> lsb_dist(-128, 127);
+    
+    for (size_t i = 0; i < buffer_size; ++i) {
+        buffer[i] = static_cast<int32_t>(generate_sample()) * 256 + lsb_dist(rng_);
     }
     
     return buffer_size;
 }
 
+size_t MockHAL::read_vibration_frames(int16_t* frames, size_t num_frames) {
+    if (frames == nullptr || num_frames == 0) {
+        return 0;
+    }
+    
+    // Simulate a tri-axial mount: X carries the full pattern, Y sees a
+    // weaker coupled copy, Z sits on the 1g gravity offset
+    constexpr int32_t GRAVITY_COUNTS = 4096;  // 1g at +/-8g full scale
+    
+    for (size_t i = 0; i < num_frames; ++i) {
+        int32_t base = generate_sample();
+        int32_t axis[NUM_AXES] = {
+            base,
+            base / 2 + generate_noise(),
+            GRAVITY_COUNTS + (base * 3) / 10 + generate_noise()
+        };
+        
+        for (size_t a = 0; a < NUM_AXES; ++a) {
+            int32_t v = axis[a];
+            if (v > INT16_MAX) v = INT16_MAX;
+            if (v < INT16_MIN) v = INT16_MIN;
+            frames[i * NUM_AXES + a] = static_cast<int16_t>(v);
+        }
+    }
+    
+    return num_frames;
+}
+
 uint16_t MockHAL::get_battery_voltage_mv() {
     return battery_voltage_mv_;
 }
 
 uint32_t MockHAL::get_tick_ms() {
+    if (virtual_clock_) {
+        return virtual_time_ms_;
+    }
     auto now = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - start_time_);
     return static_cast<uint32_t>(duration.count());
@@ -119,8 +173,12 @@ uint32_t MockHAL::get_tick_ms() {
 void MockHAL::enter_sleep(uint32_t duration_ms) {
     total_sleep_ms_ += duration_ms;
     
-    // Simulate actual sleep (scaled down for simulation speed)
-    std::this_thread::sleep_for(std::chrono::milliseconds(duration_ms / 100));
+    if (virtual_clock_) {
+        virtual_time_ms_ += duration_ms;
+    } else {
+        // Simulate actual sleep (scaled down for simulation speed)
+        std::this_thread::sleep_for(std::chrono::milliseconds(duration_ms / 100));
+    }
     
     // Simulate battery drain during sleep (very slow)
     if (battery_voltage_mv_ > 2800) {
@@ -131,10 +189,12 @@ void MockHAL::enter_sleep(uint32_t duration_ms) {
 bool MockHAL::transmit_alert(uint8_t alert_type, uint8_t confidence) {
     ++transmit_count_;
     
-    std::cout << "[TX] Alert Type: " << (alert_type == 1 ? "CONFIRMED" : "UNCERTAIN")
-              << ", Confidence: " << static_cast<int>(confidence) << "%"
-              << ", Battery: " << battery_voltage_mv_ << "mV"
-              << std::endl;
+    if (verbose_) {
+        std::cout << "[TX] Alert Type: " << (alert_type == 1 ? "CONFIRMED" : "UNCERTAIN")
+                  << ", Confidence: " << static_cast<int>(confidence) << "%"
+                  << ", Battery: " << battery_voltage_mv_ << "mV"
+                  << std::endl;
+    }
     
     // Simulate transmission power consumption
     if (battery_voltage_mv_ > 2900) {
@@ -144,6 +204,35 @@ bool MockHAL::transmit_alert(uint8_t alert_type, uint8_t confidence) {
     return true;
 }
 
+bool MockHAL::transmit_frame(const uint8_t* frame, size_t length) {
+    if (frame == nullptr || length == 0 || length > MAX_FRAME_BYTES) {
+        return false;
+    }
+    ++transmit_count_;
+    frames_.emplace_back(frame, frame + length);
+    
+    if (verbose_) {
+        std::cout << "[TX] Frame: " << length << " bytes"
+                  << ", Battery: " << battery_voltage_mv_ << "mV"
+                  << std::endl;
+    }
+    
+    // Same airtime budget as transmit_alert()
+    if (battery_voltage_mv_ > 2900) {
+        battery_voltage_mv_ -= 10;
+    }
+    
+    return true;
+}
+
+bool MockHAL::store_event_batch(const uint8_t* batch, size_t length) {
+    if (batch == nullptr || length == 0) {
+        return false;
+    }
+    flash_log_.insert(flash_log_.end(), batch, batch + length);
+    return true;
+}
+
 bool MockHAL::is_wake_event_pending() {
     return wake_event_pending_;
 }
@@ -173,6 +262,16 @@ void MockHAL::set_noise_level(int16_t level) {
     noise_level_ = level;
 }
 
+void MockHAL::set_seed(uint32_t seed) {
+    rng_.seed(seed);
+    sample_phase_ = 0;
+}
+
+void MockHAL::set_virtual_clock(bool enabled) {
+    virtual_clock_ = enabled;
+    virtual_time_ms_ = 0;
+}
+
 void MockHAL::trigger_wake_event() {
     wake_event_pending_ = true;
 }
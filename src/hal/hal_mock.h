@@ -4,6 +4,7 @@
 #include "hal_interface.h"
 #include <random>
 #include <chrono>
+#include <vector>
 
 namespace spectral_gate {
 namespace hal {
@@ -30,10 +31,15 @@ public:
 
     // IHardwareAbstraction interface implementation
     size_t read_vibration_data(int16_t* buffer, size_t buffer_size) override;
+    size_t read_vibration_data_wide(int32_t* buffer, size_t buffer_size) override;
+    size_t read_vibration_frames(int16_t* frames, size_t num_frames) override;
     uint16_t get_battery_voltage_mv() override;
     uint32_t get_tick_ms() override;
     void enter_sleep(uint32_t duration_ms) override;
     bool transmit_alert(uint8_t alert_type, uint8_t confidence) override;
+    bool transmit_frame(const uint8_t* frame, size_t length) override;
+    bool store_event_batch(const uint8_t* batch, size_t length) override;
+    uint8_t* get_event_ring_area() override { return event_ring_area_; }
     bool is_wake_event_pending() override;
     void clear_wake_event() override;
 
@@ -69,6 +75,31 @@ public:
      */
     void set_noise_level(int16_t level);
 
+    /**
+     * @brief Reseed the noise generator and restart the signal phase, so
+     *        generated data is reproducible
+     * @param seed Generator seed
+     */
+    void set_seed(uint32_t seed);
+
+    /**
+     * @brief Drive get_tick_ms() from a simulated clock instead of the
+     *        wall clock
+     * 
+     * The virtual clock starts at 0 and only enter_sleep() advances it,
+     * without actually sleeping, so a day of node time runs in
+     * microseconds.
+     * 
+     * @param enabled true to use the virtual clock
+     */
+    void set_virtual_clock(bool enabled);
+
+    /**
+     * @brief Enable or disable the "[TX] ..." console lines
+     * @param verbose true to print transmissions (default)
+     */
+    void set_verbose(bool verbose) { verbose_ = verbose; }
+
     /**
      * @brief Trigger a wake event
      */
@@ -84,6 +115,16 @@ public:
      */
     uint32_t get_total_sleep_ms() const { return total_sleep_ms_; }
 
+    /**
+     * @brief Frames passed to transmit_frame(), in order
+     */
+    const std::vector<std::vector<uint8_t>>& get_transmitted_frames() const { return frames_; }
+
+    /**
+     * @brief Simulated flash log: every stored event batch, concatenated
+     */
+    const std::vector<uint8_t>& get_flash_log() const { return flash_log_; }
+
 private:
     uint16_t battery_voltage_mv_;
     uint8_t vibration_pattern_;
@@ -94,10 +135,21 @@ private:
     uint32_t transmit_count_;
     uint32_t total_sleep_ms_;
     uint32_t sample_phase_;
+    bool virtual_clock_;
+    uint32_t virtual_time_ms_;
+    bool verbose_;
+    std::vector<std::vector<uint8_t>> frames_;
+    std::vector<uint8_t> flash_log_;
+    alignas(4) uint8_t event_ring_area_[EVENT_RING_AREA_BYTES];
     
     std::mt19937 rng_;
     std::chrono::steady_clock::time_point start_time_;
 
+    /**
+     * @brief Generate one sample of the configured vibration pattern
+     */
+    int16_t generate_sample();
+
     /**
      * @brief Generate noise sample
      */
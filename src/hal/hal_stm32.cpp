@@ -27,6 +27,24 @@ extern RTC_HandleTypeDef hrtc;
 static int16_t g_vibration_dma_buffer[VIBRATION_BUFFER_SIZE * 2] __attribute__((section(".RAM2")));
 static volatile bool g_wake_event_pending = false;
 
+// Decision event ring (core::EventRing), retained across STOP 2 and warm resets
+alignas(4) static uint8_t g_event_ring_area[EVENT_RING_AREA_BYTES] __attribute__((section(".RAM2")));
+
+// Event log: last two 8 KB pages of bank 2 (126, 127) used alternately,
+// written in 128-bit quad-words
+constexpr uint32_t EVENT_LOG_ADDRESS = 0x081FC000;
+constexpr uint32_t EVENT_LOG_FIRST_PAGE = 126;
+constexpr uint32_t EVENT_LOG_PAGES = 2;
+constexpr uint32_t EVENT_LOG_PAGE_BYTES = 8192;
+// Batch header as written by core::spill_events() (core::EVENT_BATCH_TAG;
+// the HAL does not include core): u8 tag, u8 count, u32 first sequence
+constexpr uint8_t EVENT_LOG_BATCH_TAG = 0xE1;
+constexpr uint32_t FLASH_QUADWORD_BYTES = 16;
+// Write position (page * EVENT_LOG_PAGE_BYTES + offset in page) and its
+// complement; SRAM2 is not initialised on cold boot
+static uint32_t g_event_log_offset __attribute__((section(".RAM2")));
+static uint32_t g_event_log_offset_inv __attribute__((section(".RAM2")));
+
 /**
  * @brief STM32U585 HAL Implementation
  * 
@@ -86,6 +104,64 @@ public:
         return samples_to_copy;
     }
 
+    /**
+     * @brief Read full-resolution samples from a 24-bit ADC front-end
+     *
+     * 24-bit sensors deliver 3-byte words over SPI; the DMA handler
+     * sign-extends them into int32 so the core never sees a truncated
+     * int16 value.
+     *
+     * @param buffer Destination buffer for sign-extended 24-bit samples
+     * @param buffer_size Maximum number of samples to read
+     * @return Number of samples actually copied
+     */
+    size_t read_vibration_data_wide(int32_t* buffer, size_t buffer_size) override {
+        if (buffer == nullptr || buffer_size == 0) {
+            return 0;
+        }
+
+        size_t samples_to_copy = (buffer_size < VIBRATION_BUFFER_SIZE)
+                                  ? buffer_size
+                                  : VIBRATION_BUFFER_SIZE;
+
+        // TODO: Read from the 24-bit ADC DMA buffer when hardware is available
+        for (size_t i = 0; i < samples_to_copy; ++i) {
+            buffer[i] = 0;
+        }
+
+        return samples_to_copy;
+    }
+
+    /**
+     * @brief Read interleaved X/Y/Z frames from MEMS sensor
+     *
+     * The LIS2DW12 exposes OUT_X_L..OUT_Z_H as six consecutive registers,
+     * so a single auto-increment burst per sample period lands one
+     * interleaved X/Y/Z frame in the DMA buffer. Frames are copied as-is;
+     * deinterleaving happens inside the spectral stage.
+     *
+     * @param frames Destination buffer (num_frames * NUM_AXES samples)
+     * @param num_frames Maximum number of frames to read
+     * @return Number of frames actually copied
+     */
+    size_t read_vibration_frames(int16_t* frames, size_t num_frames) override {
+        if (frames == nullptr || num_frames == 0) {
+            return 0;
+        }
+
+        // Half of the circular buffer holds VIBRATION_BUFFER_SIZE samples
+        constexpr size_t MAX_FRAMES = VIBRATION_BUFFER_SIZE / NUM_AXES;
+        size_t frames_to_copy = (num_frames < MAX_FRAMES) ? num_frames : MAX_FRAMES;
+
+        // TODO: Copy from inactive half of g_vibration_dma_buffer once the
+        // LPDMA descriptor is switched to 6-byte XYZ bursts
+        for (size_t i = 0; i < frames_to_copy * NUM_AXES; ++i) {
+            frames[i] = 0;
+        }
+
+        return frames_to_copy;
+    }
+
     /**
      * @brief Read battery voltage using internal VREFINT
      * 
@@ -245,6 +321,87 @@ public:
         return true;
     }
 
+    /**
+     * @brief Transmit a pre-built frame (alert plus piggybacked events)
+     */
+    bool transmit_frame(const uint8_t* frame, size_t length) override {
+        if (frame == nullptr || length == 0 || length > MAX_FRAME_BYTES) {
+            return false;
+        }
+
+        // TODO: transmit via radio peripheral, as in transmit_alert()
+        // For LoRa: SX126x_Transmit(frame, length);
+        return true;
+    }
+
+    /**
+     * @brief Append an event batch to the flash event log
+     * 
+     * The batch is padded with 0xFF (erased-flash value, skipped by the
+     * host decoder) to whole quad-words. The write position lives in
+     * SRAM2; if it is lost it is recovered from flash (see
+     * find_event_log_position()). The log ping-pongs between two pages: when a batch does not fit in
+     * the current page, the other page is erased and writing continues
+     * there. The page just filled stays intact, so flash always holds at
+     * least one full page of the most recent history.
+     */
+    bool store_event_batch(const uint8_t* batch, size_t length) override {
+        if (batch == nullptr || length == 0 || length > EVENT_LOG_PAGE_BYTES) {
+            return false;
+        }
+        size_t padded = (length + FLASH_QUADWORD_BYTES - 1) & ~(FLASH_QUADWORD_BYTES - 1);
+
+        if (g_event_log_offset_inv != ~g_event_log_offset ||
+            g_event_log_offset > EVENT_LOG_PAGES * EVENT_LOG_PAGE_BYTES ||
+            (g_event_log_offset % FLASH_QUADWORD_BYTES) != 0) {
+            g_event_log_offset = find_event_log_position();
+        }
+
+        // A position at the end of a page still belongs to that page
+        uint32_t page = (g_event_log_offset == 0) ? 0 : (g_event_log_offset - 1) / EVENT_LOG_PAGE_BYTES;
+        uint32_t in_page = g_event_log_offset - page * EVENT_LOG_PAGE_BYTES;
+
+        HAL_FLASH_Unlock();
+        if (in_page + padded > EVENT_LOG_PAGE_BYTES) {
+            // Switch pages; only the older page is erased
+            page = (page + 1) % EVENT_LOG_PAGES;
+            in_page = 0;
+            FLASH_EraseInitTypeDef erase = {};
+            erase.TypeErase = FLASH_TYPEERASE_PAGES;
+            erase.Banks = FLASH_BANK_2;
+            erase.Page = EVENT_LOG_FIRST_PAGE + page;
+            erase.NbPages = 1;
+            uint32_t page_error = 0;
+            if (HAL_FLASHEx_Erase(&erase, &page_error) != HAL_OK) {
+                HAL_FLASH_Lock();
+                return false;
+            }
+            g_event_log_offset = page * EVENT_LOG_PAGE_BYTES;
+            g_event_log_offset_inv = ~g_event_log_offset;
+        }
+
+        bool ok = true;
+        for (size_t offset = 0; ok && offset < padded; offset += FLASH_QUADWORD_BYTES) {
+            alignas(4) uint8_t quad[FLASH_QUADWORD_BYTES];
+            for (size_t i = 0; i < FLASH_QUADWORD_BYTES; ++i) {
+                quad[i] = (offset + i < length) ? batch[offset + i] : 0xFF;
+            }
+            ok = HAL_FLASH_Program(FLASH_TYPEPROGRAM_QUADWORD,
+                                   EVENT_LOG_ADDRESS + g_event_log_offset,
+                                   reinterpret_cast<uint32_t>(quad)) == HAL_OK;
+            if (ok) {
+                g_event_log_offset += FLASH_QUADWORD_BYTES;
+            }
+        }
+        HAL_FLASH_Lock();
+        g_event_log_offset_inv = ~g_event_log_offset;
+        return ok;
+    }
+
+    uint8_t* get_event_ring_area() override {
+        return g_event_ring_area;
+    }
+
     /**
      * @brief Check for pending wake event
      * @return true if external interrupt or sensor threshold triggered
@@ -259,6 +416,60 @@ public:
     void clear_wake_event() override {
         g_wake_event_pending = false;
     }
+
+private:
+    /**
+     * @brief Offset of the first fully erased quad-word in an event log page
+     */
+    static uint32_t find_page_end(uint32_t page) {
+        const uint32_t* words = reinterpret_cast<const uint32_t*>(
+            EVENT_LOG_ADDRESS + page * EVENT_LOG_PAGE_BYTES);
+        for (uint32_t offset = 0; offset < EVENT_LOG_PAGE_BYTES; offset += FLASH_QUADWORD_BYTES) {
+            const uint32_t* quad = &words[offset / 4];
+            if (quad[0] == 0xFFFFFFFF && quad[1] == 0xFFFFFFFF &&
+                quad[2] == 0xFFFFFFFF && quad[3] == 0xFFFFFFFF) {
+                return offset;
+            }
+        }
+        return EVENT_LOG_PAGE_BYTES;
+    }
+
+    /**
+     * @brief Sequence number of the first record on an event log page
+     * @return false if the page does not start with a batch (erased)
+     */
+    static bool read_first_sequence(uint32_t page, uint32_t* sequence) {
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(
+            EVENT_LOG_ADDRESS + page * EVENT_LOG_PAGE_BYTES);
+        if (p[0] != EVENT_LOG_BATCH_TAG) {
+            return false;
+        }
+        *sequence = static_cast<uint32_t>(p[2]) | (static_cast<uint32_t>(p[3]) << 8) |
+                    (static_cast<uint32_t>(p[4]) << 16) | (static_cast<uint32_t>(p[5]) << 24);
+        return true;
+    }
+
+    /**
+     * @brief Recover the write position from flash
+     * 
+     * Both pages are usually partly written (batches are padded and a page
+     * is left as soon as the next batch does not fit), so the current page
+     * is the one whose first batch has the newer sequence number. Writing
+     * resumes at its erased tail; a full current page makes the next batch
+     * move on to the other page.
+     */
+    static uint32_t find_event_log_position() {
+        uint32_t sequence0 = 0;
+        uint32_t sequence1 = 0;
+        bool used0 = read_first_sequence(0, &sequence0);
+        bool used1 = read_first_sequence(1, &sequence1);
+        uint32_t page = used1 ? 1 : 0;
+        if (used0 && used1) {
+            // Serial-number comparison, so the u32 wrap is harmless
+            page = (static_cast<int32_t>(sequence1 - sequence0) > 0) ? 1 : 0;
+        }
+        return page * EVENT_LOG_PAGE_BYTES + find_page_end(page);
+    }
 };
 
 // External interrupt callback for accelerometer INT pin
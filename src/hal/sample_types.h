@@ -0,0 +1,90 @@
+#ifndef SAMPLE_TYPES_H
+#define SAMPLE_TYPES_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+namespace spectral_gate {
+namespace hal {
+
+/**
+ * @brief Packed 24-bit signed sample (little-endian)
+ *
+ * Layout matches the 3-byte words delivered by 24-bit sigma-delta ADCs,
+ * so DMA buffers can be consumed without repacking.
+ */
+struct int24_t {
+    uint8_t bytes[3];
+
+    static int24_t from_int32(int32_t value) {
+        int24_t s;
+        s.bytes[0] = static_cast<uint8_t>(value & 0xFF);
+        s.bytes[1] = static_cast<uint8_t>((value >> 8) & 0xFF);
+        s.bytes[2] = static_cast<uint8_t>((value >> 16) & 0xFF);
+        return s;
+    }
+
+    int32_t to_int32() const {
+        uint32_t raw = static_cast<uint32_t>(bytes[0]) |
+                       (static_cast<uint32_t>(bytes[1]) << 8) |
+                       (static_cast<uint32_t>(bytes[2]) << 16);
+        // Sign-extend bit 23
+        return static_cast<int32_t>(raw << 8) >> 8;
+    }
+};
+
+static_assert(sizeof(int24_t) == 3, "int24_t must be tightly packed");
+
+/**
+ * @brief Per-sample-type conversion into the spectral accumulator domain
+ *
+ * to_acc() is fused into the first transform pass. int16 passes through
+ * unchanged (magnitudes in int16 counts); wider types land in a 24-bit
+ * range so a window of up to 2^24 samples cannot overflow the int64 DFT
+ * accumulators. int32 holds sign-extended 24-bit samples, as
+ * read_vibration_data_wide() delivers them.
+ */
+template <typename SampleT>
+struct SampleTraits;
+
+template <>
+struct SampleTraits<int16_t> {
+    static constexpr int RESOLUTION_BITS = 16;
+    static int32_t to_acc(int16_t s) { return s; }
+};
+
+template <>
+struct SampleTraits<int24_t> {
+    static constexpr int RESOLUTION_BITS = 24;
+    static int32_t to_acc(int24_t s) { return s.to_int32(); }
+};
+
+template <>
+struct SampleTraits<int32_t> {
+    static constexpr int RESOLUTION_BITS = 24;
+    static int32_t to_acc(int32_t s) {
+        // Already 24-bit; clamp stray wider values like float does
+        if (s > 8388607) return 8388607;
+        if (s < -8388607) return -8388607;
+        return s;
+    }
+};
+
+template <>
+struct SampleTraits<float> {
+    static constexpr int RESOLUTION_BITS = 24;
+    static int32_t to_acc(float s) {
+        // Full scale +/-1.0 maps onto the 24-bit range; NaN (a dropped
+        // or corrupt sample) reads as silence
+        if (std::isnan(s)) return 0;
+        if (s >= 1.0f) return 8388607;
+        if (s <= -1.0f) return -8388607;
+        return static_cast<int32_t>(s * 8388607.0f);
+    }
+};
+
+} // namespace hal
+} // namespace spectral_gate
+
+#endif // SAMPLE_TYPES_H
@@ -0,0 +1,87 @@
+#include "cycle_model.h"
+#include <cstdlib>
+#include <fstream>
+
+namespace spectral_gate {
+namespace host {
+
+using core::OpClass;
+
+CycleCostTable get_default_m33_cost_table() {
+    CycleCostTable table;
+    table.cycles_per_op[static_cast<size_t>(OpClass::MAC)] = 1.0;
+    table.cycles_per_op[static_cast<size_t>(OpClass::LOAD)] = 2.0;
+    table.cycles_per_op[static_cast<size_t>(OpClass::STORE)] = 1.0;
+    table.cycles_per_op[static_cast<size_t>(OpClass::BRANCH)] = 2.0;
+    table.cycles_per_op[static_cast<size_t>(OpClass::DIVIDE)] = 40.0;
+    table.cycles_per_op[static_cast<size_t>(OpClass::ALU)] = 1.0;
+    table.stall_factor = 1.1;           // ICACHE hit rate ~90% at 4 flash wait states
+    table.clock_hz = 160e6;
+    table.active_current_ma = 15.0;
+    table.supply_v = 3.0;
+    return table;
+}
+
+bool load_cost_table(const std::string& path, CycleCostTable* table) {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t start = line.find_first_not_of(" \t");
+        if (start == std::string::npos || line[start] == '#') {
+            continue;
+        }
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) {
+            return false;
+        }
+
+        std::string key = line.substr(start, eq - start);
+        key.erase(key.find_last_not_of(" \t") + 1);
+        double value = std::strtod(line.c_str() + eq + 1, nullptr);
+
+        bool matched = false;
+        for (size_t i = 0; i < core::NUM_OP_CLASSES; ++i) {
+            if (key == core::op_class_name(static_cast<OpClass>(i))) {
+                table->cycles_per_op[i] = value;
+                matched = true;
+            }
+        }
+        if (key == "stall_factor") {
+            table->stall_factor = value;
+        } else if (key == "clock_hz") {
+            table->clock_hz = value;
+        } else if (key == "active_current_ma") {
+            table->active_current_ma = value;
+        } else if (key == "supply_v") {
+            table->supply_v = value;
+        } else if (!matched) {
+            return false;
+        }
+    }
+    return true;
+}
+
+CostEstimate estimate_cost(const core::OpCounts& counts, double divisor, const CycleCostTable& table) {
+    CostEstimate estimate = {0.0, 0.0, 0.0};
+    if (divisor <= 0.0) {
+        return estimate;
+    }
+
+    for (size_t i = 0; i < core::NUM_OP_CLASSES; ++i) {
+        estimate.cycles += static_cast<double>(counts.ops[i]) * table.cycles_per_op[i];
+    }
+    estimate.cycles *= table.stall_factor / divisor;
+
+    // E = t * I * V
+    double seconds = estimate.cycles / table.clock_hz;
+    estimate.microseconds = seconds * 1e6;
+    estimate.microjoules = seconds * (table.active_current_ma * 1e-3) * table.supply_v * 1e6;
+    return estimate;
+}
+
+} // namespace host
+} // namespace spectral_gate
@@ -0,0 +1,63 @@
+#ifndef CYCLE_MODEL_H
+#define CYCLE_MODEL_H
+
+#include <string>
+#include "core/op_counter.h"
+
+namespace spectral_gate {
+namespace host {
+
+/**
+ * @brief Per-operation cost table for a target core
+ */
+struct CycleCostTable {
+    double cycles_per_op[core::NUM_OP_CLASSES];
+    double stall_factor;        // Multiplier for flash wait states / cache misses
+    double clock_hz;            // Core clock
+    double active_current_ma;   // Run-mode current at clock_hz
+    double supply_v;            // Supply voltage
+};
+
+/**
+ * @brief Default STM32U5 (Cortex-M33, 160 MHz) table
+ *
+ * Cycle counts follow the Cortex-M33 instruction timings: single-cycle
+ * 32x32->64 MAC and ALU, 2-cycle loads, 1-cycle stores, 2-cycle taken
+ * branches. Divides are mostly 64-bit here and go through the EABI
+ * libcall, so they are costed well above the 2-12 cycle SDIV. Current is
+ * the 15 mA active figure from the energy budget, at 3.0 V.
+ */
+CycleCostTable get_default_m33_cost_table();
+
+/**
+ * @brief Override table entries from a "key = value" text file
+ *
+ * Keys: mac, load, store, branch, divide, alu, stall_factor, clock_hz,
+ * active_current_ma, supply_v. Lines starting with '#' are ignored.
+ * Use this to apply costs calibrated against a board measurement.
+ *
+ * @return false if the file cannot be read or contains an unknown key
+ */
+bool load_cost_table(const std::string& path, CycleCostTable* table);
+
+/**
+ * @brief Estimated cost of a set of counted operations
+ */
+struct CostEstimate {
+    double cycles;
+    double microseconds;
+    double microjoules;
+};
+
+/**
+ * @brief Apply a cost table to operation counts
+ * @param counts Counted operations
+ * @param divisor Scale counts down (e.g. number of windows); 1 = as counted
+ * @param table Cost table
+ */
+CostEstimate estimate_cost(const core::OpCounts& counts, double divisor, const CycleCostTable& table);
+
+} // namespace host
+} // namespace spectral_gate
+
+#endif // CYCLE_MODEL_H
@@ -0,0 +1,115 @@
+#include "dataset.h"
+#include <fstream>
+#include <sstream>
+#include "hal/hal_mock.h"
+#include "recording.h"
+
+namespace spectral_gate {
+namespace host {
+
+const char* window_label_name(WindowLabel label) {
+    switch (label) {
+        case WindowLabel::UNKNOWN: return "unknown";
+        case WindowLabel::NORMAL:  return "normal";
+        case WindowLabel::ANOMALY: return "anomaly";
+    }
+    return "?";
+}
+
+bool append_recording_windows(
+    const std::string& path,
+    uint16_t battery_mv,
+    WindowLabel label,
+    size_t hop,
+    Dataset* dataset
+) {
+    std::vector<int16_t> samples;
+    if (!load_recording(path, &samples)) {
+        return false;
+    }
+
+    size_t length = dataset->window_length;
+    if (hop == 0) {
+        hop = length;
+    }
+    for (size_t start = 0; start + length <= samples.size(); start += hop) {
+        DatasetWindow window;
+        window.source = path;
+        window.battery_mv = battery_mv;
+        window.label = label;
+        window.samples.assign(samples.begin() + start, samples.begin() + start + length);
+        dataset->windows.push_back(std::move(window));
+    }
+    return true;
+}
+
+bool load_dataset_manifest(const std::string& path, size_t hop, Dataset* dataset) {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+
+    size_t slash = path.find_last_of("/\\");
+    std::string dir = (slash == std::string::npos) ? "" : path.substr(0, slash + 1);
+
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string recording;
+        if (!(fields >> recording) || recording[0] == '#') {
+            continue;
+        }
+
+        uint32_t battery_mv = 0;
+        if (!(fields >> battery_mv)) {
+            return false;
+        }
+        WindowLabel label = WindowLabel::UNKNOWN;
+        std::string label_name;
+        if (fields >> label_name) {
+            if (label_name == "normal") {
+                label = WindowLabel::NORMAL;
+            } else if (label_name == "anomaly") {
+                label = WindowLabel::ANOMALY;
+            } else {
+                return false;
+            }
+        }
+
+        bool absolute = (recording[0] == '/') || (recording.find(':') != std::string::npos);
+        if (!append_recording_windows(absolute ? recording : dir + recording,
+                                      static_cast<uint16_t>(battery_mv), label, hop, dataset)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void append_synthetic_windows(uint32_t seed, size_t count, Dataset* dataset) {
+    // Battery levels spanning nominal, low and critical thresholds
+    const uint16_t batteries[] = {4100, 3500, 3200, 2900};
+    const uint32_t frequencies[] = {20, 50, 120, 180, 237, 310, 420};
+    const int16_t amplitudes[] = {1000, 6000, 16000, 30000};
+
+    hal::MockHAL mock;
+    mock.set_seed(seed);
+    for (size_t k = 0; k < count; ++k) {
+        uint8_t pattern = static_cast<uint8_t>(k % 3);
+        int16_t amplitude = amplitudes[(k / 3) % 4];
+        mock.set_vibration_pattern(pattern);
+        mock.set_signal_frequency(frequencies[(k / 12) % 7]);
+        mock.set_signal_amplitude(amplitude);
+        mock.set_noise_level(static_cast<int16_t>(amplitude / 10));
+
+        DatasetWindow window;
+        window.source = (pattern == 0) ? "mock_noise" : (pattern == 1) ? "mock_sine" : "mock_anomaly";
+        window.battery_mv = batteries[k % 4];
+        window.label = (pattern == 2) ? WindowLabel::ANOMALY : WindowLabel::NORMAL;
+        window.samples.resize(dataset->window_length);
+        mock.read_vibration_data(window.samples.data(), window.samples.size());
+        dataset->windows.push_back(std::move(window));
+    }
+}
+
+} // namespace host
+} // namespace spectral_gate
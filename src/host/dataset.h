@@ -0,0 +1,77 @@
+#ifndef DATASET_H
+#define DATASET_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace spectral_gate {
+namespace host {
+
+/**
+ * @brief Ground-truth label of a window
+ */
+enum class WindowLabel : int8_t {
+    UNKNOWN = -1,
+    NORMAL = 0,
+    ANOMALY = 1
+};
+
+const char* window_label_name(WindowLabel label);
+
+/**
+ * @brief One evaluation window
+ */
+struct DatasetWindow {
+    std::string source;         // Recording path or synthetic pattern
+    uint16_t battery_mv;
+    WindowLabel label;
+    std::vector<int16_t> samples;
+};
+
+/**
+ * @brief Windows for offline evaluation (error budgets, sweeps)
+ */
+struct Dataset {
+    size_t window_length;
+    uint32_t sample_rate;
+    std::vector<DatasetWindow> windows;
+};
+
+/**
+ * @brief Cut a raw int16 recording (recording.h) into windows
+ * @param hop Samples between window starts (window_length for no overlap)
+ * @return false if the recording cannot be read
+ */
+bool append_recording_windows(
+    const std::string& path,
+    uint16_t battery_mv,
+    WindowLabel label,
+    size_t hop,
+    Dataset* dataset
+);
+
+/**
+ * @brief Load every recording listed in a manifest
+ *
+ * One recording per line: `<path> <battery_mv> [normal|anomaly]`.
+ * Blank lines and lines starting with '#' are ignored; relative paths
+ * are resolved against the manifest's directory.
+ *
+ * @return false if the manifest or any recording cannot be read
+ */
+bool load_dataset_manifest(const std::string& path, size_t hop, Dataset* dataset);
+
+/**
+ * @brief Append seeded MockHAL windows
+ *
+ * Cycles through noise, sinusoid (normal) and anomaly-pattern (anomaly)
+ * windows over a spread of frequencies, amplitudes and battery levels.
+ */
+void append_synthetic_windows(uint32_t seed, size_t count, Dataset* dataset);
+
+} // namespace host
+} // namespace spectral_gate
+
+#endif // DATASET_H
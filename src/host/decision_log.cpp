@@ -0,0 +1,470 @@
+#include "decision_log.h"
+#include <algorithm>
+#include <cstring>
+
+namespace spectral_gate {
+namespace host {
+
+using namespace hal;
+
+namespace {
+    constexpr char LOG_MAGIC[4] = {'S', 'G', 'D', 'L'};
+    constexpr uint16_t LOG_VERSION = 1;
+    constexpr uint16_t LOG_COLUMNS = 11;
+    constexpr size_t HEADER_SIZE = 16;
+    constexpr size_t BLOCK_HEADER_SIZE = 8;
+
+    // Encoded width of one record across all columns
+    constexpr size_t RECORD_SIZE = 4 + 2 + 2 + 4 + 4 + 1 + 1 + 4 + 4 + 1 + 1;
+
+    // Sanity bound so a corrupt count cannot request a huge allocation
+    constexpr uint32_t MAX_BLOCK_RECORDS = 1u << 20;
+
+    void put_u16(uint8_t* p, uint16_t v) {
+        p[0] = static_cast<uint8_t>(v & 0xFF);
+        p[1] = static_cast<uint8_t>(v >> 8);
+    }
+
+    void put_u32(uint8_t* p, uint32_t v) {
+        for (int i = 0; i < 4; ++i) p[i] = static_cast<uint8_t>((v >> (8 * i)) & 0xFF);
+    }
+
+    uint16_t get_u16(const uint8_t* p) {
+        return static_cast<uint16_t>(p[0] | (p[1] << 8));
+    }
+
+    uint32_t get_u32(const uint8_t* p) {
+        return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+               (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    uint32_t checksum(const uint8_t* data, size_t length) {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < length; ++i) {
+            hash ^= data[i];
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    // Column encoders: each advances p past count values
+    template <typename T>
+    uint8_t* encode_u32(uint8_t* p, const std::vector<T>& column) {
+        for (T v : column) {
+            put_u32(p, static_cast<uint32_t>(v));
+            p += 4;
+        }
+        return p;
+    }
+
+    uint8_t* encode_u16(uint8_t* p, const std::vector<uint16_t>& column) {
+        for (uint16_t v : column) {
+            put_u16(p, v);
+            p += 2;
+        }
+        return p;
+    }
+
+    template <typename T>
+    uint8_t* encode_u8(uint8_t* p, const std::vector<T>& column) {
+        for (T v : column) {
+            *p++ = static_cast<uint8_t>(v);
+        }
+        return p;
+    }
+
+    template <typename T>
+    const uint8_t* decode_u32(const uint8_t* p, size_t count, std::vector<T>* column) {
+        for (size_t i = 0; i < count; ++i, p += 4) {
+            column->push_back(static_cast<T>(get_u32(p)));
+        }
+        return p;
+    }
+
+    const uint8_t* decode_u16(const uint8_t* p, size_t count, std::vector<uint16_t>* column) {
+        for (size_t i = 0; i < count; ++i, p += 2) {
+            column->push_back(get_u16(p));
+        }
+        return p;
+    }
+
+    template <typename T>
+    const uint8_t* decode_u8(const uint8_t* p, size_t count, std::vector<T>* column) {
+        for (size_t i = 0; i < count; ++i) {
+            column->push_back(static_cast<T>(*p++));
+        }
+        return p;
+    }
+}
+
+DecisionRecord make_decision_record(
+    uint32_t time_s,
+    uint16_t node_id,
+    uint16_t battery_mv,
+    const core::SpectralResult& spectral,
+    const core::InferenceResult& inference,
+    core::Decision decision,
+    const core::ThresholdConfig& config
+) {
+    DecisionRecord record;
+    record.time_s = time_s;
+    record.node_id = node_id;
+    record.battery_mv = battery_mv;
+    record.dominant_frequency = spectral.dominant_frequency;
+    record.peak_magnitude = spectral.peak_magnitude;
+    record.num_peaks = spectral.num_peaks;
+    record.predicted_class = inference.predicted_class;
+    record.confidence = inference.confidence;
+    record.threshold = core::get_effective_threshold(battery_mv, config);
+    record.decision = decision;
+    record.reason = core::get_decision_reason(decision, inference, battery_mv, record.threshold);
+    return record;
+}
+
+void DecisionColumns::reserve(size_t count) {
+    time_s.reserve(count);
+    node_id.reserve(count);
+    battery_mv.reserve(count);
+    dominant_frequency.reserve(count);
+    peak_magnitude.reserve(count);
+    num_peaks.reserve(count);
+    predicted_class.reserve(count);
+    confidence.reserve(count);
+    threshold.reserve(count);
+    decision.reserve(count);
+    reason.reserve(count);
+}
+
+void DecisionColumns::clear() {
+    time_s.clear();
+    node_id.clear();
+    battery_mv.clear();
+    dominant_frequency.clear();
+    peak_magnitude.clear();
+    num_peaks.clear();
+    predicted_class.clear();
+    confidence.clear();
+    threshold.clear();
+    decision.clear();
+    reason.clear();
+}
+
+void DecisionColumns::push_back(const DecisionRecord& record) {
+    time_s.push_back(record.time_s);
+    node_id.push_back(record.node_id);
+    battery_mv.push_back(record.battery_mv);
+    dominant_frequency.push_back(record.dominant_frequency);
+    peak_magnitude.push_back(record.peak_magnitude);
+    num_peaks.push_back(record.num_peaks);
+    predicted_class.push_back(record.predicted_class);
+    confidence.push_back(record.confidence);
+    threshold.push_back(record.threshold);
+    decision.push_back(record.decision);
+    reason.push_back(record.reason);
+}
+
+DecisionRecord DecisionColumns::row(size_t index) const {
+    DecisionRecord record;
+    record.time_s = time_s[index];
+    record.node_id = node_id[index];
+    record.battery_mv = battery_mv[index];
+    record.dominant_frequency = dominant_frequency[index];
+    record.peak_magnitude = peak_magnitude[index];
+    record.num_peaks = num_peaks[index];
+    record.predicted_class = predicted_class[index];
+    record.confidence = confidence[index];
+    record.threshold = threshold[index];
+    record.decision = decision[index];
+    record.reason = reason[index];
+    return record;
+}
+
+//=============================================================================
+// Writer
+//=============================================================================
+
+DecisionLogWriter::DecisionLogWriter()
+    : file_(nullptr),
+      records_(0),
+      ok_(false)
+{
+}
+
+DecisionLogWriter::~DecisionLogWriter() {
+    close();
+}
+
+bool DecisionLogWriter::open(const std::string& path) {
+    if (file_ != nullptr) {
+        return false;
+    }
+    file_ = std::fopen(path.c_str(), "wb");
+    if (file_ == nullptr) {
+        return false;
+    }
+
+    uint8_t header[HEADER_SIZE] = {};
+    std::memcpy(header, LOG_MAGIC, 4);
+    put_u16(&header[4], LOG_VERSION);
+    put_u16(&header[6], LOG_COLUMNS);
+    put_u32(&header[8], static_cast<uint32_t>(BLOCK_RECORDS));
+    ok_ = std::fwrite(header, 1, HEADER_SIZE, file_) == HEADER_SIZE;
+
+    pending_.clear();
+    pending_.reserve(BLOCK_RECORDS);
+    staging_.resize(BLOCK_HEADER_SIZE + BLOCK_RECORDS * RECORD_SIZE);
+    records_ = 0;
+    return ok_;
+}
+
+bool DecisionLogWriter::append(const DecisionRecord& record) {
+    pending_.push_back(record);
+    ++records_;
+    if (pending_.size() >= BLOCK_RECORDS) {
+        flush();
+    }
+    return ok_;
+}
+
+bool DecisionLogWriter::flush() {
+    const size_t count = pending_.size();
+    if (file_ == nullptr) {
+        pending_.clear();
+        return false;
+    }
+    if (count == 0) {
+        return ok_;
+    }
+
+    uint8_t* payload = staging_.data() + BLOCK_HEADER_SIZE;
+    uint8_t* p = payload;
+    p = encode_u32(p, pending_.time_s);
+    p = encode_u16(p, pending_.node_id);
+    p = encode_u16(p, pending_.battery_mv);
+    p = encode_u32(p, pending_.dominant_frequency);
+    p = encode_u32(p, pending_.peak_magnitude);
+    p = encode_u8(p, pending_.num_peaks);
+    p = encode_u8(p, pending_.predicted_class);
+    p = encode_u32(p, pending_.confidence);
+    p = encode_u32(p, pending_.threshold);
+    p = encode_u8(p, pending_.decision);
+    p = encode_u8(p, pending_.reason);
+
+    const size_t length = static_cast<size_t>(p - staging_.data());
+    put_u32(&staging_[0], static_cast<uint32_t>(count));
+    put_u32(&staging_[4], checksum(payload, length - BLOCK_HEADER_SIZE));
+    if (ok_) {
+        ok_ = std::fwrite(staging_.data(), 1, length, file_) == length;
+    }
+    pending_.clear();
+    return ok_;
+}
+
+bool DecisionLogWriter::close() {
+    if (file_ == nullptr) {
+        return ok_;
+    }
+    flush();
+    ok_ = (std::fclose(file_) == 0) && ok_;
+    file_ = nullptr;
+    return ok_;
+}
+
+//=============================================================================
+// Reader
+//=============================================================================
+
+DecisionLogReader::DecisionLogReader()
+    : file_(nullptr),
+      complete_(false)
+{
+}
+
+DecisionLogReader::~DecisionLogReader() {
+    close();
+}
+
+bool DecisionLogReader::open(const std::string& path) {
+    close();
+    file_ = std::fopen(path.c_str(), "rb");
+    if (file_ == nullptr) {
+        return false;
+    }
+
+    uint8_t header[HEADER_SIZE];
+    if (std::fread(header, 1, HEADER_SIZE, file_) != HEADER_SIZE ||
+        std::memcmp(header, LOG_MAGIC, 4) != 0 ||
+        get_u16(&header[4]) != LOG_VERSION ||
+        get_u16(&header[6]) != LOG_COLUMNS) {
+        close();
+        return false;
+    }
+    complete_ = false;
+    return true;
+}
+
+bool DecisionLogReader::read_block(DecisionColumns* columns) {
+    if (file_ == nullptr || complete_) {
+        return false;
+    }
+
+    uint8_t block_header[BLOCK_HEADER_SIZE];
+    size_t got = std::fread(block_header, 1, BLOCK_HEADER_SIZE, file_);
+    if (got == 0 && std::feof(file_)) {
+        complete_ = true;
+        return false;
+    }
+    uint32_t count = get_u32(&block_header[0]);
+    if (got != BLOCK_HEADER_SIZE || count == 0 || count > MAX_BLOCK_RECORDS) {
+        return false;
+    }
+
+    staging_.resize(static_cast<size_t>(count) * RECORD_SIZE);
+    if (std::fread(staging_.data(), 1, staging_.size(), file_) != staging_.size() ||
+        checksum(staging_.data(), staging_.size()) != get_u32(&block_header[4])) {
+        return false;
+    }
+
+    // Grow geometrically: an exact reserve per block would copy every
+    // column again for each block read
+    size_t needed = columns->size() + count;
+    if (columns->time_s.capacity() < needed) {
+        columns->reserve(std::max(needed, 2 * columns->time_s.capacity()));
+    }
+    const uint8_t* p = staging_.data();
+    p = decode_u32(p, count, &columns->time_s);
+    p = decode_u16(p, count, &columns->node_id);
+    p = decode_u16(p, count, &columns->battery_mv);
+    p = decode_u32(p, count, &columns->dominant_frequency);
+    p = decode_u32(p, count, &columns->peak_magnitude);
+    p = decode_u8(p, count, &columns->num_peaks);
+    p = decode_u8(p, count, &columns->predicted_class);
+    p = decode_u32(p, count, &columns->confidence);
+    p = decode_u32(p, count, &columns->threshold);
+    p = decode_u8(p, count, &columns->decision);
+    decode_u8(p, count, &columns->reason);
+    return true;
+}
+
+void DecisionLogReader::close() {
+    if (file_ != nullptr) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+bool read_decision_log(const std::string& path, DecisionColumns* columns) {
+    DecisionLogReader reader;
+    if (!reader.open(path)) {
+        return false;
+    }
+    while (reader.read_block(columns)) {
+    }
+    return reader.is_complete();
+}
+
+bool scan_decision_log(const uint8_t* data, size_t length, std::vector<DecisionBlockRef>* blocks) {
+    if (length < HEADER_SIZE ||
+        std::memcmp(data, LOG_MAGIC, 4) != 0 ||
+        get_u16(&data[4]) != LOG_VERSION ||
+        get_u16(&data[6]) != LOG_COLUMNS) {
+        return false;
+    }
+
+    size_t offset = HEADER_SIZE;
+    while (offset < length) {
+        if (offset + BLOCK_HEADER_SIZE > length) {
+            return false;
+        }
+        uint32_t count = get_u32(&data[offset]);
+        size_t payload = offset + BLOCK_HEADER_SIZE;
+        if (count == 0 || count > MAX_BLOCK_RECORDS ||
+            payload + static_cast<size_t>(count) * RECORD_SIZE > length) {
+            return false;
+        }
+        blocks->push_back(DecisionBlockRef{payload, count, get_u32(&data[offset + 4])});
+        offset = payload + static_cast<size_t>(count) * RECORD_SIZE;
+    }
+    return true;
+}
+
+bool verify_decision_block(const uint8_t* data, const DecisionBlockRef& block) {
+    return checksum(data + block.payload_offset, static_cast<size_t>(block.count) * RECORD_SIZE) ==
+           block.checksum;
+}
+
+DecisionRecord DecisionBlockView::row(size_t i) const {
+    const size_t n = count_;
+    DecisionRecord record;
+    record.time_s = time_s(i);
+    record.node_id = node_id(i);
+    record.battery_mv = battery_mv(i);
+    record.dominant_frequency = static_cast<fixed_t>(load_u32(payload_ + 8 * n + 4 * i));
+    record.peak_magnitude = static_cast<fixed_t>(load_u32(payload_ + 12 * n + 4 * i));
+    record.num_peaks = payload_[16 * n + i];
+    record.predicted_class = payload_[17 * n + i];
+    record.confidence = confidence(i);
+    record.threshold = static_cast<fixed_t>(load_u32(payload_ + 22 * n + 4 * i));
+    record.decision = decision(i);
+    record.reason = static_cast<core::DecisionReason>(payload_[27 * n + i]);
+    return record;
+}
+
+//=============================================================================
+// Rendering
+//=============================================================================
+
+void format_log_time(uint32_t time_s, char* buffer, size_t size) {
+    unsigned hours = time_s / 3600;
+    unsigned minutes = (time_s / 60) % 60;
+    unsigned seconds = time_s % 60;
+    if (seconds == 0) {
+        std::snprintf(buffer, size, "%02u:%02u", hours, minutes);
+    } else {
+        std::snprintf(buffer, size, "%02u:%02u:%02u", hours, minutes, seconds);
+    }
+}
+
+void print_decision_table(std::ostream& out, const DecisionColumns& columns) {
+    out << "┌──────────┬────────────┬─────────────┬───────────┬─────────────┬───────────────┐\n";
+    out << "│   Time   │ V_bat (mV) │ Probability │ Threshold │   Decision  │    Reason     │\n";
+    out << "├──────────┼────────────┼─────────────┼───────────┼─────────────┼───────────────┤\n";
+    for (size_t i = 0; i < columns.size(); ++i) {
+        char time[16];
+        format_log_time(columns.time_s[i], time, sizeof(time));
+        char line[160];
+        std::snprintf(line, sizeof(line), "│ %-8s │ %10u │ %10.1f%% │ %8.1f%% │ %-11s │ %-13s │\n",
+                      time,
+                      static_cast<unsigned>(columns.battery_mv[i]),
+                      fixed_to_float(columns.confidence[i]) * 100.0f,
+                      fixed_to_float(columns.threshold[i]) * 100.0f,
+                      core::decision_to_string(columns.decision[i]),
+                      core::decision_reason_to_string(columns.reason[i]));
+        out << line;
+    }
+    out << "└──────────┴────────────┴─────────────┴───────────┴─────────────┴───────────────┘\n";
+}
+
+void write_decision_csv(std::ostream& out, const DecisionColumns& columns) {
+    out << "time_s,node_id,battery_mv,dominant_frequency,peak_magnitude,num_peaks,"
+        << "predicted_class,confidence,threshold,decision,reason\n";
+    for (size_t i = 0; i < columns.size(); ++i) {
+        char line[192];
+        std::snprintf(line, sizeof(line), "%u,%u,%u,%.4f,%.4f,%u,%u,%.4f,%.4f,%s,%s\n",
+                      static_cast<unsigned>(columns.time_s[i]),
+                      static_cast<unsigned>(columns.node_id[i]),
+                      static_cast<unsigned>(columns.battery_mv[i]),
+                      fixed_to_float(columns.dominant_frequency[i]),
+                      fixed_to_float(columns.peak_magnitude[i]),
+                      static_cast<unsigned>(columns.num_peaks[i]),
+                      static_cast<unsigned>(columns.predicted_class[i]),
+                      fixed_to_float(columns.confidence[i]),
+                      fixed_to_float(columns.threshold[i]),
+                      core::decision_to_string(columns.decision[i]),
+                      core::decision_reason_to_string(columns.reason[i]));
+        out << line;
+    }
+}
+
+} // namespace host
+} // namespace spectral_gate
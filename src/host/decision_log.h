@@ -0,0 +1,249 @@
+#ifndef DECISION_LOG_H
+#define DECISION_LOG_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "hal/hal_interface.h"
+#include "core/decision.h"
+
+namespace spectral_gate {
+namespace host {
+
+/**
+ * @brief One evaluated window as recorded in a decision log
+ */
+struct DecisionRecord {
+    uint32_t time_s;                    // Seconds since the start of the run
+    uint16_t node_id;
+    uint16_t battery_mv;
+    hal::fixed_t dominant_frequency;    // Feature summary (SpectralResult)
+    hal::fixed_t peak_magnitude;
+    uint8_t num_peaks;
+    uint8_t predicted_class;
+    hal::fixed_t confidence;
+    hal::fixed_t threshold;             // Effective threshold at battery_mv
+    core::Decision decision;
+    core::DecisionReason reason;
+};
+
+/**
+ * @brief Fill a record from the stage outputs of one window; the
+ *        threshold and reason are derived from config
+ */
+DecisionRecord make_decision_record(
+    uint32_t time_s,
+    uint16_t node_id,
+    uint16_t battery_mv,
+    const core::SpectralResult& spectral,
+    const core::InferenceResult& inference,
+    core::Decision decision,
+    const core::ThresholdConfig& config
+);
+
+/**
+ * @brief Decision records stored column by column
+ */
+struct DecisionColumns {
+    std::vector<uint32_t> time_s;
+    std::vector<uint16_t> node_id;
+    std::vector<uint16_t> battery_mv;
+    std::vector<hal::fixed_t> dominant_frequency;
+    std::vector<hal::fixed_t> peak_magnitude;
+    std::vector<uint8_t> num_peaks;
+    std::vector<uint8_t> predicted_class;
+    std::vector<hal::fixed_t> confidence;
+    std::vector<hal::fixed_t> threshold;
+    std::vector<core::Decision> decision;
+    std::vector<core::DecisionReason> reason;
+
+    size_t size() const { return time_s.size(); }
+    void reserve(size_t count);
+    void clear();
+    void push_back(const DecisionRecord& record);
+    DecisionRecord row(size_t index) const;
+};
+
+/**
+ * @brief Writer for columnar binary decision logs (".sgdl")
+ *
+ * append() only copies the record into per-column arrays. Every
+ * BLOCK_RECORDS records the block is encoded column after column into one
+ * staging buffer and written with a single fwrite:
+ *
+ *   file:  16-byte header ("SGDL", version, column count, block size)
+ *   block: u32 record count, u32 FNV-1a checksum of the payload, then
+ *          each column as count little-endian values (28 bytes per record)
+ *
+ * No text formatting happens on the write path; see print_decision_table()
+ * and write_decision_csv() for rendering.
+ */
+class DecisionLogWriter {
+public:
+    static constexpr size_t BLOCK_RECORDS = 8192;
+
+    DecisionLogWriter();
+    ~DecisionLogWriter();
+
+    DecisionLogWriter(const DecisionLogWriter&) = delete;
+    DecisionLogWriter& operator=(const DecisionLogWriter&) = delete;
+
+    /**
+     * @brief Create (truncate) the log and write its header
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Queue a record; writes a block once BLOCK_RECORDS are queued
+     * @return false once any write has failed
+     */
+    bool append(const DecisionRecord& record);
+
+    /**
+     * @brief Write queued records as a (possibly short) block
+     */
+    bool flush();
+
+    /**
+     * @brief Flush and close
+     * @return false if any write failed
+     */
+    bool close();
+
+    uint64_t get_records() const { return records_; }
+
+private:
+    std::FILE* file_;
+    DecisionColumns pending_;
+    std::vector<uint8_t> staging_;
+    uint64_t records_;
+    bool ok_;
+};
+
+/**
+ * @brief Block-at-a-time reader for decision logs
+ */
+class DecisionLogReader {
+public:
+    DecisionLogReader();
+    ~DecisionLogReader();
+
+    DecisionLogReader(const DecisionLogReader&) = delete;
+    DecisionLogReader& operator=(const DecisionLogReader&) = delete;
+
+    /**
+     * @brief Open a log and validate its header
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Append the next block to columns
+     * @return false at end of file or on a torn/corrupt block
+     *         (is_complete() tells which)
+     */
+    bool read_block(DecisionColumns* columns);
+
+    /**
+     * @brief True once read_block() reached a clean end of file
+     */
+    bool is_complete() const { return complete_; }
+
+    void close();
+
+private:
+    std::FILE* file_;
+    std::vector<uint8_t> staging_;
+    bool complete_;
+};
+
+/**
+ * @brief Location of one block inside an encoded log
+ */
+struct DecisionBlockRef {
+    size_t payload_offset;      // Byte offset of the block's first column
+    uint32_t count;             // Records in the block
+    uint32_t checksum;          // Stored payload checksum
+};
+
+/**
+ * @brief Walk the header and block headers of a log held in memory
+ *        (e.g. an mmap) without decoding any column
+ * @return false if the header is invalid or the log ends in a torn
+ *         block (the blocks before it are still returned)
+ */
+bool scan_decision_log(const uint8_t* data, size_t length, std::vector<DecisionBlockRef>* blocks);
+
+/**
+ * @brief Check a block's payload against its stored checksum
+ */
+bool verify_decision_block(const uint8_t* data, const DecisionBlockRef& block);
+
+/**
+ * @brief Random access to the columns of one encoded block
+ *
+ * Reads a single field of a single record straight from the encoded
+ * payload, so a query touches only the columns it filters or
+ * aggregates on.
+ */
+class DecisionBlockView {
+public:
+    DecisionBlockView(const uint8_t* payload, uint32_t count)
+        : payload_(payload), count_(count) {}
+
+    uint32_t count() const { return count_; }
+
+    uint32_t time_s(size_t i) const { return load_u32(payload_ + 4 * i); }
+    uint16_t node_id(size_t i) const { return load_u16(payload_ + 4 * count_ + 2 * i); }
+    uint16_t battery_mv(size_t i) const { return load_u16(payload_ + 6 * count_ + 2 * i); }
+    hal::fixed_t confidence(size_t i) const {
+        return static_cast<hal::fixed_t>(load_u32(payload_ + 18 * count_ + 4 * i));
+    }
+    core::Decision decision(size_t i) const {
+        return static_cast<core::Decision>(payload_[26 * count_ + i]);
+    }
+
+    DecisionRecord row(size_t i) const;
+
+private:
+    static uint16_t load_u16(const uint8_t* p) {
+        return static_cast<uint16_t>(p[0] | (p[1] << 8));
+    }
+    static uint32_t load_u32(const uint8_t* p) {
+        return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+               (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    const uint8_t* payload_;
+    uint32_t count_;
+};
+
+/**
+ * @brief Read a whole log
+ * @return false if the header is invalid or the log ends in a torn or
+ *         corrupt block (the records before it are still returned)
+ */
+bool read_decision_log(const std::string& path, DecisionColumns* columns);
+
+/**
+ * @brief Render records as the demo's box-drawn table
+ */
+void print_decision_table(std::ostream& out, const DecisionColumns& columns);
+
+/**
+ * @brief Render records as plain CSV, one row per record
+ */
+void write_decision_csv(std::ostream& out, const DecisionColumns& columns);
+
+/**
+ * @brief Format a log time as HH:MM (HH:MM:SS when seconds are set);
+ *        hours keep counting past 24
+ */
+void format_log_time(uint32_t time_s, char* buffer, size_t size);
+
+} // namespace host
+} // namespace spectral_gate
+
+#endif // DECISION_LOG_H
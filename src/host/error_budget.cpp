@@ -0,0 +1,171 @@
+#include "error_budget.h"
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+namespace spectral_gate {
+namespace host {
+
+namespace {
+    // Strongest bin, skipping DC as analyze_spectrum() does
+    size_t strongest_bin(const hal::fixed_t* magnitudes, size_t count) {
+        size_t best = 0;
+        hal::fixed_t peak = 0;
+        for (size_t i = 1; i < count; ++i) {
+            if (magnitudes[i] > peak) {
+                peak = magnitudes[i];
+                best = i;
+            }
+        }
+        return best;
+    }
+
+    double rate(size_t flips, size_t windows) {
+        return (windows > 0) ? static_cast<double>(flips) / static_cast<double>(windows) : 0.0;
+    }
+}
+
+void StageError::add(double reference, double fixed) {
+    double error = fixed - reference;
+    signal_energy += reference * reference;
+    error_energy += error * error;
+    if (std::fabs(error) > max_abs_error) {
+        max_abs_error = std::fabs(error);
+    }
+    ++count;
+}
+
+double StageError::snr_db() const {
+    if (error_energy <= 0.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return 10.0 * std::log10(signal_energy / error_energy);
+}
+
+ErrorBudgetReport run_error_budget(
+    const Dataset& dataset,
+    core::SpectralProcessor& spectral,
+    core::InferenceEngine& engine,
+    const ReferenceSpectralProcessor& reference_spectral,
+    const ReferenceInferenceEngine& reference_engine,
+    const core::ThresholdConfig& config
+) {
+    ErrorBudgetReport report = {};
+
+    const size_t bins = spectral.get_num_bins();
+    std::vector<hal::fixed_t> magnitudes(bins);
+    std::vector<double> reference_magnitudes(bins);
+    std::vector<hal::fixed_t> features(bins);
+    std::vector<double> reference_features(bins);
+    std::vector<double> dequantized(bins);
+
+    for (const DatasetWindow& window : dataset.windows) {
+        const int16_t* samples = window.samples.data();
+        size_t n = window.samples.size();
+
+        // Spectrum: the raw fixed_t magnitude is in input counts
+        spectral.compute_magnitude_spectrum(samples, n, magnitudes.data());
+        reference_spectral.compute_magnitude_spectrum(samples, n, reference_magnitudes.data());
+        for (size_t i = 0; i < bins; ++i) {
+            report.spectrum.add(reference_magnitudes[i], static_cast<double>(magnitudes[i]));
+        }
+
+        core::SpectralResult result = spectral.process(samples, n);
+        ReferenceSpectralResult reference_result = reference_spectral.analyze_spectrum(
+            reference_magnitudes.data(), bins);
+        if (strongest_bin(magnitudes.data(), bins) != reference_result.dominant_bin) {
+            ++report.dominant_bin_flips;
+        }
+        if (result.num_peaks != reference_result.num_peaks) {
+            ++report.peak_count_flips;
+        }
+
+        // Features
+        size_t num_features = spectral.extract_features(samples, n, features.data(), bins);
+        reference_spectral.extract_features(samples, n, reference_features.data(), bins);
+        for (size_t i = 0; i < num_features; ++i) {
+            dequantized[i] = static_cast<double>(features[i]) / hal::FIXED_ONE;
+            report.features.add(reference_features[i], dequantized[i]);
+        }
+
+        // Inference alone (same input), then end to end
+        core::InferenceResult inference = engine.run(features.data(), num_features);
+        ReferenceInferenceResult local = reference_engine.run(dequantized.data(), num_features);
+        ReferenceInferenceResult reference_inference = reference_engine.run(
+            reference_features.data(), num_features);
+        double confidence = static_cast<double>(inference.confidence) / hal::FIXED_ONE;
+        report.inference.add(local.confidence, confidence);
+        report.end_to_end.add(reference_inference.confidence, confidence);
+        if (inference.predicted_class != reference_inference.predicted_class) {
+            ++report.class_flips;
+        }
+
+        core::Decision decision = core::evaluate_structure(result, inference, window.battery_mv, config);
+        if (decision != reference_decision(reference_result, reference_inference,
+                                           window.battery_mv, config)) {
+            ++report.decision_flips;
+        }
+        ++report.windows;
+    }
+    return report;
+}
+
+void print_error_budget(std::ostream& out, const ErrorBudgetReport& report) {
+    struct Row { const char* name; const StageError* stage; };
+    const Row rows[] = {
+        {"spectrum", &report.spectrum},
+        {"features", &report.features},
+        {"inference", &report.inference},
+        {"end_to_end", &report.end_to_end},
+    };
+
+    out << report.windows << " windows\n";
+    out << "stage        SNR (dB)   max |error|\n";
+    for (const Row& row : rows) {
+        char line[96];
+        std::snprintf(line, sizeof(line), "%-12s %8.2f   %.6g\n",
+                      row.name, row.stage->snr_db(), row.stage->max_abs_error);
+        out << line;
+    }
+
+    struct Flip { const char* name; size_t count; };
+    const Flip flips[] = {
+        {"dominant_bin", report.dominant_bin_flips},
+        {"num_peaks", report.peak_count_flips},
+        {"class", report.class_flips},
+        {"decision", report.decision_flips},
+    };
+    out << "flip         rate       windows\n";
+    for (const Flip& flip : flips) {
+        char line[96];
+        std::snprintf(line, sizeof(line), "%-12s %7.3f%%   %zu\n",
+                      flip.name, 100.0 * rate(flip.count, report.windows), flip.count);
+        out << line;
+    }
+}
+
+void write_error_budget_csv(std::ostream& out, const ErrorBudgetReport& report) {
+    out << "metric,value\n";
+    out << "windows," << report.windows << "\n";
+
+    struct Row { const char* name; const StageError* stage; };
+    const Row rows[] = {
+        {"spectrum", &report.spectrum},
+        {"features", &report.features},
+        {"inference", &report.inference},
+        {"end_to_end", &report.end_to_end},
+    };
+    for (const Row& row : rows) {
+        out << row.name << "_snr_db," << row.stage->snr_db() << "\n";
+        out << row.name << "_max_abs_error," << row.stage->max_abs_error << "\n";
+    }
+
+    out << "dominant_bin_flip_rate," << rate(report.dominant_bin_flips, report.windows) << "\n";
+    out << "num_peaks_flip_rate," << rate(report.peak_count_flips, report.windows) << "\n";
+    out << "class_flip_rate," << rate(report.class_flips, report.windows) << "\n";
+    out << "decision_flip_rate," << rate(report.decision_flips, report.windows) << "\n";
+}
+
+} // namespace host
+} // namespace spectral_gate
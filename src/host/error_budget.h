@@ -0,0 +1,79 @@
+#ifndef ERROR_BUDGET_H
+#define ERROR_BUDGET_H
+
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+#include "core/decision.h"
+#include "core/inference.h"
+#include "core/spectral.h"
+#include "dataset.h"
+#include "reference.h"
+
+namespace spectral_gate {
+namespace host {
+
+/**
+ * @brief Signal and error energy of one stage against the reference
+ */
+struct StageError {
+    double signal_energy;       // Sum of reference^2
+    double error_energy;        // Sum of (fixed - reference)^2
+    double max_abs_error;
+    size_t count;
+
+    void add(double reference, double fixed);
+
+    /**
+     * @brief 10*log10(signal/error); infinity when the stage is exact
+     */
+    double snr_db() const;
+};
+
+/**
+ * @brief Accuracy the fixed-point path gives up, stage by stage
+ *
+ * Each stage is measured in isolation (fed the fixed-point output of the
+ * stage before it) and end to end (fed the reference output), so a loss
+ * can be attributed to the stage that introduces it.
+ */
+struct ErrorBudgetReport {
+    size_t windows;
+
+    StageError spectrum;            // Magnitudes, input counts
+    StageError features;            // Normalized spectrum, max 1.0
+    StageError inference;           // Confidence, both engines on fixed features
+    StageError end_to_end;          // Confidence, each path on its own features
+
+    size_t dominant_bin_flips;      // Strongest non-DC bin differs
+    size_t peak_count_flips;        // num_peaks differs
+    size_t class_flips;             // predicted_class differs (end to end)
+    size_t decision_flips;          // evaluate_structure() outcome differs
+};
+
+/**
+ * @brief Run the fixed-point and reference paths over a dataset
+ */
+ErrorBudgetReport run_error_budget(
+    const Dataset& dataset,
+    core::SpectralProcessor& spectral,
+    core::InferenceEngine& engine,
+    const ReferenceSpectralProcessor& reference_spectral,
+    const ReferenceInferenceEngine& reference_engine,
+    const core::ThresholdConfig& config
+);
+
+/**
+ * @brief Human-readable table: per-stage SNR and flip rates
+ */
+void print_error_budget(std::ostream& out, const ErrorBudgetReport& report);
+
+/**
+ * @brief `metric,value` rows: per-stage SNR and max error, flip rates
+ */
+void write_error_budget_csv(std::ostream& out, const ErrorBudgetReport& report);
+
+} // namespace host
+} // namespace spectral_gate
+
+#endif // ERROR_BUDGET_H
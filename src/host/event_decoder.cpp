@@ -0,0 +1,171 @@
+#include "event_decoder.h"
+
+#include <algorithm>
+
+namespace spectral_gate {
+namespace host {
+
+using namespace hal;
+
+namespace {
+    constexpr uint16_t TIME_ESCAPE = 0xFFFF;
+    constexpr uint8_t ERASED_BYTE = 0xFF;
+
+    uint16_t get_u16(const uint8_t* p) {
+        return static_cast<uint16_t>(p[0] | (p[1] << 8));
+    }
+
+    uint32_t get_u32(const uint8_t* p) {
+        return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+               (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+}
+
+bool decode_event_batch(
+    const uint8_t* data,
+    size_t length,
+    size_t* consumed,
+    std::vector<DecodedEvent>* events
+) {
+    *consumed = 0;
+    if (length < core::EVENT_BATCH_HEADER_BYTES || data[0] != core::EVENT_BATCH_TAG || data[1] == 0) {
+        return false;
+    }
+
+    const size_t count = data[1];
+    const uint32_t first_sequence = get_u32(&data[2]);
+    uint32_t time_s = get_u32(&data[6]);
+    size_t offset = core::EVENT_BATCH_HEADER_BYTES;
+    const size_t start = events->size();
+
+    for (size_t i = 0; i < count; ++i) {
+        if (offset + core::EVENT_BATCH_RECORD_BYTES > length) {
+            events->resize(start);
+            return false;
+        }
+        uint16_t delta = get_u16(&data[offset]);
+        offset += 2;
+        if (delta == TIME_ESCAPE) {
+            if (offset + 4 + 4 > length) {
+                events->resize(start);
+                return false;
+            }
+            time_s = get_u32(&data[offset]);
+            offset += 4;
+        } else {
+            time_s += delta;
+        }
+
+        DecodedEvent decoded;
+        decoded.sequence = first_sequence + static_cast<uint32_t>(i);
+        decoded.event.time_s = time_s;
+        decoded.event.battery_mv = get_u16(&data[offset]);
+        decoded.event.confidence_pct = data[offset + 2];
+        decoded.event.flags = data[offset + 3];
+        offset += 4;
+        events->push_back(decoded);
+    }
+
+    *consumed = offset;
+    return true;
+}
+
+bool decode_event_log(
+    const uint8_t* data,
+    size_t length,
+    std::vector<DecodedEvent>* events,
+    EventDecodeStats* stats
+) {
+    EventDecodeStats local = {};
+    const size_t start = events->size();
+    size_t offset = 0;
+    bool complete = true;
+
+    while (offset < length) {
+        if (data[offset] == ERASED_BYTE) {
+            ++offset;
+            ++local.padding_bytes;
+            continue;
+        }
+        size_t consumed = 0;
+        if (!decode_event_batch(data + offset, length - offset, &consumed, events)) {
+            complete = false;
+            break;
+        }
+        offset += consumed;
+        ++local.batches;
+    }
+
+    local.events = events->size() - start;
+
+    if (stats != nullptr) {
+        *stats = local;
+    }
+    return complete;
+}
+
+bool decode_alert_frame(
+    const uint8_t* frame,
+    size_t length,
+    AlertFrame* alert,
+    std::vector<DecodedEvent>* events
+) {
+    if (length < core::ALERT_HEADER_BYTES || frame[0] != core::ALERT_FRAME_SYNC) {
+        return false;
+    }
+    alert->alert_type = frame[1];
+    alert->confidence = frame[2];
+    alert->time_s = get_u32(&frame[3]);
+
+    if (length == core::ALERT_HEADER_BYTES) {
+        return true;
+    }
+    size_t consumed = 0;
+    return decode_event_batch(frame + core::ALERT_HEADER_BYTES, length - core::ALERT_HEADER_BYTES,
+                              &consumed, events) &&
+           consumed == length - core::ALERT_HEADER_BYTES;
+}
+
+void sort_events(std::vector<DecodedEvent>* events) {
+    std::stable_sort(events->begin(), events->end(),
+                     [](const DecodedEvent& a, const DecodedEvent& b) { return a.sequence < b.sequence; });
+    events->erase(std::unique(events->begin(), events->end(),
+                              [](const DecodedEvent& a, const DecodedEvent& b) {
+                                  return a.sequence == b.sequence;
+                              }),
+                  events->end());
+}
+
+uint64_t count_missing_events(const std::vector<DecodedEvent>& events) {
+    uint64_t missing = 0;
+    for (size_t i = 1; i < events.size(); ++i) {
+        if (events[i].sequence > events[i - 1].sequence + 1) {
+            missing += events[i].sequence - events[i - 1].sequence - 1;
+        }
+    }
+    return missing;
+}
+
+DecisionRecord event_to_decision_record(
+    const DecodedEvent& event,
+    uint16_t node_id,
+    const core::ThresholdConfig& config
+) {
+    DecisionRecord record;
+    record.time_s = event.event.time_s;
+    record.node_id = node_id;
+    record.battery_mv = event.event.battery_mv;
+    record.dominant_frequency = 0;
+    record.peak_magnitude = 0;
+    record.num_peaks = 0;
+    record.predicted_class = core::event_predicted_class(event.event);
+    record.confidence = static_cast<fixed_t>(
+        (static_cast<int64_t>(event.event.confidence_pct) * FIXED_ONE + 50) / 100);
+    record.threshold = core::get_effective_threshold(event.event.battery_mv, config);
+    record.decision = core::event_decision(event.event);
+    record.reason = core::event_reason(event.event);
+    return record;
+}
+
+} // namespace host
+} // namespace spectral_gate
@@ -0,0 +1,110 @@
+#ifndef EVENT_DECODER_H
+#define EVENT_DECODER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "core/event_ring.h"
+#include "decision_log.h"
+
+namespace spectral_gate {
+namespace host {
+
+/**
+ * @brief One event recovered from a batch, with its ring sequence number
+ */
+struct DecodedEvent {
+    uint32_t sequence;
+    core::EventRecord event;
+};
+
+/**
+ * @brief Fixed part of an alert frame
+ */
+struct AlertFrame {
+    uint8_t alert_type;
+    uint8_t confidence;
+    uint32_t time_s;
+};
+
+/**
+ * @brief Counters from decoding a flash dump or radio capture
+ */
+struct EventDecodeStats {
+    size_t batches;
+    uint64_t events;
+    size_t padding_bytes;       // Erased-flash 0xFF bytes skipped
+};
+
+/**
+ * @brief Decode one event batch (core::EventRing::encode_batch format)
+ * @param consumed Receives the batch length in bytes
+ * @param events Decoded events are appended here
+ * @return false if the data does not start with a complete batch
+ */
+bool decode_event_batch(
+    const uint8_t* data,
+    size_t length,
+    size_t* consumed,
+    std::vector<DecodedEvent>* events
+);
+
+/**
+ * @brief Decode a flash event log dump: batches separated by 0xFF padding
+ *
+ * A radio capture (the batches of received frames, concatenated) has
+ * the same layout. Decoding stops at the first byte that is neither
+ * padding nor the start of a complete batch (a torn final write, or
+ * corruption); everything before it is kept.
+ *
+ * @param stats Optional counters
+ * @return true if the whole dump was consumed
+ */
+bool decode_event_log(
+    const uint8_t* data,
+    size_t length,
+    std::vector<DecodedEvent>* events,
+    EventDecodeStats* stats
+);
+
+/**
+ * @brief Decode an alert frame and any events piggybacked on it
+ * @return false if the frame is not an event-carrying alert frame or
+ *         its batch is malformed
+ */
+bool decode_alert_frame(
+    const uint8_t* frame,
+    size_t length,
+    AlertFrame* alert,
+    std::vector<DecodedEvent>* events
+);
+
+/**
+ * @brief Sort events by sequence and drop duplicates (a batch that was
+ *        both received over the radio and found in flash)
+ */
+void sort_events(std::vector<DecodedEvent>* events);
+
+/**
+ * @brief Events missing from a sequence-ordered list: overwritten in the
+ *        ring before delivery, or carried by a frame that was not received
+ */
+uint64_t count_missing_events(const std::vector<DecodedEvent>& events);
+
+/**
+ * @brief Expand an event into a decision log record
+ *
+ * The node does not ship spectral features or its threshold, so the
+ * feature summary is zero and the threshold is derived from config and
+ * the recorded battery voltage.
+ */
+DecisionRecord event_to_decision_record(
+    const DecodedEvent& event,
+    uint16_t node_id,
+    const core::ThresholdConfig& config
+);
+
+} // namespace host
+} // namespace spectral_gate
+
+#endif // EVENT_DECODER_H
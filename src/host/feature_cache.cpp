@@ -0,0 +1,352 @@
+#include "feature_cache.h"
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SG_FEATURE_CACHE_POSIX 1
+#endif
+
+namespace spectral_gate {
+namespace host {
+
+using namespace hal;
+
+namespace {
+    constexpr char CACHE_MAGIC[4] = {'S', 'G', 'F', 'C'};
+    constexpr uint16_t CACHE_VERSION = 1;
+    constexpr size_t HEADER_SIZE = 16;
+
+    // Record: window hash, config hash, SpectralResult (3 x i32, u8 + pad),
+    // feature count, payload checksum, then the features as i32
+    constexpr size_t RECORD_HEADER_SIZE = 40;
+
+    // Sanity bound so a corrupt count cannot run past the file
+    constexpr uint32_t MAX_RECORD_FEATURES = 4096;
+
+    // Changes whenever the spectral kernels change their output
+    constexpr uint32_t FEATURE_FORMAT_VERSION = 1;
+
+    void put_u32(uint8_t* p, uint32_t v) {
+        for (int i = 0; i < 4; ++i) p[i] = static_cast<uint8_t>((v >> (8 * i)) & 0xFF);
+    }
+
+    void put_u64(uint8_t* p, uint64_t v) {
+        for (int i = 0; i < 8; ++i) p[i] = static_cast<uint8_t>((v >> (8 * i)) & 0xFF);
+    }
+
+    uint32_t get_u32(const uint8_t* p) {
+        return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+               (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    uint64_t get_u64(const uint8_t* p) {
+        return static_cast<uint64_t>(get_u32(p)) | (static_cast<uint64_t>(get_u32(p + 4)) << 32);
+    }
+
+    // FNV-1a 32 over the record body after the checksum field's position
+    uint32_t checksum(const uint8_t* data, size_t length) {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < length; ++i) {
+            hash ^= data[i];
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    void mix64(uint64_t* hash, uint8_t byte) {
+        *hash ^= byte;
+        *hash *= 1099511628211ull;
+    }
+}
+
+uint64_t hash_window(const int16_t* samples, size_t num_samples) {
+    uint64_t hash = 14695981039346656037ull;
+    for (int shift = 0; shift < 64; shift += 8) {
+        mix64(&hash, static_cast<uint8_t>(static_cast<uint64_t>(num_samples) >> shift));
+    }
+    for (size_t i = 0; i < num_samples; ++i) {
+        uint16_t v = static_cast<uint16_t>(samples[i]);
+        mix64(&hash, static_cast<uint8_t>(v & 0xFF));
+        mix64(&hash, static_cast<uint8_t>(v >> 8));
+    }
+    return hash;
+}
+
+uint64_t hash_spectral_config(const core::SpectralProcessor& processor) {
+    uint64_t hash = 14695981039346656037ull;
+    const uint32_t words[] = {
+        FEATURE_FORMAT_VERSION,
+        static_cast<uint32_t>(processor.get_num_bins()),
+        processor.get_sample_rate()
+    };
+    for (uint32_t word : words) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            mix64(&hash, static_cast<uint8_t>(word >> shift));
+        }
+    }
+    return hash;
+}
+
+FeatureCache::FeatureCache()
+    : fd_(-1),
+      map_(nullptr),
+      map_length_(0),
+      file_length_(0),
+      stats_{0, 0, 0}
+{
+}
+
+FeatureCache::~FeatureCache() {
+    close();
+}
+
+#if defined(SG_FEATURE_CACHE_POSIX)
+
+bool FeatureCache::remap(size_t length) {
+    unmap();
+    if (length == 0) {
+        return true;
+    }
+    void* map = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd_, 0);
+    if (map == MAP_FAILED) {
+        return false;
+    }
+    map_ = static_cast<const uint8_t*>(map);
+    map_length_ = length;
+    return true;
+}
+
+void FeatureCache::unmap() {
+    if (map_ != nullptr) {
+        munmap(const_cast<uint8_t*>(map_), map_length_);
+        map_ = nullptr;
+        map_length_ = 0;
+    }
+}
+
+bool FeatureCache::open(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ >= 0) {
+        return false;
+    }
+
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd_ < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd_, &st) != 0) {
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+    file_length_ = static_cast<size_t>(st.st_size);
+
+    if (file_length_ == 0) {
+        uint8_t header[HEADER_SIZE] = {};
+        std::memcpy(header, CACHE_MAGIC, 4);
+        header[4] = static_cast<uint8_t>(CACHE_VERSION & 0xFF);
+        header[5] = static_cast<uint8_t>(CACHE_VERSION >> 8);
+        if (pwrite(fd_, header, HEADER_SIZE, 0) != static_cast<ssize_t>(HEADER_SIZE)) {
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+        file_length_ = HEADER_SIZE;
+    }
+
+    if (file_length_ < HEADER_SIZE || !remap(file_length_) ||
+        std::memcmp(map_, CACHE_MAGIC, 4) != 0 ||
+        (map_[4] | (map_[5] << 8)) != CACHE_VERSION) {
+        unmap();
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    // Rebuild the index; stop at the first torn or corrupt record
+    size_t offset = HEADER_SIZE;
+    while (offset + RECORD_HEADER_SIZE <= file_length_) {
+        const uint8_t* record = map_ + offset;
+        uint32_t count = get_u32(record + 32);
+        size_t length = RECORD_HEADER_SIZE + static_cast<size_t>(count) * 4;
+        if (count > MAX_RECORD_FEATURES || offset + length > file_length_) {
+            break;
+        }
+        uint32_t expected = checksum(record, 36) ^ checksum(record + RECORD_HEADER_SIZE, length - RECORD_HEADER_SIZE);
+        if (get_u32(record + 36) != expected) {
+            break;
+        }
+        index_[Key{get_u64(record), get_u64(record + 8)}] = offset;
+        offset += length;
+    }
+    if (offset != file_length_) {
+        if (ftruncate(fd_, static_cast<off_t>(offset)) != 0) {
+            unmap();
+            ::close(fd_);
+            fd_ = -1;
+            index_.clear();
+            return false;
+        }
+        file_length_ = offset;
+        remap(file_length_);
+    }
+    return true;
+}
+
+void FeatureCache::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    unmap();
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    index_.clear();
+    file_length_ = 0;
+}
+
+bool FeatureCache::lookup(
+    uint64_t window_hash,
+    uint64_t config_hash,
+    core::SpectralResult* spectral,
+    fixed_t* features,
+    size_t max_features,
+    size_t* num_features
+) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(Key{window_hash, config_hash});
+    if (it == index_.end()) {
+        ++stats_.misses;
+        return false;
+    }
+
+    size_t offset = it->second;
+    if (offset + RECORD_HEADER_SIZE > map_length_) {
+        // Appended since the last mapping
+        if (!remap(file_length_)) {
+            ++stats_.misses;
+            return false;
+        }
+    }
+    const uint8_t* record = map_ + offset;
+    uint32_t count = get_u32(record + 32);
+    if (count > max_features || offset + RECORD_HEADER_SIZE + count * 4 > map_length_) {
+        ++stats_.misses;
+        return false;
+    }
+
+    spectral->dominant_frequency = static_cast<fixed_t>(get_u32(record + 16));
+    spectral->peak_magnitude = static_cast<fixed_t>(get_u32(record + 20));
+    spectral->spectral_centroid = static_cast<fixed_t>(get_u32(record + 24));
+    spectral->num_peaks = record[28];
+    const uint8_t* payload = record + RECORD_HEADER_SIZE;
+    for (uint32_t i = 0; i < count; ++i) {
+        features[i] = static_cast<fixed_t>(get_u32(payload + 4 * i));
+    }
+    *num_features = count;
+    ++stats_.hits;
+    return true;
+}
+
+bool FeatureCache::insert(
+    uint64_t window_hash,
+    uint64_t config_hash,
+    const core::SpectralResult& spectral,
+    const fixed_t* features,
+    size_t num_features
+) {
+    if (num_features > MAX_RECORD_FEATURES) {
+        return false;
+    }
+
+    std::vector<uint8_t> record(RECORD_HEADER_SIZE + num_features * 4, 0);
+    put_u64(&record[0], window_hash);
+    put_u64(&record[8], config_hash);
+    put_u32(&record[16], static_cast<uint32_t>(spectral.dominant_frequency));
+    put_u32(&record[20], static_cast<uint32_t>(spectral.peak_magnitude));
+    put_u32(&record[24], static_cast<uint32_t>(spectral.spectral_centroid));
+    record[28] = spectral.num_peaks;
+    put_u32(&record[32], static_cast<uint32_t>(num_features));
+    for (size_t i = 0; i < num_features; ++i) {
+        put_u32(&record[RECORD_HEADER_SIZE + 4 * i], static_cast<uint32_t>(features[i]));
+    }
+    put_u32(&record[36], checksum(record.data(), 36) ^
+                         checksum(record.data() + RECORD_HEADER_SIZE, num_features * 4));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ < 0) {
+        return false;
+    }
+    Key key{window_hash, config_hash};
+    if (index_.count(key) != 0) {
+        return true;
+    }
+    if (pwrite(fd_, record.data(), record.size(), static_cast<off_t>(file_length_)) !=
+        static_cast<ssize_t>(record.size())) {
+        return false;
+    }
+    index_[key] = file_length_;
+    file_length_ += record.size();
+    ++stats_.appends;
+    return true;
+}
+
+#else
+
+bool FeatureCache::remap(size_t) { return false; }
+void FeatureCache::unmap() {}
+bool FeatureCache::open(const std::string&) { return false; }
+void FeatureCache::close() {}
+
+bool FeatureCache::lookup(uint64_t, uint64_t, core::SpectralResult*, fixed_t*, size_t, size_t*) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.misses;
+    return false;
+}
+
+bool FeatureCache::insert(uint64_t, uint64_t, const core::SpectralResult&, const fixed_t*, size_t) {
+    return false;
+}
+
+#endif
+
+size_t FeatureCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_.size();
+}
+
+FeatureCacheStats FeatureCache::get_stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+core::SpectralResult process_with_features_cached(
+    FeatureCache* cache,
+    core::SpectralProcessor& processor,
+    const int16_t* samples,
+    size_t num_samples,
+    fixed_t* features,
+    size_t max_features,
+    size_t* num_features
+) {
+    if (cache == nullptr) {
+        return processor.process_with_features(samples, num_samples, features, max_features, num_features);
+    }
+
+    uint64_t window_hash = hash_window(samples, num_samples);
+    uint64_t config_hash = hash_spectral_config(processor);
+    core::SpectralResult result;
+    if (cache->lookup(window_hash, config_hash, &result, features, max_features, num_features)) {
+        return result;
+    }
+    result = processor.process_with_features(samples, num_samples, features, max_features, num_features);
+    cache->insert(window_hash, config_hash, result, features, *num_features);
+    return result;
+}
+
+} // namespace host
+} // namespace spectral_gate
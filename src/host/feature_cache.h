@@ -0,0 +1,138 @@
+#ifndef FEATURE_CACHE_H
+#define FEATURE_CACHE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "hal/hal_interface.h"
+#include "core/decision.h"
+#include "core/spectral.h"
+
+namespace spectral_gate {
+namespace host {
+
+/**
+ * @brief FNV-1a 64 over a window's samples (and its length)
+ */
+uint64_t hash_window(const int16_t* samples, size_t num_samples);
+
+/**
+ * @brief Hash of everything besides the samples that determines the
+ *        features: bin count, sample rate and the feature format version
+ *
+ * Bump FEATURE_FORMAT_VERSION in feature_cache.cpp whenever the spectral
+ * kernels change their output, so stale entries stop matching.
+ */
+uint64_t hash_spectral_config(const core::SpectralProcessor& processor);
+
+struct FeatureCacheStats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t appends;
+};
+
+/**
+ * @brief On-disk cache of spectral outputs keyed by window content
+ *
+ * The file is append-only: a 16-byte header, then one record per window
+ * holding the key, the SpectralResult and the feature vector from
+ * process_with_features(). Reads go through a read-only mmap of the
+ * file; the hash index (key -> record offset) is rebuilt by scanning the
+ * records on open, and a torn record at the tail is cut off. Safe to
+ * share between threads. Desktop (POSIX) builds only.
+ */
+class FeatureCache {
+public:
+    FeatureCache();
+    ~FeatureCache();
+
+    FeatureCache(const FeatureCache&) = delete;
+    FeatureCache& operator=(const FeatureCache&) = delete;
+
+    /**
+     * @brief Open or create a cache file
+     * @return false if the file cannot be opened or is not a cache
+     */
+    bool open(const std::string& path);
+
+    void close();
+
+    /**
+     * @brief Find the outputs for a window
+     * @param num_features Receives the stored feature count
+     * @return false on a miss (or if max_features is too small)
+     */
+    bool lookup(
+        uint64_t window_hash,
+        uint64_t config_hash,
+        core::SpectralResult* spectral,
+        hal::fixed_t* features,
+        size_t max_features,
+        size_t* num_features
+    );
+
+    /**
+     * @brief Append a record (no-op if the key is already present)
+     * @return false on a write error
+     */
+    bool insert(
+        uint64_t window_hash,
+        uint64_t config_hash,
+        const core::SpectralResult& spectral,
+        const hal::fixed_t* features,
+        size_t num_features
+    );
+
+    size_t size() const;
+
+    FeatureCacheStats get_stats() const;
+
+private:
+    struct Key {
+        uint64_t window_hash;
+        uint64_t config_hash;
+        bool operator==(const Key& other) const {
+            return window_hash == other.window_hash && config_hash == other.config_hash;
+        }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            return static_cast<size_t>(key.window_hash ^ (key.config_hash * 0x9E3779B97F4A7C15ull));
+        }
+    };
+
+    bool remap(size_t length);
+    void unmap();
+
+    mutable std::mutex mutex_;
+    int fd_;
+    const uint8_t* map_;
+    size_t map_length_;
+    size_t file_length_;
+    std::unordered_map<Key, size_t, KeyHash> index_;
+    FeatureCacheStats stats_;
+};
+
+/**
+ * @brief process_with_features() through the cache
+ *
+ * On a hit the spectral stage is skipped; on a miss the window is
+ * processed and appended. A null cache processes directly.
+ */
+core::SpectralResult process_with_features_cached(
+    FeatureCache* cache,
+    core::SpectralProcessor& processor,
+    const int16_t* samples,
+    size_t num_samples,
+    hal::fixed_t* features,
+    size_t max_features,
+    size_t* num_features
+);
+
+} // namespace host
+} // namespace spectral_gate
+
+#endif // FEATURE_CACHE_H
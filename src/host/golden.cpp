@@ -0,0 +1,432 @@
+#include "golden.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include "core/pipeline.h"
+
+namespace spectral_gate {
+namespace host {
+
+namespace {
+    constexpr const char* CORPUS_MAGIC = "spectral_gate_golden";
+    constexpr int CORPUS_VERSION = 1;
+
+    // Feature buffer budget, as on device
+    constexpr size_t MAX_FEATURES = core::WindowPipeline::MAX_FEATURES;
+
+    uint32_t field_bit(GoldenField field) {
+        return 1u << static_cast<uint32_t>(field);
+    }
+
+    constexpr uint32_t ALL_FIELDS = (1u << NUM_GOLDEN_FIELDS) - 1;
+    constexpr uint32_t SPECTRAL_FIELDS = 0x0Fu;     // Frequency, magnitude, centroid, peaks
+
+    bool expect(std::istream& in, const char* keyword) {
+        std::string token;
+        return (in >> token) && token == keyword;
+    }
+
+    // Reference and scalar path share the same calls, kept in one place
+    GoldenOutputs run_reference(
+        const int16_t* samples,
+        size_t num_samples,
+        uint16_t battery_mv,
+        core::SpectralProcessor& spectral,
+        core::InferenceEngine& engine,
+        const core::ThresholdConfig& config
+    ) {
+        GoldenOutputs out;
+        out.fields = ALL_FIELDS;
+        out.spectral = spectral.process(samples, num_samples);
+
+        hal::fixed_t features[MAX_FEATURES];
+        size_t n = spectral.extract_features(samples, num_samples, features, MAX_FEATURES);
+        out.features.assign(features, features + n);
+
+        out.inference = engine.run(features, n);
+        out.decision = core::evaluate_structure(out.spectral, out.inference, battery_mv, config);
+        return out;
+    }
+
+    void run_scalar(const GoldenCorpus& corpus, std::vector<GoldenOutputs>* outputs) {
+        core::SpectralProcessor spectral(corpus.num_bins, corpus.sample_rate);
+        core::InferenceEngine engine = core::create_default_engine();
+        core::ThresholdConfig config = core::get_default_config();
+        for (const auto& c : corpus.cases) {
+            outputs->push_back(run_reference(c.samples.data(), c.samples.size(), c.battery_mv,
+                                             spectral, engine, config));
+        }
+    }
+
+    void run_fused(const GoldenCorpus& corpus, std::vector<GoldenOutputs>* outputs) {
+        core::SpectralProcessor spectral(corpus.num_bins, corpus.sample_rate);
+        core::InferenceEngine engine = core::create_default_engine();
+        core::ThresholdConfig config = core::get_default_config();
+        for (const auto& c : corpus.cases) {
+            GoldenOutputs out;
+            out.fields = ALL_FIELDS;
+            hal::fixed_t features[MAX_FEATURES];
+            size_t n = 0;
+            out.spectral = spectral.process_with_features(c.samples.data(), c.samples.size(),
+                                                          features, MAX_FEATURES, &n);
+            out.features.assign(features, features + n);
+            out.inference = engine.run(features, n);
+            out.decision = core::evaluate_structure(out.spectral, out.inference, c.battery_mv, config);
+            outputs->push_back(out);
+        }
+    }
+
+    void run_pipeline(const GoldenCorpus& corpus, std::vector<GoldenOutputs>* outputs) {
+        core::SpectralProcessor spectral(corpus.num_bins, corpus.sample_rate);
+        core::InferenceEngine engine = core::create_default_engine();
+        core::WindowPipeline pipeline(spectral, engine, core::get_default_config());
+        for (const auto& c : corpus.cases) {
+            // No pre-filter attached, so samples are not modified
+            std::vector<int16_t> samples = c.samples;
+            core::WindowOutcome outcome = pipeline.process_window(samples.data(), samples.size(),
+                                                                  c.battery_mv);
+            GoldenOutputs out;
+            out.fields = ALL_FIELDS & ~field_bit(GoldenField::FEATURES);
+            out.spectral = outcome.spectral;
+            out.inference = outcome.inference;
+            out.decision = outcome.decision;
+            outputs->push_back(out);
+        }
+    }
+
+    void run_batched(const GoldenCorpus& corpus, std::vector<GoldenOutputs>* outputs) {
+        core::SpectralProcessor spectral(corpus.num_bins, corpus.sample_rate);
+        core::InferenceEngine engine = core::create_default_engine();
+        core::ThresholdConfig config = core::get_default_config();
+
+        // Cases of equal feature length are batched together, in order
+        size_t begin = 0;
+        while (begin < corpus.cases.size()) {
+            std::vector<hal::fixed_t> batch_features;
+            std::vector<core::SpectralResult> batch_spectral;
+            size_t width = 0;
+            size_t end = begin;
+            for (; end < corpus.cases.size(); ++end) {
+                const GoldenCase& c = corpus.cases[end];
+                hal::fixed_t features[MAX_FEATURES];
+                size_t n = spectral.extract_features(c.samples.data(), c.samples.size(),
+                                                     features, MAX_FEATURES);
+                if (end > begin && n != width) {
+                    break;
+                }
+                width = n;
+                batch_features.insert(batch_features.end(), features, features + n);
+                batch_spectral.push_back(spectral.process(c.samples.data(), c.samples.size()));
+            }
+
+            std::vector<core::InferenceResult> results(end - begin);
+            engine.run_batch(batch_features.data(), width, end - begin, results.data());
+            for (size_t i = 0; i < end - begin; ++i) {
+                GoldenOutputs out;
+                out.fields = ALL_FIELDS;
+                out.spectral = batch_spectral[i];
+                out.features.assign(batch_features.begin() + i * width,
+                                    batch_features.begin() + (i + 1) * width);
+                out.inference = results[i];
+                out.decision = core::evaluate_structure(out.spectral, out.inference,
+                                                        corpus.cases[begin + i].battery_mv, config);
+                outputs->push_back(out);
+            }
+            begin = end;
+        }
+    }
+
+    // Window replicated on all axes: every axis must match the single-axis
+    // golden result, and the X feature block must match its features
+    void run_frames(const GoldenCorpus& corpus, std::vector<GoldenOutputs>* outputs) {
+        core::SpectralProcessor spectral(corpus.num_bins, corpus.sample_rate);
+        for (const auto& c : corpus.cases) {
+            std::vector<int16_t> frames(c.samples.size() * hal::NUM_AXES);
+            for (size_t i = 0; i < c.samples.size(); ++i) {
+                for (size_t a = 0; a < hal::NUM_AXES; ++a) {
+                    frames[i * hal::NUM_AXES + a] = c.samples[i];
+                }
+            }
+            core::MultiAxisResult multi = spectral.process_frames(frames.data(), c.samples.size());
+
+            GoldenOutputs out;
+            out.fields = SPECTRAL_FIELDS | field_bit(GoldenField::FEATURES);
+            // Report the first axis that disagrees (X if none)
+            out.spectral = multi.axes[0];
+            for (size_t a = 0; a < hal::NUM_AXES; ++a) {
+                const core::SpectralResult& r = multi.axes[a];
+                if (r.dominant_frequency != c.spectral.dominant_frequency ||
+                    r.peak_magnitude != c.spectral.peak_magnitude ||
+                    r.spectral_centroid != c.spectral.spectral_centroid ||
+                    r.num_peaks != c.spectral.num_peaks) {
+                    out.spectral = r;
+                    break;
+                }
+            }
+
+            std::vector<hal::fixed_t> features((hal::NUM_AXES + 1) * MAX_FEATURES);
+            size_t n = spectral.extract_frame_features(frames.data(), c.samples.size(),
+                                                       features.data(), features.size());
+            size_t block = n / (hal::NUM_AXES + 1);
+            out.features.assign(features.begin(), features.begin() + block);
+            out.inference = core::InferenceResult{0, 0};
+            out.decision = core::Decision::SLEEP;
+            outputs->push_back(out);
+        }
+    }
+
+    void note(GoldenFieldReport* report, int64_t diff, int64_t tolerance, const std::string& name) {
+        ++report->compared;
+        if (diff > tolerance) {
+            ++report->mismatches;
+        }
+        if (diff > report->max_abs_diff) {
+            report->max_abs_diff = diff;
+            report->worst_case = name;
+        }
+    }
+}
+
+const char* golden_field_name(GoldenField field) {
+    switch (field) {
+        case GoldenField::DOMINANT_FREQUENCY: return "dominant_frequency";
+        case GoldenField::PEAK_MAGNITUDE:     return "peak_magnitude";
+        case GoldenField::SPECTRAL_CENTROID:  return "spectral_centroid";
+        case GoldenField::NUM_PEAKS:          return "num_peaks";
+        case GoldenField::FEATURES:           return "features";
+        case GoldenField::CONFIDENCE:         return "confidence";
+        case GoldenField::PREDICTED_CLASS:    return "predicted_class";
+        case GoldenField::DECISION:           return "decision";
+    }
+    return "?";
+}
+
+bool load_golden_corpus(const std::string& path, GoldenCorpus* corpus) {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+
+    int version = 0;
+    size_t num_cases = 0;
+    if (!expect(in, CORPUS_MAGIC) || !(in >> version) || version != CORPUS_VERSION ||
+        !expect(in, "bins") || !(in >> corpus->num_bins) ||
+        !expect(in, "sample_rate") || !(in >> corpus->sample_rate) ||
+        !expect(in, "model") || !(in >> std::hex >> corpus->model_checksum >> std::dec) ||
+        !expect(in, "cases") || !(in >> num_cases)) {
+        return false;
+    }
+
+    corpus->cases.clear();
+    corpus->cases.reserve(num_cases);
+    for (size_t k = 0; k < num_cases; ++k) {
+        GoldenCase c;
+        size_t num_samples = 0;
+        size_t num_features = 0;
+        int num_peaks = 0;
+        int predicted_class = 0;
+        int decision = 0;
+
+        if (!expect(in, "case") || !(in >> c.name >> c.battery_mv >> num_samples) ||
+            !expect(in, "samples")) {
+            return false;
+        }
+        c.samples.resize(num_samples);
+        for (auto& s : c.samples) {
+            if (!(in >> s)) return false;
+        }
+
+        if (!expect(in, "spectral") ||
+            !(in >> c.spectral.dominant_frequency >> c.spectral.peak_magnitude
+                 >> c.spectral.spectral_centroid >> num_peaks) ||
+            !expect(in, "features") || !(in >> num_features)) {
+            return false;
+        }
+        c.spectral.num_peaks = static_cast<uint8_t>(num_peaks);
+        c.features.resize(num_features);
+        for (auto& f : c.features) {
+            if (!(in >> f)) return false;
+        }
+
+        if (!expect(in, "inference") || !(in >> predicted_class >> c.inference.confidence) ||
+            !expect(in, "decision") || !(in >> decision)) {
+            return false;
+        }
+        c.inference.predicted_class = static_cast<uint8_t>(predicted_class);
+        c.decision = static_cast<core::Decision>(decision);
+        corpus->cases.push_back(std::move(c));
+    }
+    return true;
+}
+
+bool save_golden_corpus(const std::string& path, const GoldenCorpus& corpus) {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+
+    out << CORPUS_MAGIC << " " << CORPUS_VERSION << "\n";
+    out << "bins " << corpus.num_bins << "\n";
+    out << "sample_rate " << corpus.sample_rate << "\n";
+    out << "model " << std::hex << std::setw(8) << std::setfill('0') << corpus.model_checksum
+        << std::dec << std::setfill(' ') << "\n";
+    out << "cases " << corpus.cases.size() << "\n";
+
+    for (const auto& c : corpus.cases) {
+        out << "\ncase " << c.name << " " << c.battery_mv << " " << c.samples.size() << "\n";
+        out << "samples";
+        for (size_t i = 0; i < c.samples.size(); ++i) {
+            out << ((i % 16 == 0) ? "\n " : " ") << c.samples[i];
+        }
+        out << "\nspectral " << c.spectral.dominant_frequency << " " << c.spectral.peak_magnitude
+            << " " << c.spectral.spectral_centroid << " "
+            << static_cast<int>(c.spectral.num_peaks) << "\n";
+        out << "features " << c.features.size();
+        for (size_t i = 0; i < c.features.size(); ++i) {
+            out << ((i % 8 == 0) ? "\n " : " ") << c.features[i];
+        }
+        out << "\ninference " << static_cast<int>(c.inference.predicted_class) << " "
+            << c.inference.confidence << "\n";
+        out << "decision " << static_cast<int>(c.decision) << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+GoldenCase make_golden_case(
+    const std::string& name,
+    const int16_t* samples,
+    size_t num_samples,
+    uint16_t battery_mv,
+    core::SpectralProcessor& spectral,
+    core::InferenceEngine& engine,
+    const core::ThresholdConfig& config
+) {
+    GoldenOutputs ref = run_reference(samples, num_samples, battery_mv, spectral, engine, config);
+
+    GoldenCase c;
+    c.name = name;
+    c.battery_mv = battery_mv;
+    c.samples.assign(samples, samples + num_samples);
+    c.spectral = ref.spectral;
+    c.features = ref.features;
+    c.inference = ref.inference;
+    c.decision = ref.decision;
+    return c;
+}
+
+std::vector<GoldenVariant> get_golden_variants() {
+    return {
+        {"scalar", run_scalar},
+        {"fused", run_fused},
+        {"pipeline", run_pipeline},
+        {"batched", run_batched},
+        {"frames", run_frames},
+    };
+}
+
+GoldenTolerance get_exact_tolerance() {
+    return GoldenTolerance{0, 0, 0, 0};
+}
+
+GoldenVariantReport check_golden_variant(
+    const GoldenCorpus& corpus,
+    const GoldenVariant& variant,
+    const GoldenTolerance& tolerance
+) {
+    GoldenVariantReport report;
+    report.variant = variant.name;
+    for (auto& f : report.fields) {
+        f = GoldenFieldReport{0, 0, 0, std::string()};
+    }
+
+    std::vector<GoldenOutputs> outputs;
+    outputs.reserve(corpus.cases.size());
+    variant.run(corpus, &outputs);
+    report.passed = (outputs.size() == corpus.cases.size());
+
+    for (size_t k = 0; k < corpus.cases.size() && k < outputs.size(); ++k) {
+        const GoldenCase& want = corpus.cases[k];
+        const GoldenOutputs& got = outputs[k];
+        auto has = [&got](GoldenField field) { return (got.fields & field_bit(field)) != 0; };
+        auto field = [&report](GoldenField f) { return &report.fields[static_cast<size_t>(f)]; };
+        auto diff = [](int64_t a, int64_t b) { return (a > b) ? a - b : b - a; };
+
+        if (has(GoldenField::DOMINANT_FREQUENCY)) {
+            note(field(GoldenField::DOMINANT_FREQUENCY),
+                 diff(got.spectral.dominant_frequency, want.spectral.dominant_frequency),
+                 tolerance.spectral_lsb, want.name);
+        }
+        if (has(GoldenField::PEAK_MAGNITUDE)) {
+            note(field(GoldenField::PEAK_MAGNITUDE),
+                 diff(got.spectral.peak_magnitude, want.spectral.peak_magnitude),
+                 tolerance.spectral_lsb, want.name);
+        }
+        if (has(GoldenField::SPECTRAL_CENTROID)) {
+            note(field(GoldenField::SPECTRAL_CENTROID),
+                 diff(got.spectral.spectral_centroid, want.spectral.spectral_centroid),
+                 tolerance.spectral_lsb, want.name);
+        }
+        if (has(GoldenField::NUM_PEAKS)) {
+            note(field(GoldenField::NUM_PEAKS),
+                 diff(got.spectral.num_peaks, want.spectral.num_peaks),
+                 tolerance.num_peaks, want.name);
+        }
+        if (has(GoldenField::FEATURES)) {
+            // A length mismatch counts as a mismatch on its own
+            int64_t worst = (got.features.size() == want.features.size()) ? 0 : INT64_MAX;
+            size_t n = std::min(got.features.size(), want.features.size());
+            for (size_t i = 0; i < n; ++i) {
+                worst = std::max(worst, diff(got.features[i], want.features[i]));
+            }
+            note(field(GoldenField::FEATURES), worst, tolerance.feature_lsb, want.name);
+        }
+        if (has(GoldenField::CONFIDENCE)) {
+            note(field(GoldenField::CONFIDENCE),
+                 diff(got.inference.confidence, want.inference.confidence),
+                 tolerance.confidence_lsb, want.name);
+        }
+        if (has(GoldenField::PREDICTED_CLASS)) {
+            note(field(GoldenField::PREDICTED_CLASS),
+                 diff(got.inference.predicted_class, want.inference.predicted_class),
+                 0, want.name);
+        }
+        if (has(GoldenField::DECISION)) {
+            note(field(GoldenField::DECISION),
+                 diff(static_cast<int64_t>(got.decision), static_cast<int64_t>(want.decision)),
+                 0, want.name);
+        }
+    }
+
+    for (const auto& f : report.fields) {
+        if (f.mismatches != 0) {
+            report.passed = false;
+        }
+    }
+    return report;
+}
+
+void print_golden_reports(std::ostream& os, const std::vector<GoldenVariantReport>& reports) {
+    for (const auto& r : reports) {
+        os << r.variant << ": " << (r.passed ? "PASS" : "FAIL") << "\n";
+        for (size_t f = 0; f < NUM_GOLDEN_FIELDS; ++f) {
+            const GoldenFieldReport& field = r.fields[f];
+            os << "  " << std::left << std::setw(20)
+               << golden_field_name(static_cast<GoldenField>(f)) << std::right;
+            if (field.compared == 0) {
+                os << "  n/a\n";
+                continue;
+            }
+            os << std::setw(6) << field.compared << " compared"
+               << std::setw(6) << field.mismatches << " mismatched"
+               << "  max |diff| " << field.max_abs_diff;
+            if (!field.worst_case.empty()) {
+                os << " (" << field.worst_case << ")";
+            }
+            os << "\n";
+        }
+    }
+}
+
+} // namespace host
+} // namespace spectral_gate
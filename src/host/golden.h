@@ -0,0 +1,169 @@
+#ifndef GOLDEN_H
+#define GOLDEN_H
+
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "hal/hal_interface.h"
+#include "core/decision.h"
+#include "core/inference.h"
+#include "core/spectral.h"
+
+namespace spectral_gate {
+namespace host {
+
+/**
+ * @brief One golden vector: an input window and the outputs the reference
+ *        (scalar) path produced for it
+ */
+struct GoldenCase {
+    std::string name;
+    uint16_t battery_mv;
+    std::vector<int16_t> samples;
+    core::SpectralResult spectral;
+    std::vector<hal::fixed_t> features;
+    core::InferenceResult inference;
+    core::Decision decision;
+};
+
+/**
+ * @brief Golden-vector corpus with the settings it was generated under
+ */
+struct GoldenCorpus {
+    size_t num_bins;
+    uint32_t sample_rate;
+    uint32_t model_checksum;    // InferenceEngine::get_model_checksum()
+    std::vector<GoldenCase> cases;
+};
+
+/**
+ * @brief Load a corpus written by save_golden_corpus()
+ * @return false if the file is missing or malformed
+ */
+bool load_golden_corpus(const std::string& path, GoldenCorpus* corpus);
+
+/**
+ * @brief Write a corpus as line-oriented text (diffable in review)
+ * @return true on success
+ */
+bool save_golden_corpus(const std::string& path, const GoldenCorpus& corpus);
+
+/**
+ * @brief Run the reference path on one window and record its outputs
+ *
+ * Reference = SpectralProcessor::process(), extract_features(),
+ * InferenceEngine::run() and evaluate_structure(), called separately.
+ */
+GoldenCase make_golden_case(
+    const std::string& name,
+    const int16_t* samples,
+    size_t num_samples,
+    uint16_t battery_mv,
+    core::SpectralProcessor& spectral,
+    core::InferenceEngine& engine,
+    const core::ThresholdConfig& config
+);
+
+/**
+ * @brief Fields compared by the differential runner
+ */
+enum class GoldenField : uint8_t {
+    DOMINANT_FREQUENCY = 0,
+    PEAK_MAGNITUDE,
+    SPECTRAL_CENTROID,
+    NUM_PEAKS,
+    FEATURES,
+    CONFIDENCE,
+    PREDICTED_CLASS,
+    DECISION
+};
+
+constexpr size_t NUM_GOLDEN_FIELDS = 8;
+
+const char* golden_field_name(GoldenField field);
+
+/**
+ * @brief What one kernel variant produced for one case
+ *
+ * Variants that do not expose a field (e.g. the pipeline has no feature
+ * output) leave its bit clear in `fields`.
+ */
+struct GoldenOutputs {
+    uint32_t fields;            // Bit per GoldenField
+    core::SpectralResult spectral;
+    std::vector<hal::fixed_t> features;
+    core::InferenceResult inference;
+    core::Decision decision;
+};
+
+/**
+ * @brief A kernel variant under test: runs the whole corpus at once so
+ *        batched variants can group windows
+ */
+struct GoldenVariant {
+    const char* name;
+    void (*run)(const GoldenCorpus& corpus, std::vector<GoldenOutputs>* outputs);
+};
+
+/**
+ * @brief All variants in this build (scalar, fused, pipeline, batched,
+ *        multi-axis). New kernel paths register here.
+ */
+std::vector<GoldenVariant> get_golden_variants();
+
+/**
+ * @brief Allowed absolute differences, in raw fixed-point LSBs
+ *
+ * Class and decision always compare exactly.
+ */
+struct GoldenTolerance {
+    int64_t spectral_lsb;       // Frequency, magnitude, centroid
+    int64_t num_peaks;
+    int64_t feature_lsb;
+    int64_t confidence_lsb;
+};
+
+/**
+ * @brief Bit-exact tolerance (all zero)
+ */
+GoldenTolerance get_exact_tolerance();
+
+/**
+ * @brief Per-field comparison summary
+ */
+struct GoldenFieldReport {
+    uint32_t compared;
+    uint32_t mismatches;        // Beyond tolerance
+    int64_t max_abs_diff;
+    std::string worst_case;     // Case with the largest difference
+};
+
+/**
+ * @brief Comparison summary for one variant
+ */
+struct GoldenVariantReport {
+    std::string variant;
+    GoldenFieldReport fields[NUM_GOLDEN_FIELDS];
+    bool passed;
+};
+
+/**
+ * @brief Run a variant over the corpus and compare against the golden outputs
+ */
+GoldenVariantReport check_golden_variant(
+    const GoldenCorpus& corpus,
+    const GoldenVariant& variant,
+    const GoldenTolerance& tolerance
+);
+
+/**
+ * @brief Print a per-field table for each report
+ */
+void print_golden_reports(std::ostream& os, const std::vector<GoldenVariantReport>& reports);
+
+} // namespace host
+} // namespace spectral_gate
+
+#endif // GOLDEN_H
@@ -0,0 +1,129 @@
+#include "incremental.h"
+#include "parallel.h"
+
+namespace spectral_gate {
+namespace host {
+
+using namespace hal;
+
+namespace {
+    // Windows handed to a worker at a time
+    constexpr size_t WINDOWS_PER_CHUNK = 32;
+
+    // Bits of the per-window "stage ran" mask
+    constexpr uint8_t RAN_SPECTRAL = 1;
+    constexpr uint8_t RAN_INFERENCE = 2;
+    constexpr uint8_t RAN_DECISION = 4;
+
+    // FNV-1a 64 continuing from seed over the bytes of value
+    uint64_t combine(uint64_t seed, uint64_t value) {
+        for (int shift = 0; shift < 64; shift += 8) {
+            seed ^= static_cast<uint8_t>(value >> shift);
+            seed *= 1099511628211ull;
+        }
+        return seed;
+    }
+}
+
+uint64_t hash_threshold_config(const core::ThresholdConfig& config) {
+    uint64_t hash = 14695981039346656037ull;
+    hash = combine(hash, static_cast<uint32_t>(config.base_confidence_threshold));
+    hash = combine(hash, static_cast<uint32_t>(config.low_battery_multiplier));
+    hash = combine(hash, static_cast<uint32_t>(config.critical_battery_multiplier));
+    hash = combine(hash, config.min_peaks_for_detection);
+    hash = combine(hash, static_cast<uint32_t>(config.min_peak_magnitude));
+    return hash;
+}
+
+IncrementalEvaluator::IncrementalEvaluator(size_t num_bins, uint32_t sample_rate)
+    : num_bins_(num_bins),
+      sample_rate_(sample_rate),
+      engine_(nullptr),
+      default_engine_(core::create_default_engine()),
+      config_(core::get_default_config()),
+      feature_cache_(nullptr),
+      layout_bins_(0),
+      stats_{0, 0, 0, 0}
+{
+    engine_ = &default_engine_;
+}
+
+void IncrementalEvaluator::set_spectral(size_t num_bins, uint32_t sample_rate) {
+    num_bins_ = num_bins;
+    sample_rate_ = sample_rate;
+}
+
+void IncrementalEvaluator::set_engine(const core::InferenceEngine& engine) {
+    engine_ = &engine;
+}
+
+const IncrementalStats& IncrementalEvaluator::evaluate(const Dataset& dataset, unsigned num_threads) {
+    const size_t windows = dataset.windows.size();
+    const size_t bins = num_bins_;
+
+    // A different bin count changes the feature layout; start over
+    if (layout_bins_ != bins) {
+        spectral_key_.clear();
+        inference_key_.clear();
+        decision_key_.clear();
+        features_.clear();
+        layout_bins_ = bins;
+    }
+    spectral_key_.resize(windows, 0);
+    inference_key_.resize(windows, 0);
+    decision_key_.resize(windows, 0);
+    features_.resize(windows * bins, 0);
+    spectral_.resize(windows);
+    num_features_.resize(windows, 0);
+    inference_.resize(windows);
+    decisions_.resize(windows, core::Decision::SLEEP);
+
+    const uint64_t spectral_hash = hash_spectral_config(core::SpectralProcessor(bins, sample_rate_));
+    const uint64_t model_hash = engine_->get_model_checksum();
+    const uint64_t config_hash = hash_threshold_config(config_);
+    std::vector<uint8_t> ran(windows, 0);
+
+    parallel_for(windows, num_threads, WINDOWS_PER_CHUNK,
+        [&](size_t begin, size_t end, unsigned /*worker*/) {
+            core::SpectralProcessor processor(bins, sample_rate_);
+            core::InferenceEngine engine = *engine_;
+
+            for (size_t w = begin; w < end; ++w) {
+                const DatasetWindow& window = dataset.windows[w];
+                uint64_t spectral_key = combine(
+                    hash_window(window.samples.data(), window.samples.size()), spectral_hash);
+                uint64_t inference_key = combine(spectral_key, model_hash);
+                uint64_t decision_key = combine(combine(inference_key, config_hash), window.battery_mv);
+
+                if (spectral_key_[w] != spectral_key) {
+                    spectral_[w] = process_with_features_cached(
+                        feature_cache_, processor, window.samples.data(), window.samples.size(),
+                        &features_[w * bins], bins, &num_features_[w]);
+                    spectral_key_[w] = spectral_key;
+                    ran[w] |= RAN_SPECTRAL;
+                }
+                if (inference_key_[w] != inference_key) {
+                    inference_[w] = engine.run(&features_[w * bins], num_features_[w]);
+                    inference_key_[w] = inference_key;
+                    ran[w] |= RAN_INFERENCE;
+                }
+                if (decision_key_[w] != decision_key) {
+                    decisions_[w] = core::evaluate_structure(
+                        spectral_[w], inference_[w], window.battery_mv, config_);
+                    decision_key_[w] = decision_key;
+                    ran[w] |= RAN_DECISION;
+                }
+            }
+        });
+
+    stats_ = IncrementalStats{windows, 0, 0, 0};
+    for (uint8_t mask : ran) {
+        stats_.spectral_runs += (mask & RAN_SPECTRAL) ? 1 : 0;
+        stats_.inference_runs += (mask & RAN_INFERENCE) ? 1 : 0;
+        stats_.decision_runs += (mask & RAN_DECISION) ? 1 : 0;
+    }
+    return stats_;
+}
+
+} // namespace host
+} // namespace spectral_gate
@@ -0,0 +1,109 @@
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "hal/hal_interface.h"
+#include "core/decision.h"
+#include "core/inference.h"
+#include "core/spectral.h"
+#include "dataset.h"
+#include "feature_cache.h"
+
+namespace spectral_gate {
+namespace host {
+
+/**
+ * @brief Windows recomputed per stage by the last evaluate()
+ */
+struct IncrementalStats {
+    size_t windows;
+    size_t spectral_runs;
+    size_t inference_runs;
+    size_t decision_runs;
+};
+
+/**
+ * @brief Hash of every ThresholdConfig field
+ */
+uint64_t hash_threshold_config(const core::ThresholdConfig& config);
+
+/**
+ * @brief Offline evaluator that reruns only invalidated stages
+ *
+ * Each window carries one fingerprint per stage, chained from the stage
+ * before it:
+ *
+ *   spectral  = H(window samples, spectral config)
+ *   inference = H(spectral, model checksum)
+ *   decision  = H(inference, ThresholdConfig, battery_mv)
+ *
+ * evaluate() recomputes a stage for a window only when its fingerprint
+ * changed, so a new ThresholdConfig reruns decisions alone, a new model
+ * reruns inference and decisions, and an edited dataset reruns only the
+ * edited windows. Intermediate results stay in memory between calls; an
+ * optional FeatureCache also persists the spectral stage across runs.
+ */
+class IncrementalEvaluator {
+public:
+    IncrementalEvaluator(size_t num_bins, uint32_t sample_rate);
+
+    IncrementalEvaluator(const IncrementalEvaluator&) = delete;
+    IncrementalEvaluator& operator=(const IncrementalEvaluator&) = delete;
+
+    /**
+     * @brief Use another spectral configuration (invalidates everything)
+     */
+    void set_spectral(size_t num_bins, uint32_t sample_rate);
+
+    /**
+     * @brief Use another model; the engine must outlive the evaluator
+     */
+    void set_engine(const core::InferenceEngine& engine);
+
+    void set_config(const core::ThresholdConfig& config) { config_ = config; }
+
+    void set_feature_cache(FeatureCache* cache) { feature_cache_ = cache; }
+
+    /**
+     * @brief Bring every stage up to date for the dataset
+     * @param num_threads Worker count (0 = hardware concurrency)
+     */
+    const IncrementalStats& evaluate(const Dataset& dataset, unsigned num_threads);
+
+    const std::vector<core::SpectralResult>& get_spectral() const { return spectral_; }
+    const std::vector<hal::fixed_t>& get_features() const { return features_; }
+    const std::vector<core::InferenceResult>& get_inference() const { return inference_; }
+    const std::vector<core::Decision>& get_decisions() const { return decisions_; }
+    const IncrementalStats& get_stats() const { return stats_; }
+
+    size_t get_num_features() const { return num_bins_; }
+
+private:
+    size_t num_bins_;
+    uint32_t sample_rate_;
+    const core::InferenceEngine* engine_;
+    core::InferenceEngine default_engine_;
+    core::ThresholdConfig config_;
+    FeatureCache* feature_cache_;
+
+    size_t layout_bins_;                        // Feature stride of the stored results
+
+    // Per-window stage fingerprints of the stored results (0 = none)
+    std::vector<uint64_t> spectral_key_;
+    std::vector<uint64_t> inference_key_;
+    std::vector<uint64_t> decision_key_;
+
+    std::vector<core::SpectralResult> spectral_;
+    std::vector<hal::fixed_t> features_;        // [window][num_bins]
+    std::vector<size_t> num_features_;
+    std::vector<core::InferenceResult> inference_;
+    std::vector<core::Decision> decisions_;
+    IncrementalStats stats_;
+};
+
+} // namespace host
+} // namespace spectral_gate
+
+#endif // INCREMENTAL_H
@@ -0,0 +1,555 @@
+#include "log_query.h"
+#include "parallel.h"
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SG_LOG_QUERY_POSIX 1
+#endif
+
+namespace spectral_gate {
+namespace host {
+
+namespace {
+    constexpr char INDEX_MAGIC[4] = {'S', 'G', 'D', 'X'};
+    constexpr uint16_t INDEX_VERSION = 1;
+    constexpr size_t INDEX_HEADER_SIZE = 40;
+
+    // Posting entries pack the stripe above the offset within it
+    constexpr uint32_t STRIPE_SHIFT = 10;
+    static_assert(DecisionLogIndex::STRIPE_RECORDS == (1u << STRIPE_SHIFT),
+                  "postings assume STRIPE_RECORDS == 1 << STRIPE_SHIFT");
+
+    // Stripes / postings handed to a worker at a time
+    constexpr size_t STRIPES_PER_CHUNK = 16;
+    constexpr size_t POSTINGS_PER_CHUNK = 16384;
+
+    constexpr size_t NUM_NODE_IDS = 65536;
+
+    void put_u16(std::vector<uint8_t>* out, uint16_t v) {
+        out->push_back(static_cast<uint8_t>(v & 0xFF));
+        out->push_back(static_cast<uint8_t>(v >> 8));
+    }
+
+    void put_u32(std::vector<uint8_t>* out, uint32_t v) {
+        for (int i = 0; i < 4; ++i) out->push_back(static_cast<uint8_t>((v >> (8 * i)) & 0xFF));
+    }
+
+    void put_u64(std::vector<uint8_t>* out, uint64_t v) {
+        put_u32(out, static_cast<uint32_t>(v));
+        put_u32(out, static_cast<uint32_t>(v >> 32));
+    }
+
+    // Bounds-checked little-endian cursor over a loaded index file
+    struct Cursor {
+        const uint8_t* p;
+        const uint8_t* end;
+        bool ok;
+
+        bool has(size_t n) {
+            ok = ok && static_cast<size_t>(end - p) >= n;
+            return ok;
+        }
+        uint16_t u16() {
+            if (!has(2)) return 0;
+            uint16_t v = static_cast<uint16_t>(p[0] | (p[1] << 8));
+            p += 2;
+            return v;
+        }
+        uint32_t u32() {
+            if (!has(4)) return 0;
+            uint32_t v = static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                         (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+            p += 4;
+            return v;
+        }
+        uint64_t u64() {
+            uint64_t lo = u32();
+            return lo | (static_cast<uint64_t>(u32()) << 32);
+        }
+    };
+
+    NodeAggregate empty_aggregate(uint16_t node_id) {
+        return NodeAggregate{node_id, 0, {0, 0, 0}, 0.0,
+                             std::numeric_limits<uint16_t>::max(),
+                             std::numeric_limits<uint32_t>::max(), 0};
+    }
+
+    void accumulate(NodeAggregate* a, const DecisionBlockView& view, size_t i, uint32_t time_s) {
+        ++a->windows;
+        size_t d = static_cast<size_t>(view.decision(i));
+        if (d < 3) {
+            ++a->decisions[d];
+        }
+        a->confidence_sum += hal::fixed_to_float(view.confidence(i));
+        uint16_t battery = view.battery_mv(i);
+        a->min_battery_mv = (battery < a->min_battery_mv) ? battery : a->min_battery_mv;
+        a->first_s = (time_s < a->first_s) ? time_s : a->first_s;
+        a->last_s = (time_s > a->last_s) ? time_s : a->last_s;
+    }
+
+    void merge(NodeAggregate* into, const NodeAggregate& from) {
+        into->windows += from.windows;
+        for (size_t d = 0; d < 3; ++d) {
+            into->decisions[d] += from.decisions[d];
+        }
+        into->confidence_sum += from.confidence_sum;
+        into->min_battery_mv = (from.min_battery_mv < into->min_battery_mv) ? from.min_battery_mv
+                                                                             : into->min_battery_mv;
+        into->first_s = (from.first_s < into->first_s) ? from.first_s : into->first_s;
+        into->last_s = (from.last_s > into->last_s) ? from.last_s : into->last_s;
+    }
+}
+
+LogQuery get_default_log_query() {
+    LogQuery query;
+    query.filter_node = false;
+    query.node_id = 0;
+    query.from_s = 0;
+    query.to_s = std::numeric_limits<uint32_t>::max();
+    query.filter_decision = false;
+    query.decision = core::Decision::SLEEP;
+    return query;
+}
+
+DecisionLogIndex::DecisionLogIndex()
+    : data_(nullptr),
+      length_(0),
+      records_(0),
+      min_time_(0),
+      max_time_(0),
+      loaded_(false)
+{
+}
+
+DecisionLogIndex::~DecisionLogIndex() {
+    close();
+}
+
+bool DecisionLogIndex::open(const std::string& log_path, unsigned num_threads, bool rebuild) {
+    close();
+
+#if defined(SG_LOG_QUERY_POSIX)
+    int fd = ::open(log_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    void* map = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        return false;
+    }
+    data_ = static_cast<const uint8_t*>(map);
+    length_ = static_cast<size_t>(st.st_size);
+#else
+    std::FILE* file = std::fopen(log_path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    uint8_t chunk[1 << 16];
+    size_t got;
+    while ((got = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        fallback_.insert(fallback_.end(), chunk, chunk + got);
+    }
+    std::fclose(file);
+    data_ = fallback_.data();
+    length_ = fallback_.size();
+#endif
+
+    const std::string index_path = log_path + ".sgdx";
+    if (!rebuild && load(index_path)) {
+        loaded_ = true;
+        return true;
+    }
+    if (!build(num_threads)) {
+        close();
+        return false;
+    }
+    // A read-only directory only costs the next run a rebuild
+    save(index_path);
+    return true;
+}
+
+void DecisionLogIndex::close() {
+#if defined(SG_LOG_QUERY_POSIX)
+    if (data_ != nullptr) {
+        munmap(const_cast<uint8_t*>(data_), length_);
+    }
+#endif
+    data_ = nullptr;
+    length_ = 0;
+    fallback_.clear();
+    blocks_.clear();
+    stripes_.clear();
+    nodes_.clear();
+    postings_.clear();
+    node_slot_.clear();
+    records_ = 0;
+    min_time_ = 0;
+    max_time_ = 0;
+    loaded_ = false;
+}
+
+bool DecisionLogIndex::build(unsigned num_threads) {
+    // A torn final block (log still being written) is left out
+    if (!scan_decision_log(data_, length_, &blocks_) && blocks_.empty()) {
+        return false;
+    }
+
+    // Stripe layout is fixed by the block sizes
+    std::vector<size_t> first_stripe(blocks_.size());
+    for (size_t b = 0; b < blocks_.size(); ++b) {
+        first_stripe[b] = stripes_.size();
+        for (uint32_t first = 0; first < blocks_[b].count; first += STRIPE_RECORDS) {
+            uint32_t count = blocks_[b].count - first;
+            count = (count < STRIPE_RECORDS) ? count : STRIPE_RECORDS;
+            stripes_.push_back(Stripe{static_cast<uint32_t>(b), first, count, 0, 0});
+        }
+    }
+    if (stripes_.size() >= (1ull << (32 - STRIPE_SHIFT))) {
+        return false;
+    }
+
+    // Verify checksums and fill stripe time ranges, one block per task
+    std::vector<uint8_t> valid(blocks_.size(), 0);
+    parallel_for(blocks_.size(), num_threads, 1,
+        [&](size_t begin, size_t end, unsigned /*worker*/) {
+            for (size_t b = begin; b < end; ++b) {
+                if (!verify_decision_block(data_, blocks_[b])) {
+                    continue;
+                }
+                DecisionBlockView v = view(static_cast<uint32_t>(b));
+                for (size_t s = first_stripe[b]; s < stripes_.size() && stripes_[s].block == b; ++s) {
+                    Stripe& stripe = stripes_[s];
+                    uint32_t lo = std::numeric_limits<uint32_t>::max();
+                    uint32_t hi = 0;
+                    for (uint32_t i = stripe.first; i < stripe.first + stripe.count; ++i) {
+                        uint32_t t = v.time_s(i);
+                        lo = (t < lo) ? t : lo;
+                        hi = (t > hi) ? t : hi;
+                    }
+                    stripe.min_time = lo;
+                    stripe.max_time = hi;
+                }
+                valid[b] = 1;
+            }
+        });
+    for (uint8_t ok : valid) {
+        if (!ok) {
+            return false;
+        }
+    }
+
+    // Posting lists: one pass to find the nodes (slots in id order), one
+    // to append every record to its node's list in log order
+    std::vector<uint8_t> present(NUM_NODE_IDS, 0);
+    for (uint32_t b = 0; b < blocks_.size(); ++b) {
+        DecisionBlockView v = view(b);
+        for (uint32_t i = 0; i < v.count(); ++i) {
+            present[v.node_id(i)] = 1;
+        }
+    }
+    for (size_t id = 0; id < NUM_NODE_IDS; ++id) {
+        if (present[id]) {
+            nodes_.push_back(static_cast<uint16_t>(id));
+        }
+    }
+    finish();
+    postings_.assign(nodes_.size(), std::vector<uint32_t>());
+    for (uint32_t s = 0; s < stripes_.size(); ++s) {
+        const Stripe& stripe = stripes_[s];
+        DecisionBlockView v = view(stripe.block);
+        for (uint32_t i = 0; i < stripe.count; ++i) {
+            postings_[node_slot_[v.node_id(stripe.first + i)]].push_back((s << STRIPE_SHIFT) | i);
+        }
+    }
+    return true;
+}
+
+void DecisionLogIndex::finish() {
+    node_slot_.assign(NUM_NODE_IDS, -1);
+    for (size_t slot = 0; slot < nodes_.size(); ++slot) {
+        node_slot_[nodes_[slot]] = static_cast<int32_t>(slot);
+    }
+    records_ = 0;
+    for (const DecisionBlockRef& block : blocks_) {
+        records_ += block.count;
+    }
+    min_time_ = std::numeric_limits<uint32_t>::max();
+    max_time_ = 0;
+    for (const Stripe& stripe : stripes_) {
+        min_time_ = (stripe.min_time < min_time_) ? stripe.min_time : min_time_;
+        max_time_ = (stripe.max_time > max_time_) ? stripe.max_time : max_time_;
+    }
+    if (stripes_.empty()) {
+        min_time_ = 0;
+    }
+}
+
+bool DecisionLogIndex::save(const std::string& index_path) const {
+    std::vector<uint8_t> out;
+    out.insert(out.end(), INDEX_MAGIC, INDEX_MAGIC + 4);
+    put_u16(&out, INDEX_VERSION);
+    put_u16(&out, static_cast<uint16_t>(STRIPE_RECORDS));
+    put_u64(&out, static_cast<uint64_t>(length_));
+    put_u32(&out, static_cast<uint32_t>(blocks_.size()));
+    put_u32(&out, static_cast<uint32_t>(stripes_.size()));
+    put_u32(&out, static_cast<uint32_t>(nodes_.size()));
+    put_u64(&out, 0);   // Reserved
+    put_u32(&out, 0);
+    for (const DecisionBlockRef& block : blocks_) {
+        put_u64(&out, static_cast<uint64_t>(block.payload_offset));
+        put_u32(&out, block.count);
+        put_u32(&out, block.checksum);
+    }
+    for (const Stripe& stripe : stripes_) {
+        put_u32(&out, stripe.block);
+        put_u32(&out, stripe.first);
+        put_u32(&out, stripe.count);
+        put_u32(&out, stripe.min_time);
+        put_u32(&out, stripe.max_time);
+    }
+    for (size_t slot = 0; slot < nodes_.size(); ++slot) {
+        put_u16(&out, nodes_[slot]);
+        put_u16(&out, 0);
+        put_u32(&out, static_cast<uint32_t>(postings_[slot].size()));
+        for (uint32_t posting : postings_[slot]) {
+            put_u32(&out, posting);
+        }
+    }
+
+    std::FILE* file = std::fopen(index_path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool ok = std::fwrite(out.data(), 1, out.size(), file) == out.size();
+    return (std::fclose(file) == 0) && ok;
+}
+
+bool DecisionLogIndex::load(const std::string& index_path) {
+    // Block headers are cheap to walk; the saved block table must match
+    std::vector<DecisionBlockRef> log_blocks;
+    if (!scan_decision_log(data_, length_, &log_blocks) && log_blocks.empty()) {
+        return false;
+    }
+
+    std::FILE* file = std::fopen(index_path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    std::vector<uint8_t> raw;
+    uint8_t chunk[1 << 16];
+    size_t got;
+    while ((got = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        raw.insert(raw.end(), chunk, chunk + got);
+    }
+    std::fclose(file);
+
+    Cursor c{raw.data(), raw.data() + raw.size(), true};
+    if (!c.has(INDEX_HEADER_SIZE) || std::memcmp(c.p, INDEX_MAGIC, 4) != 0) {
+        return false;
+    }
+    c.p += 4;
+    uint16_t version = c.u16();
+    uint16_t stripe_records = c.u16();
+    uint64_t log_length = c.u64();
+    uint32_t num_blocks = c.u32();
+    uint32_t num_stripes = c.u32();
+    uint32_t num_nodes = c.u32();
+    c.u64();
+    c.u32();
+    if (version != INDEX_VERSION || stripe_records != STRIPE_RECORDS ||
+        log_length != length_ || num_blocks != log_blocks.size() || num_nodes > NUM_NODE_IDS ||
+        !c.has(static_cast<size_t>(num_blocks) * 16 + static_cast<size_t>(num_stripes) * 20)) {
+        return false;
+    }
+
+    blocks_.resize(num_blocks);
+    for (DecisionBlockRef& block : blocks_) {
+        block.payload_offset = static_cast<size_t>(c.u64());
+        block.count = c.u32();
+        block.checksum = c.u32();
+    }
+    stripes_.resize(num_stripes);
+    for (Stripe& stripe : stripes_) {
+        stripe.block = c.u32();
+        stripe.first = c.u32();
+        stripe.count = c.u32();
+        stripe.min_time = c.u32();
+        stripe.max_time = c.u32();
+    }
+    nodes_.resize(num_nodes);
+    postings_.assign(num_nodes, std::vector<uint32_t>());
+    for (uint32_t slot = 0; slot < num_nodes && c.ok; ++slot) {
+        nodes_[slot] = c.u16();
+        c.u16();
+        uint32_t count = c.u32();
+        if (!c.has(static_cast<size_t>(count) * 4)) {
+            break;
+        }
+        postings_[slot].resize(count);
+        for (uint32_t& posting : postings_[slot]) {
+            posting = c.u32();
+        }
+    }
+
+    // The stored layout must still describe this log
+    bool ok = c.ok;
+    for (size_t b = 0; ok && b < blocks_.size(); ++b) {
+        ok = blocks_[b].payload_offset == log_blocks[b].payload_offset &&
+             blocks_[b].count == log_blocks[b].count &&
+             blocks_[b].checksum == log_blocks[b].checksum;
+    }
+    for (size_t s = 0; ok && s < stripes_.size(); ++s) {
+        ok = stripes_[s].block < blocks_.size() &&
+             stripes_[s].first + stripes_[s].count <= blocks_[stripes_[s].block].count;
+    }
+    for (size_t slot = 0; ok && slot < postings_.size(); ++slot) {
+        for (uint32_t posting : postings_[slot]) {
+            uint32_t s = posting >> STRIPE_SHIFT;
+            if (s >= stripes_.size() || (posting & (STRIPE_RECORDS - 1)) >= stripes_[s].count) {
+                ok = false;
+                break;
+            }
+        }
+    }
+    if (!ok) {
+        blocks_.clear();
+        stripes_.clear();
+        nodes_.clear();
+        postings_.clear();
+        return false;
+    }
+    finish();
+    return true;
+}
+
+std::vector<NodeAggregate> DecisionLogIndex::aggregate(
+    const LogQuery& query,
+    unsigned num_threads,
+    LogQueryStats* stats
+) const {
+    const unsigned workers = resolve_thread_count(num_threads);
+    const size_t num_nodes = nodes_.size();
+    std::vector<std::vector<NodeAggregate>> partial(workers);
+    std::vector<uint64_t> examined(workers, 0);
+
+    auto overlaps = [&](const Stripe& s) {
+        return s.max_time >= query.from_s && s.min_time <= query.to_s;
+    };
+    auto inside = [&](const Stripe& s) {
+        return s.min_time >= query.from_s && s.max_time <= query.to_s;
+    };
+    auto local = [&](unsigned worker) -> std::vector<NodeAggregate>& {
+        std::vector<NodeAggregate>& agg = partial[worker];
+        if (agg.empty()) {
+            agg.reserve(num_nodes);
+            for (uint16_t id : nodes_) {
+                agg.push_back(empty_aggregate(id));
+            }
+        }
+        return agg;
+    };
+    // Time is read only from stripes straddling the range boundary
+    auto visit = [&](std::vector<NodeAggregate>& agg, bool whole,
+                     const DecisionBlockView& v, uint32_t i, size_t slot) {
+        uint32_t t = v.time_s(i);
+        if (!whole && (t < query.from_s || t > query.to_s)) {
+            return;
+        }
+        if (query.filter_decision && v.decision(i) != query.decision) {
+            return;
+        }
+        accumulate(&agg[slot], v, i, t);
+    };
+
+    size_t scanned = 0;
+    if (query.filter_node) {
+        int32_t slot = node_slot_.empty() ? -1 : node_slot_[query.node_id];
+        if (slot >= 0) {
+            const std::vector<uint32_t>& postings = postings_[static_cast<size_t>(slot)];
+            for (const Stripe& stripe : stripes_) {
+                scanned += overlaps(stripe) ? 1 : 0;
+            }
+            parallel_for(postings.size(), num_threads, POSTINGS_PER_CHUNK,
+                [&](size_t begin, size_t end, unsigned worker) {
+                    std::vector<NodeAggregate>& agg = local(worker);
+                    for (size_t p = begin; p < end; ++p) {
+                        const Stripe& stripe = stripes_[postings[p] >> STRIPE_SHIFT];
+                        if (!overlaps(stripe)) {
+                            continue;
+                        }
+                        ++examined[worker];
+                        DecisionBlockView v = view(stripe.block);
+                        uint32_t i = stripe.first + (postings[p] & (STRIPE_RECORDS - 1));
+                        visit(agg, inside(stripe), v, i, static_cast<size_t>(slot));
+                    }
+                });
+        }
+    } else {
+        std::vector<uint32_t> candidates;
+        for (uint32_t s = 0; s < stripes_.size(); ++s) {
+            if (overlaps(stripes_[s])) {
+                candidates.push_back(s);
+            }
+        }
+        scanned = candidates.size();
+        parallel_for(candidates.size(), num_threads, STRIPES_PER_CHUNK,
+            [&](size_t begin, size_t end, unsigned worker) {
+                std::vector<NodeAggregate>& agg = local(worker);
+                for (size_t c = begin; c < end; ++c) {
+                    const Stripe& stripe = stripes_[candidates[c]];
+                    const bool whole = inside(stripe);
+                    DecisionBlockView v = view(stripe.block);
+                    for (uint32_t i = stripe.first; i < stripe.first + stripe.count; ++i) {
+                        visit(agg, whole, v, i,
+                              static_cast<size_t>(node_slot_[v.node_id(i)]));
+                    }
+                    examined[worker] += stripe.count;
+                }
+            });
+    }
+
+    std::vector<NodeAggregate> totals;
+    totals.reserve(num_nodes);
+    for (uint16_t id : nodes_) {
+        totals.push_back(empty_aggregate(id));
+    }
+    for (const std::vector<NodeAggregate>& agg : partial) {
+        for (size_t slot = 0; slot < agg.size(); ++slot) {
+            merge(&totals[slot], agg[slot]);
+        }
+    }
+
+    std::vector<NodeAggregate> result;
+    uint64_t matched = 0;
+    for (const NodeAggregate& a : totals) {
+        if (a.windows > 0) {
+            result.push_back(a);
+            matched += a.windows;
+        }
+    }
+    if (stats != nullptr) {
+        stats->stripes_total = stripes_.size();
+        stats->stripes_scanned = scanned;
+        stats->records_examined = 0;
+        for (uint64_t e : examined) {
+            stats->records_examined += e;
+        }
+        stats->records_matched = matched;
+    }
+    return result;
+}
+
+} // namespace host
+} // namespace spectral_gate
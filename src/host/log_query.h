@@ -0,0 +1,156 @@
+#ifndef LOG_QUERY_H
+#define LOG_QUERY_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "core/decision.h"
+#include "decision_log.h"
+
+namespace spectral_gate {
+namespace host {
+
+/**
+ * @brief Filters of a decision log query (all optional)
+ *
+ * A record matches when its node, time and decision all pass.
+ */
+struct LogQuery {
+    bool filter_node;
+    uint16_t node_id;
+    uint32_t from_s;            // Inclusive
+    uint32_t to_s;              // Inclusive
+    bool filter_decision;
+    core::Decision decision;
+};
+
+/**
+ * @brief Query matching every record
+ */
+LogQuery get_default_log_query();
+
+/**
+ * @brief Aggregate of the matching records of one node
+ */
+struct NodeAggregate {
+    uint16_t node_id;
+    uint64_t windows;
+    uint64_t decisions[3];      // Indexed by core::Decision
+    double confidence_sum;
+    uint16_t min_battery_mv;
+    uint32_t first_s;
+    uint32_t last_s;
+
+    double mean_confidence() const {
+        return (windows > 0) ? confidence_sum / static_cast<double>(windows) : 0.0;
+    }
+};
+
+/**
+ * @brief How much of the log a query touched
+ */
+struct LogQueryStats {
+    size_t stripes_total;
+    size_t stripes_scanned;     // Stripes whose time range overlaps the query
+    uint64_t records_examined;
+    uint64_t records_matched;
+};
+
+/**
+ * @brief Sparse time index and per-node posting lists over a decision log
+ *
+ * The log is mapped read-only (mmap on POSIX). Records are grouped into
+ * stripes of STRIPE_RECORDS consecutive records within a block, and the
+ * index keeps each stripe's min/max time, so a time-range query skips
+ * every stripe outside the range without touching it. Each node has a
+ * sorted posting list of (stripe, offset) entries, so a single-node query
+ * visits only that node's records.
+ *
+ * open() loads the index from "<log>.sgdx" when that file still matches
+ * the log (length and block table) and otherwise rebuilds it, verifying
+ * every block checksum in parallel, and saves it. A torn final block,
+ * as left by a writer that is still running, is not indexed.
+ */
+class DecisionLogIndex {
+public:
+    static constexpr uint32_t STRIPE_RECORDS = 1024;
+
+    DecisionLogIndex();
+    ~DecisionLogIndex();
+
+    DecisionLogIndex(const DecisionLogIndex&) = delete;
+    DecisionLogIndex& operator=(const DecisionLogIndex&) = delete;
+
+    /**
+     * @brief Map a log and load or build its index
+     * @param num_threads Worker count for the rebuild (0 = hardware concurrency)
+     * @param rebuild Ignore any saved index
+     * @return false if the log cannot be mapped, has no complete block,
+     *         or a block fails its checksum
+     */
+    bool open(const std::string& log_path, unsigned num_threads, bool rebuild);
+
+    void close();
+
+    /**
+     * @brief True when open() used a saved index instead of rebuilding
+     */
+    bool loaded_from_file() const { return loaded_; }
+
+    uint64_t get_records() const { return records_; }
+    size_t get_num_stripes() const { return stripes_.size(); }
+    const std::vector<uint16_t>& get_nodes() const { return nodes_; }
+    uint32_t get_min_time() const { return min_time_; }
+    uint32_t get_max_time() const { return max_time_; }
+
+    /**
+     * @brief Filtered per-node aggregates, ordered by node id; nodes
+     *        without matching records are omitted
+     * @param num_threads Worker count (0 = hardware concurrency)
+     * @param stats Optional work counters
+     */
+    std::vector<NodeAggregate> aggregate(
+        const LogQuery& query,
+        unsigned num_threads,
+        LogQueryStats* stats
+    ) const;
+
+private:
+    struct Stripe {
+        uint32_t block;
+        uint32_t first;         // First record within the block
+        uint32_t count;
+        uint32_t min_time;
+        uint32_t max_time;
+    };
+
+    bool build(unsigned num_threads);
+    bool load(const std::string& index_path);
+    bool save(const std::string& index_path) const;
+    void finish();
+
+    DecisionBlockView view(uint32_t block) const {
+        return DecisionBlockView(data_ + blocks_[block].payload_offset, blocks_[block].count);
+    }
+
+    // Mapped log (or a heap copy where mmap is unavailable)
+    const uint8_t* data_;
+    size_t length_;
+    std::vector<uint8_t> fallback_;
+
+    std::vector<DecisionBlockRef> blocks_;
+    std::vector<Stripe> stripes_;
+    std::vector<uint16_t> nodes_;                   // Sorted node ids
+    std::vector<std::vector<uint32_t>> postings_;   // Per node: stripe << 10 | offset
+    std::vector<int32_t> node_slot_;                // node id -> index into nodes_, or -1
+    uint64_t records_;
+    uint32_t min_time_;
+    uint32_t max_time_;
+    bool loaded_;
+};
+
+} // namespace host
+} // namespace spectral_gate
+
+#endif // LOG_QUERY_H
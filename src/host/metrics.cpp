@@ -0,0 +1,312 @@
+#include "metrics.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+namespace spectral_gate {
+namespace host {
+
+namespace {
+    size_t this_thread_shard() {
+        static std::atomic<size_t> next{0};
+        thread_local size_t shard = next.fetch_add(1, std::memory_order_relaxed) % METRIC_SHARDS;
+        return shard;
+    }
+
+    uint64_t to_bits(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    double from_bits(uint64_t bits) {
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    void add_double(std::atomic<uint64_t>& target, double delta) {
+        uint64_t expected = target.load(std::memory_order_relaxed);
+        while (!target.compare_exchange_weak(expected, to_bits(from_bits(expected) + delta),
+                                             std::memory_order_relaxed)) {
+        }
+    }
+
+    // Shortest text that parses back to the same double ("0.1", not
+    // "0.10000000000000001"), so bucket labels stay readable
+    std::string format_value(double value) {
+        char buffer[32];
+        if (value > -1e15 && value < 1e15 && value == static_cast<double>(static_cast<int64_t>(value))) {
+            std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(value));
+            return buffer;
+        }
+        for (int precision = 1; precision < 17; ++precision) {
+            std::snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+            if (std::strtod(buffer, nullptr) == value) {
+                return buffer;
+            }
+        }
+        std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+        return buffer;
+    }
+
+    std::string series_name(const std::string& name, const std::string& labels) {
+        return labels.empty() ? name : name + "{" + labels + "}";
+    }
+}
+
+Counter::Counter() {
+    for (auto& shard : shards_) {
+        shard.value.store(0, std::memory_order_relaxed);
+    }
+}
+
+void Counter::inc(uint64_t amount) {
+    shards_[this_thread_shard()].value.fetch_add(amount, std::memory_order_relaxed);
+}
+
+uint64_t Counter::value() const {
+    uint64_t total = 0;
+    for (const auto& shard : shards_) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+Gauge::Gauge()
+    : bits_(to_bits(0.0))
+{
+}
+
+void Gauge::set(double value) {
+    bits_.store(to_bits(value), std::memory_order_relaxed);
+}
+
+void Gauge::add(double delta) {
+    add_double(bits_, delta);
+}
+
+double Gauge::value() const {
+    return from_bits(bits_.load(std::memory_order_relaxed));
+}
+
+Histogram::Histogram(const std::vector<double>& bounds)
+    : bounds_(bounds)
+{
+    for (auto& shard : shards_) {
+        shard.counts.reset(new std::atomic<uint64_t>[bounds_.size() + 1]);
+        for (size_t b = 0; b <= bounds_.size(); ++b) {
+            shard.counts[b].store(0, std::memory_order_relaxed);
+        }
+        shard.sum_bits.store(to_bits(0.0), std::memory_order_relaxed);
+    }
+}
+
+void Histogram::observe(double value) {
+    size_t bucket = 0;
+    while (bucket < bounds_.size() && value > bounds_[bucket]) {
+        ++bucket;
+    }
+    Shard& shard = shards_[this_thread_shard()];
+    shard.counts[bucket].fetch_add(1, std::memory_order_relaxed);
+    add_double(shard.sum_bits, value);
+}
+
+std::vector<uint64_t> Histogram::bucket_counts() const {
+    std::vector<uint64_t> counts(bounds_.size() + 1, 0);
+    for (const auto& shard : shards_) {
+        for (size_t b = 0; b < counts.size(); ++b) {
+            counts[b] += shard.counts[b].load(std::memory_order_relaxed);
+        }
+    }
+    return counts;
+}
+
+double Histogram::sum() const {
+    double total = 0.0;
+    for (const auto& shard : shards_) {
+        total += from_bits(shard.sum_bits.load(std::memory_order_relaxed));
+    }
+    return total;
+}
+
+const char* MetricsRegistry::kind_name(Kind kind) {
+    switch (kind) {
+        case Kind::COUNTER:   return "counter";
+        case Kind::GAUGE:     return "gauge";
+        case Kind::HISTOGRAM: return "histogram";
+    }
+    return "?";
+}
+
+MetricsRegistry::Series* MetricsRegistry::find_or_add(
+    const std::string& name,
+    const std::string& help,
+    const std::string& labels,
+    Kind kind
+) {
+    for (auto& s : series_) {
+        if (s->name != name) {
+            continue;
+        }
+        // One TYPE per metric family: a kind clash is a programming error
+        if (s->kind != kind) {
+            std::fprintf(stderr, "metrics: '%s' registered as both %s and %s\n",
+                         name.c_str(), kind_name(s->kind), kind_name(kind));
+            std::abort();
+        }
+        if (s->labels == labels) {
+            return s.get();
+        }
+    }
+    std::unique_ptr<Series> s(new Series());
+    s->name = name;
+    s->help = help;
+    s->labels = labels;
+    s->kind = kind;
+    series_.push_back(std::move(s));
+    return series_.back().get();
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help,
+                                  const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Series* s = find_or_add(name, help, labels, Kind::COUNTER);
+    if (!s->counter) s->counter.reset(new Counter());
+    return *s->counter;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help,
+                              const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Series* s = find_or_add(name, help, labels, Kind::GAUGE);
+    if (!s->gauge) s->gauge.reset(new Gauge());
+    return *s->gauge;
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help,
+                                      const std::vector<double>& bounds,
+                                      const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Series* s = find_or_add(name, help, labels, Kind::HISTOGRAM);
+    if (!s->histogram) s->histogram.reset(new Histogram(bounds));
+    return *s->histogram;
+}
+
+std::string MetricsRegistry::render() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream out;
+    std::vector<std::string> described;
+
+    for (const auto& s : series_) {
+        // HELP/TYPE once per metric family, before its first series
+        bool seen = false;
+        for (const auto& d : described) {
+            if (d == s->name) seen = true;
+        }
+        if (!seen) {
+            out << "# HELP " << s->name << " " << s->help << "\n";
+            out << "# TYPE " << s->name << " " << kind_name(s->kind) << "\n";
+            described.push_back(s->name);
+        }
+
+        switch (s->kind) {
+            case Kind::COUNTER:
+                out << series_name(s->name, s->labels) << " " << s->counter->value() << "\n";
+                break;
+            case Kind::GAUGE:
+                out << series_name(s->name, s->labels) << " "
+                    << format_value(s->gauge->value()) << "\n";
+                break;
+            case Kind::HISTOGRAM: {
+                std::vector<uint64_t> counts = s->histogram->bucket_counts();
+                const std::vector<double>& bounds = s->histogram->bounds();
+                std::string prefix = s->labels.empty() ? "" : s->labels + ",";
+                uint64_t cumulative = 0;
+                for (size_t b = 0; b < counts.size(); ++b) {
+                    cumulative += counts[b];
+                    std::string le = (b < bounds.size()) ? format_value(bounds[b]) : "+Inf";
+                    out << s->name << "_bucket{" << prefix << "le=\"" << le << "\"} "
+                        << cumulative << "\n";
+                }
+                out << series_name(s->name + "_sum", s->labels) << " "
+                    << format_value(s->histogram->sum()) << "\n";
+                out << series_name(s->name + "_count", s->labels) << " " << cumulative << "\n";
+                break;
+            }
+        }
+    }
+    return out.str();
+}
+
+bool MetricsRegistry::write_textfile(const std::string& path) const {
+    std::string text = render();
+    std::string temp = path + ".tmp";
+
+    std::FILE* file = std::fopen(temp.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool ok = std::fwrite(text.data(), 1, text.size(), file) == text.size();
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) {
+        std::remove(temp.c_str());
+        return false;
+    }
+    // Readers see either the old or the new file, never a partial one
+    return std::rename(temp.c_str(), path.c_str()) == 0;
+}
+
+MetricsFileWriter::MetricsFileWriter(const MetricsRegistry& registry, const std::string& path,
+                                     uint32_t interval_ms)
+    : registry_(registry),
+      path_(path),
+      interval_ms_(interval_ms),
+      running_(false)
+{
+}
+
+MetricsFileWriter::~MetricsFileWriter() {
+    stop();
+}
+
+void MetricsFileWriter::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+        return;
+    }
+    running_ = true;
+    thread_ = std::thread([this] {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (running_) {
+            wake_.wait_for(lock, std::chrono::milliseconds(interval_ms_));
+            if (!running_) {
+                break;
+            }
+            lock.unlock();
+            registry_.write_textfile(path_);
+            lock.lock();
+        }
+    });
+}
+
+bool MetricsFileWriter::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_ && !thread_.joinable()) {
+            // Never started, or already stopped and flushed
+            return true;
+        }
+        running_ = false;
+    }
+    wake_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    return registry_.write_textfile(path_);
+}
+
+} // namespace host
+} // namespace spectral_gate
@@ -0,0 +1,175 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace spectral_gate {
+namespace host {
+
+// Shards per counter; threads are spread over them round-robin
+constexpr size_t METRIC_SHARDS = 16;
+
+/**
+ * @brief Monotonic counter with per-thread shards
+ *
+ * Each shard sits on its own cache line, so threads bumping the same
+ * counter do not bounce a line between cores. value() sums the shards.
+ */
+class Counter {
+public:
+    Counter();
+
+    void inc(uint64_t amount = 1);
+    uint64_t value() const;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value;
+    };
+    Shard shards_[METRIC_SHARDS];
+};
+
+/**
+ * @brief Point-in-time value (last write wins)
+ */
+class Gauge {
+public:
+    Gauge();
+
+    void set(double value);
+    void add(double delta);
+    double value() const;
+
+private:
+    std::atomic<uint64_t> bits_;    // IEEE 754 double
+};
+
+/**
+ * @brief Fixed-bucket histogram with per-thread shards
+ *
+ * Bucket bounds are upper-inclusive, as in Prometheus; an implicit +Inf
+ * bucket catches the rest.
+ */
+class Histogram {
+public:
+    explicit Histogram(const std::vector<double>& bounds);
+
+    void observe(double value);
+
+    const std::vector<double>& bounds() const { return bounds_; }
+
+    /**
+     * @brief Per-bucket (non-cumulative) counts, +Inf last
+     */
+    std::vector<uint64_t> bucket_counts() const;
+
+    double sum() const;
+
+private:
+    struct alignas(64) Shard {
+        std::unique_ptr<std::atomic<uint64_t>[]> counts;
+        std::atomic<uint64_t> sum_bits;
+    };
+    std::vector<double> bounds_;
+    Shard shards_[METRIC_SHARDS];
+};
+
+/**
+ * @brief Named metric series with Prometheus text export
+ *
+ * A series is identified by name plus label set (already formatted, e.g.
+ * "decision=\"SLEEP\""). Registering the same series twice returns the
+ * existing one; references stay valid for the registry's lifetime.
+ * Registering a name under a second kind (say a gauge named like an
+ * existing counter) aborts with a message.
+ * Registration takes a lock, updates never do.
+ */
+class MetricsRegistry {
+public:
+    Counter& counter(const std::string& name, const std::string& help,
+                     const std::string& labels = "");
+    Gauge& gauge(const std::string& name, const std::string& help,
+                 const std::string& labels = "");
+    Histogram& histogram(const std::string& name, const std::string& help,
+                         const std::vector<double>& bounds,
+                         const std::string& labels = "");
+
+    /**
+     * @brief Render all series in Prometheus text exposition format
+     */
+    std::string render() const;
+
+    /**
+     * @brief Write render() to path atomically (temp file + rename), as
+     *        the node-exporter textfile collector requires
+     * @return true on success
+     */
+    bool write_textfile(const std::string& path) const;
+
+private:
+    enum class Kind : uint8_t { COUNTER, GAUGE, HISTOGRAM };
+
+    struct Series {
+        std::string name;
+        std::string help;
+        std::string labels;
+        Kind kind;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+    };
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<Series>> series_;
+
+    static const char* kind_name(Kind kind);
+    Series* find_or_add(const std::string& name, const std::string& help,
+                        const std::string& labels, Kind kind);
+};
+
+/**
+ * @brief Background thread that rewrites a textfile at a fixed interval
+ */
+class MetricsFileWriter {
+public:
+    MetricsFileWriter(const MetricsRegistry& registry, const std::string& path,
+                      uint32_t interval_ms);
+    ~MetricsFileWriter();
+
+    MetricsFileWriter(const MetricsFileWriter&) = delete;
+    MetricsFileWriter& operator=(const MetricsFileWriter&) = delete;
+
+    void start();
+
+    /**
+     * @brief Stop the thread and write one final snapshot
+     *
+     * Does nothing if the writer was never started or is already stopped
+     * (the destructor calls it).
+     *
+     * @return false if the last write failed
+     */
+    bool stop();
+
+private:
+    const MetricsRegistry& registry_;
+    std::string path_;
+    uint32_t interval_ms_;
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool running_;
+};
+
+} // namespace host
+} // namespace spectral_gate
+
+#endif // METRICS_H
@@ -0,0 +1,88 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include "core/trace.h"
+
+namespace spectral_gate {
+namespace host {
+
+/**
+ * @brief Resolve a requested worker count (0 = all hardware threads)
+ */
+inline unsigned resolve_thread_count(unsigned requested) {
+    if (requested != 0) {
+        return requested;
+    }
+    unsigned hw = std::thread::hardware_concurrency();
+    return (hw == 0) ? 1 : hw;
+}
+
+/**
+ * @brief Run fn(begin, end, worker) over [0, count) in dynamic chunks
+ * 
+ * Workers pull chunks from a shared counter so uneven work balances out.
+ * With a single worker everything runs on the calling thread.
+ * 
+ * @param count Number of items
+ * @param num_threads Worker count (0 = hardware concurrency)
+ * @param chunk Items per chunk
+ * @param fn Callable taking (size_t begin, size_t end, unsigned worker)
+ */
+template <typename Fn>
+void parallel_for(size_t count, unsigned num_threads, size_t chunk, Fn fn) {
+    if (count == 0) {
+        return;
+    }
+    if (chunk == 0) {
+        chunk = 1;
+    }
+
+    unsigned workers = resolve_thread_count(num_threads);
+    size_t num_chunks = (count + chunk - 1) / chunk;
+    if (workers > num_chunks) {
+        workers = static_cast<unsigned>(num_chunks);
+    }
+
+    std::atomic<size_t> next{0};
+    auto worker_loop = [&](unsigned worker) {
+        for (;;) {
+            size_t begin = next.fetch_add(chunk, std::memory_order_relaxed);
+            if (begin >= count) {
+                break;
+            }
+            size_t end = (begin + chunk < count) ? begin + chunk : count;
+            SG_TRACE_SCOPE(WORKER, "chunk");
+            fn(begin, end, worker);
+        }
+    };
+
+    if (workers <= 1) {
+        worker_loop(0);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (unsigned w = 1; w < workers; ++w) {
+        threads.emplace_back([&worker_loop, w] {
+            SG_TRACE_THREAD_NAME("parallel_for worker");
+            worker_loop(w);
+        });
+    }
+    worker_loop(0);
+
+    // Time the caller spends waiting on stragglers
+    SG_TRACE_SCOPE(QUEUE, "join_wait");
+    for (auto& t : threads) {
+        t.join();
+    }
+}
+
+} // namespace host
+} // namespace spectral_gate
+
+#endif // PARALLEL_H
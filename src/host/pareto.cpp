@@ -0,0 +1,310 @@
+#include "pareto.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cstdio>
+#include "core/inference.h"
+#include "core/op_counter.h"
+#include "core/pipeline.h"
+#include "core/prefilter.h"
+#include "core/similarity.h"
+#include "core/spectral.h"
+
+namespace spectral_gate {
+namespace host {
+
+using namespace hal;
+
+namespace {
+    // Mains frequency for the default pre-filter notch
+    constexpr uint32_t MAINS_HZ = 50;
+
+    // Windows handed to a worker at a time when filling the cache
+    constexpr size_t WINDOWS_PER_CHUNK = 16;
+
+    /**
+     * @brief Front-end outputs for every dataset window
+     */
+    struct FrontEndCache {
+        FrontEndConfig config;
+        size_t num_features;
+        std::vector<core::SpectralResult> spectral;
+        std::vector<fixed_t> features;          // [window][num_features]
+        double compute_uj;                      // Mean per window
+    };
+
+    core::OpCounts total_ops() {
+        core::OpCounts total = {};
+        for (size_t s = 0; s < core::NUM_OP_STAGES; ++s) {
+            const core::OpCounts& stage = core::ops::get(static_cast<core::OpStage>(s));
+            for (size_t i = 0; i < core::NUM_OP_CLASSES; ++i) {
+                total.ops[i] += stage.ops[i];
+            }
+        }
+        return total;
+    }
+
+    bool same_front_end(const FrontEndConfig& a, const FrontEndConfig& b) {
+        return a.window_length == b.window_length && a.prefilter == b.prefilter;
+    }
+
+    void fill_front_end(
+        const Dataset& dataset,
+        const EnergyModel& energy,
+        unsigned num_threads,
+        FrontEndCache* cache
+    ) {
+        const size_t windows = dataset.windows.size();
+        const size_t bins = NUM_SPECTRAL_BINS;
+        cache->num_features = bins;
+        cache->spectral.resize(windows);
+        cache->features.assign(windows * bins, 0);
+        std::vector<double> window_uj(windows, 0.0);
+
+        parallel_for(windows, num_threads, WINDOWS_PER_CHUNK,
+            [&](size_t begin, size_t end, unsigned /*worker*/) {
+                core::SpectralProcessor processor(bins, dataset.sample_rate);
+                core::PreFilter prefilter = core::create_default_prefilter(dataset.sample_rate, MAINS_HZ);
+                std::vector<int16_t> samples(cache->config.window_length);
+                fixed_t features[core::WindowPipeline::MAX_FEATURES];
+
+                for (size_t w = begin; w < end; ++w) {
+                    const std::vector<int16_t>& source = dataset.windows[w].samples;
+                    std::copy(source.begin(), source.begin() + samples.size(), samples.begin());
+
+                    // Windows are independent, so filter state starts cold
+                    core::ops::reset();
+                    if (cache->config.prefilter) {
+                        prefilter.reset();
+                        prefilter.process(samples.data(), samples.data(), samples.size());
+                    }
+                    size_t num_features = 0;
+                    cache->spectral[w] = processor.process_with_features(
+                        samples.data(), samples.size(), features, bins, &num_features);
+                    std::copy(features, features + num_features, &cache->features[w * bins]);
+                    window_uj[w] = estimate_cost(total_ops(), 1.0, energy.compute).microjoules;
+                }
+            });
+
+        double sum = 0.0;
+        for (double uj : window_uj) {
+            sum += uj;
+        }
+        cache->compute_uj = (windows > 0) ? sum / static_cast<double>(windows) : 0.0;
+    }
+
+    ParetoPoint evaluate_back_end(
+        const Dataset& dataset,
+        const FrontEndCache& cache,
+        const ParetoConfig& config,
+        const EnergyModel& energy
+    ) {
+        core::InferenceEngine engine = core::create_default_engine();
+        core::SimilarityCache similarity(config.similarity_distance);
+        size_t true_positives = 0;
+        size_t false_positives = 0;
+        size_t false_negatives = 0;
+        size_t transmissions = 0;
+
+        // Same stage order as WindowPipeline::process_window()
+        core::ops::reset();
+        for (size_t w = 0; w < dataset.windows.size(); ++w) {
+            const fixed_t* features = &cache.features[w * cache.num_features];
+            core::InferenceResult inference;
+            bool reused = false;
+            uint32_t signature = 0;
+            if (config.similarity) {
+                signature = core::compute_band_signature(features, cache.num_features);
+                reused = similarity.lookup(signature, &inference);
+            }
+            if (!reused) {
+                inference = engine.run(features, cache.num_features);
+                if (config.similarity) {
+                    similarity.insert(signature, inference);
+                }
+            }
+            core::Decision decision = core::evaluate_structure(
+                cache.spectral[w], inference, dataset.windows[w].battery_mv, config.thresholds);
+
+            bool detected = (decision != core::Decision::SLEEP);
+            WindowLabel label = dataset.windows[w].label;
+            transmissions += detected ? 1 : 0;
+            if (label == WindowLabel::ANOMALY) {
+                if (detected) ++true_positives; else ++false_negatives;
+            } else if (label == WindowLabel::NORMAL && detected) {
+                ++false_positives;
+            }
+        }
+
+        const double windows = static_cast<double>(dataset.windows.size());
+        ParetoPoint point;
+        point.config = config;
+        point.precision = (true_positives + false_positives > 0)
+            ? static_cast<double>(true_positives) / (true_positives + false_positives) : 0.0;
+        point.recall = (true_positives + false_negatives > 0)
+            ? static_cast<double>(true_positives) / (true_positives + false_negatives) : 0.0;
+        point.f1 = (point.precision + point.recall > 0.0)
+            ? 2.0 * point.precision * point.recall / (point.precision + point.recall) : 0.0;
+        point.tx_rate = static_cast<double>(transmissions) / windows;
+        point.compute_uj = cache.compute_uj +
+                           estimate_cost(total_ops(), windows, energy.compute).microjoules;
+        point.energy_uj = energy.acquisition_uj_per_sample * config.front_end.window_length +
+                          point.compute_uj + point.tx_rate * energy.tx_uj;
+        point.on_frontier = false;
+        return point;
+    }
+}
+
+ParetoGrid get_default_pareto_grid() {
+    ParetoGrid grid;
+    grid.window_lengths = {64, 128, 256};
+    grid.prefilter = {false, true};
+    grid.similarity_distances = {-1, 0, 2};
+    grid.confidence_thresholds = {0.4f, 0.5f, 0.65f, 0.8f};
+    grid.min_peaks = {1, 2, 3};
+    grid.activity_gates = {0.005f, 0.01f, 0.02f, 0.1f};
+    return grid;
+}
+
+EnergyModel get_default_energy_model() {
+    EnergyModel model;
+    model.compute = get_default_m33_cost_table();
+    model.acquisition_uj_per_sample = 50.0 / 256.0;
+    model.tx_uj = 2000.0;
+    return model;
+}
+
+std::vector<ParetoPoint> explore_pareto(
+    const Dataset& dataset,
+    const ParetoGrid& grid,
+    const EnergyModel& energy,
+    unsigned num_threads,
+    ParetoStats* stats
+) {
+    std::vector<ParetoConfig> configs;
+    for (size_t length : grid.window_lengths) {
+        if (length == 0 || length > dataset.window_length) {
+            continue;
+        }
+        for (bool prefilter : grid.prefilter) {
+            for (int distance : grid.similarity_distances) {
+                for (float threshold : grid.confidence_thresholds) {
+                    for (uint8_t peaks : grid.min_peaks) {
+                        for (float gate : grid.activity_gates) {
+                            ParetoConfig config;
+                            config.front_end = FrontEndConfig{length, prefilter};
+                            config.similarity = (distance >= 0);
+                            config.similarity_distance = static_cast<uint8_t>((distance >= 0) ? distance : 0);
+                            config.thresholds = core::get_default_config();
+                            config.thresholds.base_confidence_threshold = float_to_fixed(threshold);
+                            config.thresholds.min_peaks_for_detection = peaks;
+                            config.thresholds.min_peak_magnitude = float_to_fixed(gate);
+                            configs.push_back(config);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // One cache entry per distinct front-end
+    std::vector<FrontEndCache> caches;
+    std::vector<size_t> cache_index(configs.size());
+    for (size_t c = 0; c < configs.size(); ++c) {
+        size_t k = 0;
+        while (k < caches.size() && !same_front_end(caches[k].config, configs[c].front_end)) {
+            ++k;
+        }
+        if (k == caches.size()) {
+            FrontEndCache cache{};
+            cache.config = configs[c].front_end;
+            caches.push_back(std::move(cache));
+        }
+        cache_index[c] = k;
+    }
+    for (FrontEndCache& cache : caches) {
+        fill_front_end(dataset, energy, num_threads, &cache);
+    }
+
+    std::vector<ParetoPoint> points(configs.size());
+    if (!dataset.windows.empty()) {
+        parallel_for(configs.size(), num_threads, 1,
+            [&](size_t begin, size_t end, unsigned /*worker*/) {
+                for (size_t c = begin; c < end; ++c) {
+                    points[c] = evaluate_back_end(dataset, caches[cache_index[c]], configs[c], energy);
+                }
+            });
+    } else {
+        points.clear();
+    }
+
+    mark_pareto_frontier(&points);
+    if (stats != nullptr) {
+        stats->front_ends = caches.size();
+        stats->configs = configs.size();
+        stats->windows = dataset.windows.size();
+    }
+    return points;
+}
+
+void mark_pareto_frontier(std::vector<ParetoPoint>* points) {
+    std::stable_sort(points->begin(), points->end(),
+        [](const ParetoPoint& a, const ParetoPoint& b) {
+            if (a.energy_uj != b.energy_uj) return a.energy_uj < b.energy_uj;
+            return a.f1 > b.f1;
+        });
+
+    // Cheapest first: a point is kept only if it beats every cheaper F1
+    double best_f1 = -1.0;
+    for (ParetoPoint& point : *points) {
+        point.on_frontier = (point.f1 > best_f1);
+        if (point.on_frontier) {
+            best_f1 = point.f1;
+        }
+    }
+}
+
+void print_pareto_frontier(std::ostream& out, const std::vector<ParetoPoint>& points) {
+    out << "length prefilter similarity threshold peaks    gate      F1  precision  recall  tx_rate  compute_uJ  energy_uJ\n";
+    for (const ParetoPoint& point : points) {
+        if (!point.on_frontier) {
+            continue;
+        }
+        char similarity[8];
+        if (point.config.similarity) {
+            std::snprintf(similarity, sizeof(similarity), "%u", point.config.similarity_distance);
+        } else {
+            std::snprintf(similarity, sizeof(similarity), "off");
+        }
+        char line[160];
+        std::snprintf(line, sizeof(line),
+                      "%6zu %9s %10s %9.2f %5u  %6.3f  %6.3f  %9.3f  %6.3f  %7.3f  %10.2f  %9.2f\n",
+                      point.config.front_end.window_length,
+                      point.config.front_end.prefilter ? "on" : "off",
+                      similarity,
+                      fixed_to_float(point.config.thresholds.base_confidence_threshold),
+                      point.config.thresholds.min_peaks_for_detection,
+                      fixed_to_float(point.config.thresholds.min_peak_magnitude),
+                      point.f1, point.precision, point.recall, point.tx_rate,
+                      point.compute_uj, point.energy_uj);
+        out << line;
+    }
+}
+
+void write_pareto_csv(std::ostream& out, const std::vector<ParetoPoint>& points) {
+    out << "window_length,prefilter,similarity_distance,confidence_threshold,min_peaks,activity_gate,"
+        << "f1,precision,recall,tx_rate,compute_uj,energy_uj,on_frontier\n";
+    for (const ParetoPoint& point : points) {
+        out << point.config.front_end.window_length << ","
+            << (point.config.front_end.prefilter ? 1 : 0) << ","
+            << (point.config.similarity ? static_cast<int>(point.config.similarity_distance) : -1) << ","
+            << fixed_to_float(point.config.thresholds.base_confidence_threshold) << ","
+            << static_cast<int>(point.config.thresholds.min_peaks_for_detection) << ","
+            << fixed_to_float(point.config.thresholds.min_peak_magnitude) << ","
+            << point.f1 << "," << point.precision << "," << point.recall << ","
+            << point.tx_rate << "," << point.compute_uj << "," << point.energy_uj << ","
+            << (point.on_frontier ? 1 : 0) << "\n";
+    }
+}
+
+} // namespace host
+} // namespace spectral_gate
@@ -0,0 +1,122 @@
+#ifndef PARETO_H
+#define PARETO_H
+
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+#include "hal/hal_interface.h"
+#include "core/decision.h"
+#include "cycle_model.h"
+#include "dataset.h"
+
+namespace spectral_gate {
+namespace host {
+
+/**
+ * @brief Front-end settings (everything up to the feature vector)
+ *
+ * Configurations with equal front-ends share one cached pass over the
+ * dataset.
+ */
+struct FrontEndConfig {
+    size_t window_length;       // Leading samples of each dataset window
+    bool prefilter;             // create_default_prefilter() ahead of the DFT
+};
+
+/**
+ * @brief One point of the configuration grid
+ */
+struct ParetoConfig {
+    FrontEndConfig front_end;
+    bool similarity;            // SimilarityCache ahead of inference
+    uint8_t similarity_distance;
+    core::ThresholdConfig thresholds;
+};
+
+/**
+ * @brief Axes of the grid; the explorer evaluates their cross product
+ */
+struct ParetoGrid {
+    std::vector<size_t> window_lengths;
+    std::vector<bool> prefilter;
+    std::vector<int> similarity_distances;     // -1 = cache off
+    std::vector<float> confidence_thresholds;
+    std::vector<uint8_t> min_peaks;
+    std::vector<float> activity_gates;          // ThresholdConfig::min_peak_magnitude
+};
+
+ParetoGrid get_default_pareto_grid();
+
+/**
+ * @brief Per-window energy on top of the counted compute
+ *
+ * Defaults follow the README energy budget: wake + sample is 50 µJ per
+ * 256-sample window, a LoRa transmission 2000 µJ.
+ */
+struct EnergyModel {
+    CycleCostTable compute;
+    double acquisition_uj_per_sample;
+    double tx_uj;               // Charged for TX_ALERT and TX_UNCERTAIN
+};
+
+EnergyModel get_default_energy_model();
+
+/**
+ * @brief Accuracy and modeled cost of one configuration
+ *
+ * Detection is any transmitting decision; F1 counts windows labeled
+ * normal or anomaly (unknown labels only contribute to energy).
+ */
+struct ParetoPoint {
+    ParetoConfig config;
+    double f1;
+    double precision;
+    double recall;
+    double tx_rate;
+    double compute_uj;          // Per window, from counted ops
+    double energy_uj;           // Per window: acquisition + compute + TX
+    bool on_frontier;
+};
+
+struct ParetoStats {
+    size_t front_ends;          // Cached front-end passes
+    size_t configs;
+    size_t windows;
+};
+
+/**
+ * @brief Evaluate every grid configuration over the dataset
+ *
+ * Front-ends are computed once per window in parallel, then back-ends
+ * (similarity, inference, decision) run per configuration in parallel
+ * over the cached features. Compute energy comes from the operation
+ * counters, so this must be linked against spectral_core_instrumented.
+ *
+ * @param num_threads Worker count (0 = hardware concurrency)
+ * @return Points sorted by energy, frontier flagged
+ */
+std::vector<ParetoPoint> explore_pareto(
+    const Dataset& dataset,
+    const ParetoGrid& grid,
+    const EnergyModel& energy,
+    unsigned num_threads,
+    ParetoStats* stats
+);
+
+/**
+ * @brief Flag points no other point beats on both F1 and energy
+ */
+void mark_pareto_frontier(std::vector<ParetoPoint>* points);
+
+void print_pareto_frontier(std::ostream& out, const std::vector<ParetoPoint>& points);
+
+/**
+ * @brief One row per configuration, frontier flagged
+ */
+void write_pareto_csv(std::ostream& out, const std::vector<ParetoPoint>& points);
+
+} // namespace host
+} // namespace spectral_gate
+
+#endif // PARETO_H
@@ -0,0 +1,56 @@
+#include "recording.h"
+#include <cstdio>
+
+namespace spectral_gate {
+namespace host {
+
+bool load_recording(const std::string& path, std::vector<int16_t>* samples) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+
+    samples->clear();
+    uint8_t block[8192];
+    size_t got;
+    while ((got = std::fread(block, 1, sizeof(block), file)) >= 2) {
+        for (size_t i = 0; i + 1 < got; i += 2) {
+            samples->push_back(static_cast<int16_t>(block[i] | (block[i + 1] << 8)));
+        }
+        if (got & 1) {
+            break;  // Trailing odd byte: truncated file
+        }
+    }
+
+    bool ok = !std::ferror(file);
+    std::fclose(file);
+    return ok;
+}
+
+bool save_recording(const std::string& path, const int16_t* samples, size_t count) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+
+    uint8_t block[8192];
+    size_t fill = 0;
+    bool ok = true;
+    for (size_t i = 0; i < count && ok; ++i) {
+        uint16_t v = static_cast<uint16_t>(samples[i]);
+        block[fill++] = static_cast<uint8_t>(v & 0xFF);
+        block[fill++] = static_cast<uint8_t>(v >> 8);
+        if (fill == sizeof(block)) {
+            ok = std::fwrite(block, 1, fill, file) == fill;
+            fill = 0;
+        }
+    }
+    if (ok && fill > 0) {
+        ok = std::fwrite(block, 1, fill, file) == fill;
+    }
+
+    return (std::fclose(file) == 0) && ok;
+}
+
+} // namespace host
+} // namespace spectral_gate
@@ -0,0 +1,31 @@
+#ifndef RECORDING_H
+#define RECORDING_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace spectral_gate {
+namespace host {
+
+/**
+ * @brief Load a raw recording (headerless little-endian int16 PCM)
+ * @param path File path
+ * @param samples Receives the samples
+ * @return true on success
+ */
+bool load_recording(const std::string& path, std::vector<int16_t>* samples);
+
+/**
+ * @brief Write a raw recording (headerless little-endian int16 PCM)
+ * @param path File path
+ * @param samples Samples to write
+ * @param count Number of samples
+ * @return true on success
+ */
+bool save_recording(const std::string& path, const int16_t* samples, size_t count);
+
+} // namespace host
+} // namespace spectral_gate
+
+#endif // RECORDING_H
@@ -0,0 +1,216 @@
+#include "reference.h"
+#include <cmath>
+#include "model_weights.h"
+
+namespace spectral_gate {
+namespace host {
+
+namespace {
+    const double TWO_PI = 6.283185307179586;
+
+    // Peak threshold relative to the maximum, as analyze_spectrum()
+    const double PEAK_FRACTION = 0.2;
+
+    // Bins mirror each other above num_bins/2, so exact-arithmetic ties
+    // are broken by rounding noise; treat near-equal as equal and keep
+    // the lower bin as the device's strict comparison does
+    const double TIE_TOLERANCE = 1e-9;
+
+    // Outputs closer than this are treated as equal (normalize_outputs())
+    const double UNIFORM_RANGE = 0.001;
+}
+
+ReferenceSpectralProcessor::ReferenceSpectralProcessor(size_t num_bins, uint32_t sample_rate)
+    : num_bins_(num_bins), sample_rate_(sample_rate)
+{
+}
+
+void ReferenceSpectralProcessor::compute_magnitude_spectrum(
+    const int16_t* samples,
+    size_t num_samples,
+    double* magnitudes
+) const {
+    for (size_t k = 0; k < num_bins_; ++k) {
+        // Same bin placement as the device: freq_mult/256 cycles per sample
+        double freq_mult = static_cast<double>((k * 256) / num_bins_);
+        double real_sum = 0.0;
+        double imag_sum = 0.0;
+        for (size_t n = 0; n < num_samples; ++n) {
+            double angle = TWO_PI * freq_mult * static_cast<double>(n) / 256.0;
+            real_sum += samples[n] * std::cos(angle);
+            imag_sum += samples[n] * std::sin(angle);
+        }
+        magnitudes[k] = std::hypot(real_sum, imag_sum) / static_cast<double>(num_samples);
+    }
+}
+
+ReferenceSpectralResult ReferenceSpectralProcessor::analyze_spectrum(
+    const double* magnitudes,
+    size_t count
+) const {
+    ReferenceSpectralResult result = {0.0, 0.0, 0.0, 0, 0};
+
+    for (size_t i = 1; i < count; ++i) {  // Skip DC bin
+        if (magnitudes[i] > result.peak_magnitude * (1.0 + TIE_TOLERANCE)) {
+            result.peak_magnitude = magnitudes[i];
+            result.dominant_bin = i;
+        }
+    }
+    result.dominant_frequency = static_cast<double>(result.dominant_bin) * sample_rate_ /
+                                (2.0 * static_cast<double>(count));
+
+    double threshold = result.peak_magnitude * PEAK_FRACTION;
+    for (size_t i = 1; i + 1 < count; ++i) {
+        if (magnitudes[i] > threshold &&
+            magnitudes[i] > magnitudes[i - 1] &&
+            magnitudes[i] > magnitudes[i + 1]) {
+            ++result.num_peaks;
+        }
+    }
+
+    double weighted_sum = 0.0;
+    double magnitude_sum = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        weighted_sum += magnitudes[i] * static_cast<double>(i);
+        magnitude_sum += magnitudes[i];
+    }
+    result.spectral_centroid = (magnitude_sum > 0.0) ? weighted_sum / magnitude_sum : 0.0;
+    return result;
+}
+
+ReferenceSpectralResult ReferenceSpectralProcessor::process(
+    const int16_t* samples,
+    size_t num_samples
+) const {
+    if (samples == nullptr || num_samples == 0) {
+        return ReferenceSpectralResult{0.0, 0.0, 0.0, 0, 0};
+    }
+    std::vector<double> magnitudes(num_bins_);
+    compute_magnitude_spectrum(samples, num_samples, magnitudes.data());
+    return analyze_spectrum(magnitudes.data(), num_bins_);
+}
+
+size_t ReferenceSpectralProcessor::extract_features(
+    const int16_t* samples,
+    size_t num_samples,
+    double* features,
+    size_t max_features
+) const {
+    if (max_features < num_bins_) {
+        return 0;
+    }
+    compute_magnitude_spectrum(samples, num_samples, features);
+
+    double max_val = 0.0;
+    for (size_t i = 0; i < num_bins_; ++i) {
+        if (features[i] > max_val) max_val = features[i];
+    }
+    if (max_val > 0.0) {
+        for (size_t i = 0; i < num_bins_; ++i) {
+            features[i] /= max_val;
+        }
+    }
+    return num_bins_;
+}
+
+ReferenceInferenceEngine::ReferenceInferenceEngine(
+    const int8_t* weights,
+    const int8_t* biases,
+    size_t input_size,
+    size_t output_size,
+    hal::fixed_t scale_factor
+)
+    : weights_(weights),
+      biases_(biases),
+      input_size_(input_size),
+      output_size_(output_size),
+      scale_(static_cast<double>(scale_factor) / hal::FIXED_ONE)
+{
+}
+
+ReferenceInferenceResult ReferenceInferenceEngine::run(
+    const double* features,
+    size_t num_features
+) const {
+    ReferenceInferenceResult result;
+    result.confidence = 0.0;
+    result.predicted_class = 0;
+    if (num_features != input_size_ || output_size_ == 0) {
+        return result;
+    }
+
+    // Dense layer (int8 weights at 1/128 scale) and ReLU
+    std::vector<double> outputs(output_size_);
+    for (size_t o = 0; o < output_size_; ++o) {
+        double acc = 0.0;
+        for (size_t i = 0; i < input_size_; ++i) {
+            acc += features[i] * weights_[o * input_size_ + i];
+        }
+        double value = acc / 128.0 * scale_ + biases_[o] / 128.0;
+        outputs[o] = (value > 0.0) ? value : 0.0;
+    }
+
+    // Min-max scale, then normalize to sum 1
+    double max_val = outputs[0];
+    double min_val = outputs[0];
+    for (double v : outputs) {
+        if (v > max_val) max_val = v;
+        if (v < min_val) min_val = v;
+    }
+    double range = max_val - min_val;
+    double sum = 0.0;
+    for (double& v : outputs) {
+        v = (range < UNIFORM_RANGE) ? 1.0 : (v - min_val) / range;
+        sum += v;
+    }
+    for (double& v : outputs) {
+        v /= sum;
+    }
+
+    for (size_t o = 1; o < output_size_; ++o) {
+        if (outputs[o] > outputs[result.predicted_class]) {
+            result.predicted_class = static_cast<uint8_t>(o);
+        }
+    }
+    result.confidence = outputs[result.predicted_class];
+    result.probabilities = std::move(outputs);
+    return result;
+}
+
+ReferenceInferenceEngine create_reference_engine() {
+    return ReferenceInferenceEngine(
+        MODEL_WEIGHTS,
+        MODEL_BIASES,
+        MODEL_INPUT_SIZE,
+        MODEL_OUTPUT_SIZE,
+        MODEL_SCALE_FACTOR
+    );
+}
+
+core::SpectralResult to_fixed(const ReferenceSpectralResult& result) {
+    core::SpectralResult out;
+    out.dominant_frequency = static_cast<hal::fixed_t>(std::lround(result.dominant_frequency * hal::FIXED_ONE));
+    out.peak_magnitude = static_cast<hal::fixed_t>(std::lround(result.peak_magnitude));
+    out.spectral_centroid = static_cast<hal::fixed_t>(std::lround(result.spectral_centroid * hal::FIXED_ONE));
+    out.num_peaks = static_cast<uint8_t>((result.num_peaks > 255) ? 255 : result.num_peaks);
+    return out;
+}
+
+core::InferenceResult to_fixed(const ReferenceInferenceResult& result) {
+    core::InferenceResult out;
+    out.confidence = static_cast<hal::fixed_t>(std::lround(result.confidence * hal::FIXED_ONE));
+    out.predicted_class = result.predicted_class;
+    return out;
+}
+
+core::Decision reference_decision(
+    const ReferenceSpectralResult& spectral,
+    const ReferenceInferenceResult& inference,
+    uint16_t battery_mv,
+    const core::ThresholdConfig& config
+) {
+    return core::evaluate_structure(to_fixed(spectral), to_fixed(inference), battery_mv, config);
+}
+
+} // namespace host
+} // namespace spectral_gate
@@ -0,0 +1,130 @@
+#ifndef REFERENCE_H
+#define REFERENCE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "core/decision.h"
+
+namespace spectral_gate {
+namespace host {
+
+/**
+ * @brief Spectral summary in double precision
+ *
+ * Units follow the fixed-point SpectralResult so the two can be compared
+ * directly: frequency in Hz, magnitude in input counts (the raw fixed_t
+ * value of the device magnitude), centroid in bins.
+ */
+struct ReferenceSpectralResult {
+    double dominant_frequency;
+    double peak_magnitude;
+    double spectral_centroid;
+    uint32_t num_peaks;
+    size_t dominant_bin;
+};
+
+/**
+ * @brief Inference output in double precision
+ */
+struct ReferenceInferenceResult {
+    std::vector<double> probabilities;  // Normalized outputs, sum to 1
+    double confidence;
+    uint8_t predicted_class;
+};
+
+/**
+ * @brief Ground-truth counterpart of core::SpectralProcessor
+ *
+ * Same bins, peak rule and centroid as the device path, computed with
+ * an exact DFT (true sin/cos, |z| = hypot) in double precision. The
+ * device path's triangle-wave twiddles, alpha-max-beta-min magnitude and
+ * integer truncation are the error sources it exposes.
+ */
+class ReferenceSpectralProcessor {
+public:
+    ReferenceSpectralProcessor(size_t num_bins, uint32_t sample_rate);
+
+    /**
+     * @brief Exact magnitude spectrum (get_num_bins() entries, counts)
+     */
+    void compute_magnitude_spectrum(const int16_t* samples, size_t num_samples,
+                                    double* magnitudes) const;
+
+    /**
+     * @brief Peak, dominant frequency, peak count and centroid
+     */
+    ReferenceSpectralResult analyze_spectrum(const double* magnitudes, size_t count) const;
+
+    ReferenceSpectralResult process(const int16_t* samples, size_t num_samples) const;
+
+    /**
+     * @brief Spectrum scaled so its maximum is 1.0
+     * @return Number of features (0 if max_features is too small)
+     */
+    size_t extract_features(const int16_t* samples, size_t num_samples,
+                            double* features, size_t max_features) const;
+
+    size_t get_num_bins() const { return num_bins_; }
+
+private:
+    size_t num_bins_;
+    uint32_t sample_rate_;
+};
+
+/**
+ * @brief Ground-truth counterpart of core::InferenceEngine
+ *
+ * Same int8 weights and normalization, evaluated without Q15.16
+ * rounding.
+ */
+class ReferenceInferenceEngine {
+public:
+    ReferenceInferenceEngine(
+        const int8_t* weights,
+        const int8_t* biases,
+        size_t input_size,
+        size_t output_size,
+        hal::fixed_t scale_factor
+    );
+
+    ReferenceInferenceResult run(const double* features, size_t num_features) const;
+
+    size_t get_input_size() const { return input_size_; }
+
+private:
+    const int8_t* weights_;
+    const int8_t* biases_;
+    size_t input_size_;
+    size_t output_size_;
+    double scale_;
+};
+
+/**
+ * @brief Reference engine over the compiled model weights
+ */
+ReferenceInferenceEngine create_reference_engine();
+
+/**
+ * @brief Round reference results to the device representation
+ */
+core::SpectralResult to_fixed(const ReferenceSpectralResult& result);
+core::InferenceResult to_fixed(const ReferenceInferenceResult& result);
+
+/**
+ * @brief Decision the device would make given exact stage outputs
+ *
+ * The decision rule itself is exact thresholding, so the reference
+ * results are rounded and passed to core::evaluate_structure().
+ */
+core::Decision reference_decision(
+    const ReferenceSpectralResult& spectral,
+    const ReferenceInferenceResult& inference,
+    uint16_t battery_mv,
+    const core::ThresholdConfig& config
+);
+
+} // namespace host
+} // namespace spectral_gate
+
+#endif // REFERENCE_H
@@ -0,0 +1,323 @@
+#include "replay.h"
+#include "parallel.h"
+#include "recording.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+#include "core/inference.h"
+#include "core/pipeline.h"
+#include "core/spectral.h"
+
+namespace spectral_gate {
+namespace host {
+
+using namespace hal;
+
+namespace {
+    // Nodes handed to a worker at a time
+    constexpr size_t NODES_PER_CHUNK = 8;
+
+    uint64_t window_key(uint16_t node_id, uint32_t time_s) {
+        return (static_cast<uint64_t>(node_id) << 32) | time_s;
+    }
+
+    bool has_feature_summary(const DecisionColumns& log, size_t row) {
+        return log.num_peaks[row] != 0 || log.peak_magnitude[row] != 0 ||
+               log.dominant_frequency[row] != 0;
+    }
+}
+
+ReplayConfig get_default_replay_config() {
+    ReplayConfig config;
+    config.thresholds = core::get_default_config();
+    config.num_bins = NUM_SPECTRAL_BINS;
+    config.sample_rate = 1000;
+    config.num_threads = 0;
+    return config;
+}
+
+bool load_replay_windows(const std::string& path, std::vector<ReplayWindow>* windows) {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+
+    size_t slash = path.find_last_of("/\\");
+    std::string dir = (slash == std::string::npos) ? "" : path.substr(0, slash + 1);
+
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string first;
+        if (!(fields >> first) || first[0] == '#') {
+            continue;
+        }
+
+        uint32_t time_s = 0;
+        std::string recording;
+        if (!(fields >> time_s >> recording)) {
+            return false;
+        }
+
+        ReplayWindow window;
+        window.node_id = static_cast<uint16_t>(std::strtoul(first.c_str(), nullptr, 10));
+        window.time_s = time_s;
+        bool absolute = (recording[0] == '/') || (recording.find(':') != std::string::npos);
+        if (!load_recording(absolute ? recording : dir + recording, &window.samples) ||
+            window.samples.empty()) {
+            return false;
+        }
+        windows->push_back(std::move(window));
+    }
+    return true;
+}
+
+const char* replay_mode_name(ReplayMode mode) {
+    switch (mode) {
+        case ReplayMode::SKIPPED:  return "skipped";
+        case ReplayMode::FEATURES: return "features";
+        case ReplayMode::PIPELINE: return "pipeline";
+    }
+    return "?";
+}
+
+ReplayReport replay_decisions(
+    const DecisionColumns& log,
+    const std::vector<ReplayWindow>& windows,
+    const ReplayConfig& config
+) {
+    ReplayReport report;
+
+    // Records grouped by node with a stable counting sort; logs are
+    // written in time order, so each node's slice usually needs no sort
+    std::vector<size_t> node_begin;
+    std::vector<size_t> order(log.size());
+    {
+        std::vector<size_t> slot(65537, 0);
+        for (size_t i = 0; i < log.size(); ++i) {
+            ++slot[log.node_id[i] + 1];
+        }
+        for (size_t id = 0; id < 65536; ++id) {
+            if (slot[id + 1] != 0) {
+                node_begin.push_back(slot[id]);
+            }
+            slot[id + 1] += slot[id];
+        }
+        for (size_t i = 0; i < log.size(); ++i) {
+            order[slot[log.node_id[i]]++] = i;
+        }
+    }
+    const size_t num_nodes = node_begin.size();
+    node_begin.push_back(order.size());
+
+    std::unordered_map<uint64_t, size_t> window_index;
+    window_index.reserve(windows.size());
+    for (size_t w = 0; w < windows.size(); ++w) {
+        window_index[window_key(windows[w].node_id, windows[w].time_s)] = w;
+    }
+
+    report.nodes.resize(num_nodes);
+    std::vector<std::vector<ReplayDivergence>> node_divergences(num_nodes);
+
+    parallel_for(num_nodes, config.num_threads, NODES_PER_CHUNK,
+        [&](size_t begin, size_t end, unsigned /*worker*/) {
+            core::SpectralProcessor processor(config.num_bins, config.sample_rate);
+            core::InferenceEngine engine = core::create_default_engine();
+            core::WindowPipeline pipeline(processor, engine, config.thresholds);
+            std::vector<int16_t> scratch;
+
+            for (size_t n = begin; n < end; ++n) {
+                NodeReplaySummary& summary = report.nodes[n];
+                summary = NodeReplaySummary();
+                summary.node_id = log.node_id[order[node_begin[n]]];
+
+                auto by_time = [&](size_t a, size_t b) { return log.time_s[a] < log.time_s[b]; };
+                auto first = order.begin() + static_cast<std::ptrdiff_t>(node_begin[n]);
+                auto last = order.begin() + static_cast<std::ptrdiff_t>(node_begin[n + 1]);
+                if (!std::is_sorted(first, last, by_time)) {
+                    std::stable_sort(first, last, by_time);
+                }
+
+                for (size_t i = node_begin[n]; i < node_begin[n + 1]; ++i) {
+                    const size_t row = order[i];
+                    const uint16_t battery = log.battery_mv[row];
+                    ++summary.records;
+
+                    core::SpectralResult spectral{};
+                    core::InferenceResult inference{};
+                    core::Decision decision;
+                    ReplayMode mode;
+                    auto uploaded = window_index.find(window_key(summary.node_id, log.time_s[row]));
+                    if (uploaded != window_index.end()) {
+                        const ReplayWindow& window = windows[uploaded->second];
+                        scratch.assign(window.samples.begin(), window.samples.end());
+                        core::WindowOutcome outcome =
+                            pipeline.process_window(scratch.data(), scratch.size(), battery);
+                        inference = outcome.inference;
+                        decision = outcome.decision;
+                        mode = ReplayMode::PIPELINE;
+                        ++summary.replayed_pipeline;
+                    } else if (has_feature_summary(log, row)) {
+                        spectral.dominant_frequency = log.dominant_frequency[row];
+                        spectral.peak_magnitude = log.peak_magnitude[row];
+                        spectral.num_peaks = log.num_peaks[row];
+                        inference.predicted_class = log.predicted_class[row];
+                        inference.confidence = log.confidence[row];
+                        decision = core::evaluate_structure(spectral, inference, battery, config.thresholds);
+                        mode = ReplayMode::FEATURES;
+                        ++summary.replayed_features;
+                    } else {
+                        ++summary.skipped;
+                        continue;
+                    }
+
+                    core::DecisionReason reason = core::get_decision_reason(
+                        decision, inference, battery,
+                        core::get_effective_threshold(battery, config.thresholds));
+                    if (decision == log.decision[row] && reason == log.reason[row]) {
+                        continue;
+                    }
+                    if (decision != log.decision[row]) {
+                        ++summary.decision_divergences;
+                    } else {
+                        ++summary.reason_divergences;
+                    }
+
+                    ReplayDivergence d;
+                    d.row = row;
+                    d.node_id = summary.node_id;
+                    d.time_s = log.time_s[row];
+                    d.battery_mv = battery;
+                    d.mode = mode;
+                    d.logged_decision = log.decision[row];
+                    d.replayed_decision = decision;
+                    d.logged_reason = log.reason[row];
+                    d.replayed_reason = reason;
+                    d.logged_class = log.predicted_class[row];
+                    d.replayed_class = inference.predicted_class;
+                    d.logged_confidence = log.confidence[row];
+                    d.replayed_confidence = inference.confidence;
+                    node_divergences[n].push_back(d);
+                }
+            }
+        });
+
+    for (const std::vector<ReplayDivergence>& divergences : node_divergences) {
+        report.divergences.insert(report.divergences.end(), divergences.begin(), divergences.end());
+    }
+    return report;
+}
+
+void print_replay_report(std::ostream& out, const ReplayReport& report, size_t max_divergences) {
+    NodeReplaySummary total = NodeReplaySummary();
+    size_t divergent_nodes = 0;
+    for (const NodeReplaySummary& s : report.nodes) {
+        total.records += s.records;
+        total.replayed_features += s.replayed_features;
+        total.replayed_pipeline += s.replayed_pipeline;
+        total.skipped += s.skipped;
+        total.decision_divergences += s.decision_divergences;
+        total.reason_divergences += s.reason_divergences;
+        if (s.decision_divergences + s.reason_divergences > 0) {
+            ++divergent_nodes;
+        }
+    }
+
+    out << "Replayed " << total.records << " records from " << report.nodes.size() << " nodes: "
+        << total.replayed_features << " on logged features, "
+        << total.replayed_pipeline << " through the pipeline, "
+        << total.skipped << " skipped\n";
+    out << total.decision_divergences << " decision divergences, "
+        << total.reason_divergences << " reason-only divergences on "
+        << divergent_nodes << " nodes\n";
+    if (divergent_nodes == 0) {
+        return;
+    }
+
+    // Nodes with the most divergences first
+    std::vector<const NodeReplaySummary*> ranked;
+    for (const NodeReplaySummary& s : report.nodes) {
+        if (s.decision_divergences + s.reason_divergences > 0) {
+            ranked.push_back(&s);
+        }
+    }
+    std::stable_sort(ranked.begin(), ranked.end(),
+                     [](const NodeReplaySummary* a, const NodeReplaySummary* b) {
+                         return a->decision_divergences + a->reason_divergences >
+                                b->decision_divergences + b->reason_divergences;
+                     });
+    size_t ranked_shown = std::min(max_divergences, ranked.size());
+    if (ranked_shown == 0) {
+        return;
+    }
+
+    out << "\n  node   records  features  pipeline   skipped decisions   reasons\n";
+    for (size_t i = 0; i < ranked_shown; ++i) {
+        const NodeReplaySummary& s = *ranked[i];
+        char line[128];
+        std::snprintf(line, sizeof(line), "%6u %9llu %9llu %9llu %9llu %9llu %9llu\n",
+                      static_cast<unsigned>(s.node_id),
+                      static_cast<unsigned long long>(s.records),
+                      static_cast<unsigned long long>(s.replayed_features),
+                      static_cast<unsigned long long>(s.replayed_pipeline),
+                      static_cast<unsigned long long>(s.skipped),
+                      static_cast<unsigned long long>(s.decision_divergences),
+                      static_cast<unsigned long long>(s.reason_divergences));
+        out << line;
+    }
+    if (ranked_shown < ranked.size()) {
+        out << "(" << ranked.size() - ranked_shown << " more nodes)\n";
+    }
+
+    size_t shown = std::min(max_divergences, report.divergences.size());
+    if (shown == 0) {
+        return;
+    }
+    out << "\n  node       time  V_bat  mode      logged                               replayed\n";
+    for (size_t i = 0; i < shown; ++i) {
+        const ReplayDivergence& d = report.divergences[i];
+        char time[16];
+        format_log_time(d.time_s, time, sizeof(time));
+        char line[192];
+        std::snprintf(line, sizeof(line),
+                      "%6u %10s %6u  %-8s  %-12s %-12s c%u %5.1f%%  %-12s %-12s c%u %5.1f%%\n",
+                      static_cast<unsigned>(d.node_id), time, static_cast<unsigned>(d.battery_mv),
+                      replay_mode_name(d.mode),
+                      core::decision_to_string(d.logged_decision),
+                      core::decision_reason_to_string(d.logged_reason),
+                      static_cast<unsigned>(d.logged_class),
+                      fixed_to_float(d.logged_confidence) * 100.0f,
+                      core::decision_to_string(d.replayed_decision),
+                      core::decision_reason_to_string(d.replayed_reason),
+                      static_cast<unsigned>(d.replayed_class),
+                      fixed_to_float(d.replayed_confidence) * 100.0f);
+        out << line;
+    }
+    if (shown < report.divergences.size()) {
+        out << "(" << report.divergences.size() - shown << " more)\n";
+    }
+}
+
+void write_replay_divergences_csv(std::ostream& out, const ReplayReport& report) {
+    out << "row,node_id,time_s,battery_mv,mode,logged_decision,replayed_decision,"
+           "logged_reason,replayed_reason,logged_class,replayed_class,"
+           "logged_confidence,replayed_confidence\n";
+    for (const ReplayDivergence& d : report.divergences) {
+        out << d.row << "," << d.node_id << "," << d.time_s << "," << d.battery_mv << ","
+            << replay_mode_name(d.mode) << ","
+            << core::decision_to_string(d.logged_decision) << ","
+            << core::decision_to_string(d.replayed_decision) << ","
+            << core::decision_reason_to_string(d.logged_reason) << ","
+            << core::decision_reason_to_string(d.replayed_reason) << ","
+            << static_cast<unsigned>(d.logged_class) << ","
+            << static_cast<unsigned>(d.replayed_class) << ","
+            << fixed_to_float(d.logged_confidence) << ","
+            << fixed_to_float(d.replayed_confidence) << "\n";
+    }
+}
+
+} // namespace host
+} // namespace spectral_gate
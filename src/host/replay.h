@@ -0,0 +1,135 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "core/decision.h"
+#include "decision_log.h"
+
+namespace spectral_gate {
+namespace host {
+
+/**
+ * @brief Settings of a decision replay
+ */
+struct ReplayConfig {
+    core::ThresholdConfig thresholds;   // Configuration under test
+    size_t num_bins;                    // Spectral stage of the pipeline replay
+    uint32_t sample_rate;
+    unsigned num_threads;               // 0 = hardware concurrency
+};
+
+/**
+ * @brief Current firmware settings (get_default_config(), 64 bins, 1 kHz)
+ */
+ReplayConfig get_default_replay_config();
+
+/**
+ * @brief A raw window uploaded by a node, matched to a log record by
+ *        node id and time
+ */
+struct ReplayWindow {
+    uint16_t node_id;
+    uint32_t time_s;
+    std::vector<int16_t> samples;
+};
+
+/**
+ * @brief Load uploaded windows listed in a manifest
+ *
+ * One window per line: `<node_id> <time_s> <recording>`, where the
+ * recording (recording.h) holds exactly the window's samples. Blank lines
+ * and lines starting with '#' are ignored; relative paths are resolved
+ * against the manifest's directory.
+ *
+ * @return false if the manifest or any recording cannot be read
+ */
+bool load_replay_windows(const std::string& path, std::vector<ReplayWindow>* windows);
+
+/**
+ * @brief How a record was replayed
+ */
+enum class ReplayMode : uint8_t {
+    SKIPPED = 0,        // No feature summary and no uploaded window
+    FEATURES = 1,       // evaluate_structure() on the logged feature summary
+    PIPELINE = 2        // Whole window pipeline on the uploaded window
+};
+
+const char* replay_mode_name(ReplayMode mode);
+
+/**
+ * @brief A record whose replayed decision or reason differs from the log
+ */
+struct ReplayDivergence {
+    size_t row;                         // Record index in the log
+    uint16_t node_id;
+    uint32_t time_s;
+    uint16_t battery_mv;
+    ReplayMode mode;
+    core::Decision logged_decision;
+    core::Decision replayed_decision;
+    core::DecisionReason logged_reason;
+    core::DecisionReason replayed_reason;
+    uint8_t logged_class;
+    uint8_t replayed_class;
+    hal::fixed_t logged_confidence;
+    hal::fixed_t replayed_confidence;
+};
+
+/**
+ * @brief Replay counts for one node
+ */
+struct NodeReplaySummary {
+    uint16_t node_id;
+    uint64_t records;
+    uint64_t replayed_features;
+    uint64_t replayed_pipeline;
+    uint64_t skipped;
+    uint64_t decision_divergences;
+    uint64_t reason_divergences;        // Same decision, different reason
+};
+
+/**
+ * @brief Outcome of a replay, ordered by node id then record time
+ */
+struct ReplayReport {
+    std::vector<NodeReplaySummary> nodes;
+    std::vector<ReplayDivergence> divergences;
+};
+
+/**
+ * @brief Re-run every logged decision and diff it against the log
+ *
+ * Records are grouped per node and replayed in time order, one node per
+ * task across num_threads workers; each node gets its own stage objects,
+ * so the report is identical for any thread count. A record with an
+ * uploaded window goes through the whole pipeline (no pre-filter or
+ * similarity cache); otherwise a record that carries a feature summary
+ * goes through evaluate_structure(). Records converted from node event
+ * batches have no feature summary and are skipped unless a window was
+ * uploaded for them.
+ */
+ReplayReport replay_decisions(
+    const DecisionColumns& log,
+    const std::vector<ReplayWindow>& windows,
+    const ReplayConfig& config
+);
+
+/**
+ * @brief Totals, then up to max_divergences of the most divergent nodes
+ *        and the first max_divergences divergent records
+ */
+void print_replay_report(std::ostream& out, const ReplayReport& report, size_t max_divergences);
+
+/**
+ * @brief One CSV row per divergent record
+ */
+void write_replay_divergences_csv(std::ostream& out, const ReplayReport& report);
+
+} // namespace host
+} // namespace spectral_gate
+
+#endif // REPLAY_H
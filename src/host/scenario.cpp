@@ -0,0 +1,514 @@
+#include "scenario.h"
+#include "decision_log.h"
+#include "parallel.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include "core/event_ring.h"
+#include "core/inference.h"
+#include "core/pipeline.h"
+#include "core/spectral.h"
+
+namespace spectral_gate {
+namespace host {
+
+using namespace hal;
+
+namespace {
+    constexpr uint32_t SAMPLE_RATE = 1000;
+    constexpr unsigned long MAX_TIME_S = 0xFFFFFFFFul / 1000;  // The virtual clock counts uint32 ms
+
+    enum Column {
+        COL_SCENARIO, COL_TIME, COL_PHASE, COL_BATTERY, COL_SIGNAL, COL_FREQUENCY,
+        COL_AMPLITUDE, COL_NOISE, COL_CONFIDENCE, COL_CLASS, COL_PEAKS, COL_MAGNITUDE,
+        COL_MIN_MAGNITUDE, COL_EXPECT, NUM_COLUMNS
+    };
+
+    const char* const COLUMN_NAMES[NUM_COLUMNS] = {
+        "scenario", "time", "phase", "battery_mv", "signal", "frequency_hz",
+        "amplitude", "noise", "confidence", "class", "peaks", "magnitude", "min_magnitude",
+        "expect"
+    };
+
+    std::string trim(const std::string& s) {
+        size_t begin = s.find_first_not_of(" \t\r");
+        if (begin == std::string::npos) {
+            return "";
+        }
+        size_t end = s.find_last_not_of(" \t\r");
+        return s.substr(begin, end - begin + 1);
+    }
+
+    // Comma-separated fields; a field may be double-quoted ("" inside quotes is a quote)
+    bool split_csv(const std::string& line, std::vector<std::string>* fields) {
+        fields->clear();
+        size_t i = 0;
+        for (;;) {
+            while (i < line.size() && (line[i] == ' ' || line[i] == '\t')) {
+                ++i;
+            }
+            std::string field;
+            if (i < line.size() && line[i] == '"') {
+                ++i;
+                for (;;) {
+                    if (i >= line.size()) {
+                        return false;
+                    }
+                    if (line[i] == '"') {
+                        if (i + 1 < line.size() && line[i + 1] == '"') {
+                            field += '"';
+                            i += 2;
+                            continue;
+                        }
+                        ++i;
+                        break;
+                    }
+                    field += line[i++];
+                }
+                size_t comma = line.find(',', i);
+                if (!trim(line.substr(i, comma == std::string::npos ? std::string::npos : comma - i)).empty()) {
+                    return false;
+                }
+                i = comma;
+            } else {
+                size_t comma = line.find(',', i);
+                field = trim(line.substr(i, comma == std::string::npos ? std::string::npos : comma - i));
+                i = comma;
+            }
+            fields->push_back(field);
+            if (i == std::string::npos) {
+                return true;
+            }
+            ++i;
+        }
+    }
+
+    bool parse_unsigned(const std::string& text, unsigned long max, unsigned long* value) {
+        if (text.empty()) {
+            return false;
+        }
+        char* end = nullptr;
+        unsigned long v = std::strtoul(text.c_str(), &end, 10);
+        if (*end != '\0' || v > max || text[0] == '-') {
+            return false;
+        }
+        *value = v;
+        return true;
+    }
+
+    bool parse_float(const std::string& text, float* value) {
+        if (text.empty()) {
+            return false;
+        }
+        char* end = nullptr;
+        *value = std::strtof(text.c_str(), &end);
+        return *end == '\0';
+    }
+
+    // Seconds, or HH:MM / HH:MM:SS; at most MAX_TIME_S (about 49.7 days)
+    bool parse_time(const std::string& text, uint32_t* time_s) {
+        unsigned long parts[3] = {0, 0, 0};
+        size_t count = 0;
+        size_t start = 0;
+        for (;;) {
+            size_t colon = text.find(':', start);
+            std::string part = text.substr(start, colon == std::string::npos ? std::string::npos : colon - start);
+            if (count == 3 || !parse_unsigned(part, MAX_TIME_S, &parts[count])) {
+                return false;
+            }
+            ++count;
+            if (colon == std::string::npos) {
+                break;
+            }
+            start = colon + 1;
+        }
+        if (count == 1) {
+            *time_s = static_cast<uint32_t>(parts[0]);
+            return true;
+        }
+        if (parts[1] > 59 || parts[2] > 59) {
+            return false;
+        }
+        if (parts[0] > MAX_TIME_S / 3600) {
+            return false;
+        }
+        unsigned long total = parts[0] * 3600 + parts[1] * 60 + parts[2];
+        if (total > MAX_TIME_S) {
+            return false;
+        }
+        *time_s = static_cast<uint32_t>(total);
+        return true;
+    }
+
+    bool parse_signal(const std::string& text, ScenarioSignal* signal) {
+        if (text == "features") { *signal = ScenarioSignal::FEATURES; return true; }
+        if (text == "noise")    { *signal = ScenarioSignal::NOISE;    return true; }
+        if (text == "sine")     { *signal = ScenarioSignal::SINE;     return true; }
+        if (text == "anomaly")  { *signal = ScenarioSignal::ANOMALY;  return true; }
+        return false;
+    }
+
+    bool parse_decision(const std::string& text, core::Decision* decision) {
+        const core::Decision all[] = {
+            core::Decision::SLEEP, core::Decision::TX_ALERT, core::Decision::TX_UNCERTAIN
+        };
+        for (core::Decision d : all) {
+            if (text == core::decision_to_string(d)) {
+                *decision = d;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint32_t name_seed(const std::string& name) {
+        uint32_t hash = 2166136261u;
+        for (char c : name) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    double milliseconds_since(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+bool parse_scenarios(
+    std::istream& in,
+    const std::string& source,
+    std::vector<Scenario>* scenarios,
+    std::string* error
+) {
+    int columns[NUM_COLUMNS];
+    for (int& c : columns) {
+        c = -1;
+    }
+    bool have_header = false;
+    std::vector<std::string> fields;
+    std::string line;
+    size_t line_number = 0;
+    const size_t first_scenario = scenarios->size();
+
+    auto fail = [&](const std::string& message) {
+        *error = source + ":" + std::to_string(line_number) + ": " + message;
+        return false;
+    };
+
+    while (std::getline(in, line)) {
+        ++line_number;
+        std::string text = trim(line);
+        if (text.empty() || text[0] == '#') {
+            continue;
+        }
+        if (!split_csv(text, &fields)) {
+            return fail("unterminated quote");
+        }
+
+        if (!have_header) {
+            for (size_t f = 0; f < fields.size(); ++f) {
+                int column = -1;
+                for (int c = 0; c < NUM_COLUMNS; ++c) {
+                    if (fields[f] == COLUMN_NAMES[c]) {
+                        column = c;
+                    }
+                }
+                if (column < 0) {
+                    return fail("unknown column '" + fields[f] + "'");
+                }
+                columns[column] = static_cast<int>(f);
+            }
+            if (columns[COL_SCENARIO] < 0 || columns[COL_TIME] < 0 || columns[COL_SIGNAL] < 0) {
+                return fail("header needs scenario, time and signal columns");
+            }
+            have_header = true;
+            continue;
+        }
+
+        auto field = [&](Column c) -> std::string {
+            int index = columns[c];
+            return (index >= 0 && static_cast<size_t>(index) < fields.size()) ? fields[index] : "";
+        };
+
+        ScenarioStep step = ScenarioStep();
+        step.line = line_number;
+        step.phase = field(COL_PHASE);
+        step.frequency_hz = 100;            // MockHAL defaults
+        step.amplitude = 8000;
+        step.noise = 500;
+
+        std::string name = field(COL_SCENARIO);
+        if (name.empty()) {
+            return fail("missing scenario name");
+        }
+        if (!parse_time(field(COL_TIME), &step.time_s)) {
+            return fail("bad time '" + field(COL_TIME) + "'");
+        }
+        if (!parse_signal(field(COL_SIGNAL), &step.signal)) {
+            return fail("bad signal '" + field(COL_SIGNAL) + "' (features, noise, sine or anomaly)");
+        }
+
+        unsigned long value = 0;
+        if (!field(COL_BATTERY).empty()) {
+            if (!parse_unsigned(field(COL_BATTERY), 0xFFFF, &value)) {
+                return fail("bad battery_mv '" + field(COL_BATTERY) + "'");
+            }
+            step.battery_set = true;
+            step.battery_mv = static_cast<uint16_t>(value);
+        }
+        if (!field(COL_FREQUENCY).empty()) {
+            if (!parse_unsigned(field(COL_FREQUENCY), SAMPLE_RATE / 2, &value)) {
+                return fail("bad frequency_hz '" + field(COL_FREQUENCY) + "'");
+            }
+            step.frequency_hz = static_cast<uint32_t>(value);
+        }
+        if (!field(COL_AMPLITUDE).empty()) {
+            if (!parse_unsigned(field(COL_AMPLITUDE), 32767, &value)) {
+                return fail("bad amplitude '" + field(COL_AMPLITUDE) + "'");
+            }
+            step.amplitude = static_cast<int16_t>(value);
+        }
+        if (!field(COL_NOISE).empty()) {
+            if (!parse_unsigned(field(COL_NOISE), 32767, &value)) {
+                return fail("bad noise '" + field(COL_NOISE) + "'");
+            }
+            step.noise = static_cast<int16_t>(value);
+        }
+
+        if (step.signal == ScenarioSignal::FEATURES) {
+            if (!parse_float(field(COL_CONFIDENCE), &step.confidence) ||
+                step.confidence < 0.0f || step.confidence > 1.0f) {
+                return fail("features step needs confidence in [0, 1]");
+            }
+            if (!parse_unsigned(field(COL_CLASS), 2, &value)) {
+                return fail("features step needs class 0, 1 or 2");
+            }
+            step.predicted_class = static_cast<uint8_t>(value);
+            if (!parse_unsigned(field(COL_PEAKS), 255, &value)) {
+                return fail("features step needs peaks");
+            }
+            step.num_peaks = static_cast<uint8_t>(value);
+            if (!parse_float(field(COL_MAGNITUDE), &step.peak_magnitude)) {
+                return fail("features step needs magnitude");
+            }
+        }
+
+        if (!field(COL_MIN_MAGNITUDE).empty()) {
+            if (!parse_float(field(COL_MIN_MAGNITUDE), &step.min_magnitude) ||
+                step.min_magnitude < 0.0f || step.min_magnitude > 1.0f) {
+                return fail("bad min_magnitude '" + field(COL_MIN_MAGNITUDE) + "'");
+            }
+            step.min_magnitude_set = true;
+        }
+
+        if (!field(COL_EXPECT).empty()) {
+            if (!parse_decision(field(COL_EXPECT), &step.expected)) {
+                return fail("bad expect '" + field(COL_EXPECT) + "' (SLEEP, TX_ALERT or TX_UNCERTAIN)");
+            }
+            step.expect_set = true;
+        }
+
+        Scenario* scenario = nullptr;
+        for (size_t s = first_scenario; s < scenarios->size(); ++s) {
+            if ((*scenarios)[s].name == name) {
+                scenario = &(*scenarios)[s];
+            }
+        }
+        if (scenario == nullptr) {
+            scenarios->push_back(Scenario());
+            scenario = &scenarios->back();
+            scenario->name = name;
+        }
+        if (!scenario->steps.empty() && step.time_s < scenario->steps.back().time_s) {
+            return fail("time goes backwards in scenario '" + name + "'");
+        }
+        scenario->steps.push_back(step);
+    }
+
+    if (!have_header) {
+        return fail("no header line");
+    }
+    return true;
+}
+
+bool load_scenarios(const std::string& path, std::vector<Scenario>* scenarios, std::string* error) {
+    std::ifstream in(path);
+    if (!in) {
+        *error = path + ": cannot open";
+        return false;
+    }
+    return parse_scenarios(in, path, scenarios, error);
+}
+
+ScenarioResult run_scenario(
+    const Scenario& scenario,
+    const core::ThresholdConfig& config,
+    MockHAL& hal,
+    const ScenarioStepCallback& on_step
+) {
+    auto start = std::chrono::steady_clock::now();
+    ScenarioResult result = ScenarioResult();
+    result.name = scenario.name;
+    result.steps = scenario.steps.size();
+
+    hal.set_virtual_clock(true);
+    hal.set_seed(name_seed(scenario.name));
+    const uint32_t transmissions_before = hal.get_transmit_count();
+
+    core::SpectralProcessor processor(NUM_SPECTRAL_BINS, SAMPLE_RATE);
+    core::InferenceEngine engine = core::create_default_engine();
+    core::WindowPipeline pipeline(processor, engine, config);
+    core::EventRing events(hal.get_event_ring_area(), EVENT_RING_AREA_BYTES);
+    events.reset();
+    int16_t window[VIBRATION_BUFFER_SIZE];
+
+    for (const ScenarioStep& step : scenario.steps) {
+        // Sleep until the window is due (parse_time() keeps it within the uint32 ms clock)
+        uint32_t due_ms = step.time_s * 1000;
+        uint32_t now_ms = hal.get_tick_ms();
+        if (due_ms > now_ms) {
+            hal.enter_sleep(due_ms - now_ms);
+        }
+        if (step.battery_set) {
+            hal.set_battery_voltage(step.battery_mv);
+        }
+
+        core::ThresholdConfig step_config = config;
+        if (step.min_magnitude_set) {
+            step_config.min_peak_magnitude = float_to_fixed(step.min_magnitude);
+        }
+
+        ScenarioStepOutcome outcome = ScenarioStepOutcome();
+        outcome.time_s = step.time_s;
+        outcome.battery_mv = hal.get_battery_voltage_mv();
+        if (step.signal == ScenarioSignal::FEATURES) {
+            outcome.spectral.peak_magnitude = float_to_fixed(step.peak_magnitude);
+            outcome.spectral.num_peaks = step.num_peaks;
+            outcome.inference.confidence = float_to_fixed(step.confidence);
+            outcome.inference.predicted_class = step.predicted_class;
+            outcome.decision = core::evaluate_structure(
+                outcome.spectral, outcome.inference, outcome.battery_mv, step_config);
+        } else {
+            hal.set_vibration_pattern(static_cast<uint8_t>(static_cast<uint8_t>(step.signal) - 1));
+            hal.set_signal_frequency(step.frequency_hz);
+            hal.set_signal_amplitude(step.amplitude);
+            hal.set_noise_level(step.noise);
+            size_t n = hal.read_vibration_data(window, VIBRATION_BUFFER_SIZE);
+            pipeline.set_config(step_config);
+            core::WindowOutcome window_outcome = pipeline.process_window(window, n, outcome.battery_mv);
+            outcome.spectral = window_outcome.spectral;
+            outcome.inference = window_outcome.inference;
+            outcome.decision = window_outcome.decision;
+        }
+        outcome.threshold = core::get_effective_threshold(outcome.battery_mv, step_config);
+        outcome.reason = core::get_decision_reason(
+            outcome.decision, outcome.inference, outcome.battery_mv, outcome.threshold);
+        outcome.passed = !step.expect_set || outcome.decision == step.expected;
+
+        ++result.decisions[static_cast<size_t>(outcome.decision)];
+        if (step.expect_set) {
+            ++result.checked;
+        }
+        if (!outcome.passed) {
+            ScenarioFailure failure;
+            failure.line = step.line;
+            failure.time_s = step.time_s;
+            failure.expected = step.expected;
+            failure.actual = outcome.decision;
+            failure.reason = outcome.reason;
+            failure.confidence = outcome.inference.confidence;
+            failure.threshold = outcome.threshold;
+            result.failures.push_back(failure);
+        }
+        if (on_step) {
+            on_step(step, outcome);
+        }
+
+        // Node actions: record the event, transmit or batch it to flash
+        core::EventRecord event = core::make_event_record(
+            step.time_s, outcome.battery_mv, outcome.inference, outcome.decision, outcome.reason);
+        events.push(event);
+        if (outcome.decision == core::Decision::SLEEP) {
+            core::spill_events(hal, events, false);
+        } else {
+            uint8_t alert_type = (outcome.decision == core::Decision::TX_ALERT) ? 1 : 0;
+            core::transmit_alert_with_events(hal, events, alert_type, event.confidence_pct, step.time_s);
+        }
+    }
+
+    // End of run: nothing may stay behind in RAM
+    core::spill_events(hal, events, true);
+
+    result.transmissions = hal.get_transmit_count() - transmissions_before;
+    result.end_time_s = hal.get_tick_ms() / 1000;
+    result.runtime_ms = milliseconds_since(start);
+    return result;
+}
+
+std::vector<ScenarioResult> run_scenarios(
+    const std::vector<Scenario>& scenarios,
+    const core::ThresholdConfig& config,
+    unsigned num_threads
+) {
+    std::vector<ScenarioResult> results(scenarios.size());
+    parallel_for(scenarios.size(), num_threads, 1,
+        [&](size_t begin, size_t end, unsigned /*worker*/) {
+            for (size_t s = begin; s < end; ++s) {
+                MockHAL hal(BATTERY_NOMINAL_MV);
+                hal.set_verbose(false);
+                results[s] = run_scenario(scenarios[s], config, hal, ScenarioStepCallback());
+            }
+        });
+    return results;
+}
+
+void print_scenario_report(std::ostream& out, const std::vector<ScenarioResult>& results) {
+    size_t passed = 0;
+    size_t steps = 0;
+    double runtime_ms = 0.0;
+    char line[192];
+
+    for (const ScenarioResult& r : results) {
+        char end_time[16];
+        format_log_time(r.end_time_s, end_time, sizeof(end_time));
+        std::snprintf(line, sizeof(line), "%s  %-32s %5zu steps %5zu checked %9.3f ms  (to %s, %u TX)\n",
+                      r.passed() ? "PASS" : "FAIL", r.name.c_str(), r.steps, r.checked,
+                      r.runtime_ms, end_time, static_cast<unsigned>(r.transmissions));
+        out << line;
+        for (const ScenarioFailure& f : r.failures) {
+            char time[16];
+            format_log_time(f.time_s, time, sizeof(time));
+            std::snprintf(line, sizeof(line),
+                          "        line %zu at %s: expected %s, got %s (%s, confidence %.1f%%, threshold %.1f%%)\n",
+                          f.line, time, core::decision_to_string(f.expected),
+                          core::decision_to_string(f.actual), core::decision_reason_to_string(f.reason),
+                          fixed_to_float(f.confidence) * 100.0f, fixed_to_float(f.threshold) * 100.0f);
+            out << line;
+        }
+        if (r.passed()) {
+            ++passed;
+        }
+        steps += r.steps;
+        runtime_ms += r.runtime_ms;
+    }
+
+    out << "\n" << results.size() << " scenarios: " << passed << " passed, "
+        << results.size() - passed << " failed (" << steps << " steps, "
+        << runtime_ms << " ms of scenario time summed over workers)\n";
+}
+
+void write_scenario_csv(std::ostream& out, const std::vector<ScenarioResult>& results) {
+    out << "scenario,result,steps,checked,failures,sleep,tx_alert,tx_uncertain,"
+           "transmissions,end_time_s,runtime_ms\n";
+    for (const ScenarioResult& r : results) {
+        out << r.name << "," << (r.passed() ? "PASS" : "FAIL") << "," << r.steps << ","
+            << r.checked << "," << r.failures.size() << "," << r.decisions[0] << ","
+            << r.decisions[1] << "," << r.decisions[2] << "," << r.transmissions << ","
+            << r.end_time_s << "," << r.runtime_ms << "\n";
+    }
+}
+
+} // namespace host
+} // namespace spectral_gate
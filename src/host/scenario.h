@@ -0,0 +1,185 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "hal/hal_mock.h"
+#include "core/decision.h"
+
+namespace spectral_gate {
+namespace host {
+
+/**
+ * @brief Input of a scenario step
+ */
+enum class ScenarioSignal : uint8_t {
+    FEATURES = 0,       // Decision inputs given directly (confidence, class, peaks, magnitude)
+    NOISE = 1,          // MockHAL window through the pipeline (vibration patterns 0-2)
+    SINE = 2,
+    ANOMALY = 3
+};
+
+/**
+ * @brief One evaluated window of a scenario
+ */
+struct ScenarioStep {
+    size_t line;                    // Source line, for reports
+    uint32_t time_s;                // Node time since the scenario start
+    std::string phase;              // Optional label (the demo's phase banners)
+    bool battery_set;               // Otherwise the MockHAL battery carries on draining
+    uint16_t battery_mv;
+    ScenarioSignal signal;
+    uint32_t frequency_hz;          // MockHAL signal settings (pipeline steps)
+    int16_t amplitude;
+    int16_t noise;
+    float confidence;               // Decision inputs (FEATURES steps)
+    uint8_t predicted_class;
+    uint8_t num_peaks;
+    float peak_magnitude;
+    bool min_magnitude_set;         // Otherwise the run's spectral activity gate applies
+    float min_magnitude;
+    bool expect_set;
+    core::Decision expected;
+};
+
+/**
+ * @brief A named sequence of steps run on one MockHAL
+ */
+struct Scenario {
+    std::string name;
+    std::vector<ScenarioStep> steps;
+};
+
+/**
+ * @brief Parse scenarios from CSV text
+ *
+ * The first non-comment line is a header naming the columns, in any
+ * order; every following line is one step:
+ *
+ *   scenario,time,phase,battery_mv,signal,frequency_hz,amplitude,noise,
+ *   confidence,class,peaks,magnitude,min_magnitude,expect
+ *
+ * Only scenario, time and signal are required. time is seconds or
+ * HH:MM[:SS], at most 4294967 s (the uint32 ms virtual clock, about 49.7
+ * days), and must not decrease within a scenario. signal is features,
+ * noise, sine or anomaly; features steps need confidence, class, peaks
+ * and magnitude. An empty battery_mv keeps the simulated battery.
+ * min_magnitude overrides the config's min_peak_magnitude for that step
+ * only (MockHAL windows peak well below the 0.1 default). An empty
+ * expect checks nothing. Fields may be double-quoted; lines starting
+ * with '#' are ignored. Rows with the same scenario name form one
+ * scenario, in file order.
+ *
+ * @param source Name used in error messages
+ * @param error Receives "source:line: message" on failure
+ */
+bool parse_scenarios(
+    std::istream& in,
+    const std::string& source,
+    std::vector<Scenario>* scenarios,
+    std::string* error
+);
+
+/**
+ * @brief Parse a scenario file (see parse_scenarios())
+ */
+bool load_scenarios(const std::string& path, std::vector<Scenario>* scenarios, std::string* error);
+
+/**
+ * @brief What one step produced
+ */
+struct ScenarioStepOutcome {
+    uint32_t time_s;
+    uint16_t battery_mv;
+    core::SpectralResult spectral;
+    core::InferenceResult inference;
+    hal::fixed_t threshold;
+    core::Decision decision;
+    core::DecisionReason reason;
+    bool passed;                    // Matches the expectation (or none was set)
+};
+
+/**
+ * @brief Called after every step (the demo renders its table from it)
+ */
+using ScenarioStepCallback = std::function<void(const ScenarioStep&, const ScenarioStepOutcome&)>;
+
+/**
+ * @brief A step whose decision did not match
+ */
+struct ScenarioFailure {
+    size_t line;
+    uint32_t time_s;
+    core::Decision expected;
+    core::Decision actual;
+    core::DecisionReason reason;
+    hal::fixed_t confidence;
+    hal::fixed_t threshold;
+};
+
+/**
+ * @brief Outcome of one scenario
+ */
+struct ScenarioResult {
+    std::string name;
+    size_t steps;
+    size_t checked;                 // Steps with an expectation
+    std::vector<ScenarioFailure> failures;
+    uint32_t decisions[3];          // Indexed by core::Decision
+    uint32_t transmissions;
+    uint32_t end_time_s;            // Virtual clock at the end
+    double runtime_ms;              // Wall time
+
+    bool passed() const { return failures.empty(); }
+};
+
+/**
+ * @brief Run one scenario on a MockHAL with the virtual clock
+ *
+ * Acts like the node: before each step the HAL sleeps until the step
+ * time, the window is evaluated (features steps go straight to
+ * evaluate_structure(), signal steps read a MockHAL window through the
+ * WindowPipeline), the outcome goes into the event ring, and TX
+ * decisions transmit an alert with pending events piggybacked. The
+ * MockHAL is reseeded from the scenario name, so runs are reproducible.
+ *
+ * @param on_step Optional per-step callback
+ */
+ScenarioResult run_scenario(
+    const Scenario& scenario,
+    const core::ThresholdConfig& config,
+    hal::MockHAL& hal,
+    const ScenarioStepCallback& on_step
+);
+
+/**
+ * @brief Run scenarios in parallel, each on its own quiet MockHAL
+ * @param num_threads Worker count (0 = hardware concurrency)
+ * @return Results in scenario order
+ */
+std::vector<ScenarioResult> run_scenarios(
+    const std::vector<Scenario>& scenarios,
+    const core::ThresholdConfig& config,
+    unsigned num_threads
+);
+
+/**
+ * @brief One line per scenario (PASS/FAIL, steps, runtime), then the
+ *        failing steps and a summary
+ */
+void print_scenario_report(std::ostream& out, const std::vector<ScenarioResult>& results);
+
+/**
+ * @brief One CSV row per scenario
+ */
+void write_scenario_csv(std::ostream& out, const std::vector<ScenarioResult>& results);
+
+} // namespace host
+} // namespace spectral_gate
+
+#endif // SCENARIO_H
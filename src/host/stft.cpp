@@ -0,0 +1,266 @@
+#include "stft.h"
+#include "parallel.h"
+#include "spectral.h"
+#include <cstdio>
+#include <cstring>
+
+namespace spectral_gate {
+namespace host {
+
+using namespace hal;
+
+namespace {
+    constexpr char SPECTROGRAM_MAGIC[4] = {'S', 'G', 'S', 'P'};
+    constexpr uint16_t SPECTROGRAM_VERSION = 1;
+    constexpr size_t HEADER_SIZE = 32;
+
+    // Frames handed to a worker at a time
+    constexpr size_t FRAMES_PER_CHUNK = 64;
+
+    void put_u16(uint8_t* p, uint16_t v) {
+        p[0] = static_cast<uint8_t>(v & 0xFF);
+        p[1] = static_cast<uint8_t>(v >> 8);
+    }
+
+    void put_u32(uint8_t* p, uint32_t v) {
+        for (int i = 0; i < 4; ++i) p[i] = static_cast<uint8_t>((v >> (8 * i)) & 0xFF);
+    }
+
+    uint16_t get_u16(const uint8_t* p) {
+        return static_cast<uint16_t>(p[0] | (p[1] << 8));
+    }
+
+    uint32_t get_u32(const uint8_t* p) {
+        return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+               (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+}
+
+StftConfig get_default_stft_config() {
+    StftConfig config;
+    config.window_length = VIBRATION_BUFFER_SIZE;
+    config.hop = VIBRATION_BUFFER_SIZE;
+    config.num_bins = NUM_SPECTRAL_BINS;
+    config.sample_rate = 1000;
+    config.num_threads = 0;
+    return config;
+}
+
+bool compute_stft(
+    const int16_t* samples,
+    size_t num_samples,
+    const StftConfig& config,
+    Spectrogram* out
+) {
+    if (config.window_length == 0 || config.hop == 0 || config.num_bins == 0) {
+        return false;
+    }
+
+    out->config = config;
+    out->num_frames = (num_samples >= config.window_length)
+                      ? (num_samples - config.window_length) / config.hop + 1
+                      : 0;
+    out->magnitudes.assign(out->num_frames * config.num_bins, 0);
+
+    fixed_t* magnitudes = out->magnitudes.data();
+
+    // Chunks cover contiguous frame ranges; the overlap tail of each chunk
+    // is read straight from the shared recording
+    parallel_for(out->num_frames, config.num_threads, FRAMES_PER_CHUNK,
+        [&](size_t begin, size_t end, unsigned /*worker*/) {
+            core::SpectralProcessor processor(config.num_bins, config.sample_rate);
+            for (size_t f = begin; f < end; ++f) {
+                processor.compute_magnitude_spectrum(
+                    &samples[f * config.hop],
+                    config.window_length,
+                    &magnitudes[f * config.num_bins]
+                );
+            }
+        });
+
+    return true;
+}
+
+bool write_spectrogram(
+    const std::string& path,
+    const Spectrogram& spectrogram,
+    SpectrogramFormat format
+) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+
+    const StftConfig& c = spectrogram.config;
+    uint8_t header[HEADER_SIZE] = {};
+    std::memcpy(header, SPECTROGRAM_MAGIC, 4);
+    put_u16(&header[4], SPECTROGRAM_VERSION);
+    header[6] = static_cast<uint8_t>(format);
+    put_u32(&header[8], c.sample_rate);
+    put_u32(&header[12], static_cast<uint32_t>(c.window_length));
+    put_u32(&header[16], static_cast<uint32_t>(c.hop));
+    put_u32(&header[20], static_cast<uint32_t>(c.num_bins));
+    put_u32(&header[24], static_cast<uint32_t>(spectrogram.num_frames));
+
+    bool ok = std::fwrite(header, 1, HEADER_SIZE, file) == HEADER_SIZE;
+
+    // Encode through a large staging buffer to keep fwrite calls few
+    std::vector<uint8_t> staging(1 << 16);
+    size_t fill = 0;
+    for (size_t i = 0; i < spectrogram.magnitudes.size() && ok; ++i) {
+        fixed_t m = spectrogram.magnitudes[i];
+        uint16_t encoded;
+        if (format == SpectrogramFormat::FLOAT16) {
+            // Clamp to the largest finite half (65504)
+            encoded = float_to_half(static_cast<float>((m > 65504) ? 65504 : m));
+        } else {
+            encoded = static_cast<uint16_t>((m < 0) ? 0 : (m > 0xFFFF) ? 0xFFFF : m);
+        }
+        put_u16(&staging[fill], encoded);
+        fill += 2;
+        if (fill == staging.size()) {
+            ok = std::fwrite(staging.data(), 1, fill, file) == fill;
+            fill = 0;
+        }
+    }
+    if (ok && fill > 0) {
+        ok = std::fwrite(staging.data(), 1, fill, file) == fill;
+    }
+
+    return (std::fclose(file) == 0) && ok;
+}
+
+bool read_spectrogram(const std::string& path, Spectrogram* out) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+
+    uint8_t header[HEADER_SIZE];
+    if (std::fread(header, 1, HEADER_SIZE, file) != HEADER_SIZE ||
+        std::memcmp(header, SPECTROGRAM_MAGIC, 4) != 0 ||
+        get_u16(&header[4]) != SPECTROGRAM_VERSION) {
+        std::fclose(file);
+        return false;
+    }
+
+    // Header-driven sizes must match the payload actually present, so a
+    // corrupt header cannot trigger a huge allocation
+    uint8_t format_byte = header[6];
+    uint32_t num_bins = get_u32(&header[20]);
+    uint32_t num_frames = get_u32(&header[24]);
+    long payload = -1;
+    if (std::fseek(file, 0, SEEK_END) == 0) {
+        payload = std::ftell(file) - static_cast<long>(HEADER_SIZE);
+    }
+    bool valid = (format_byte == static_cast<uint8_t>(SpectrogramFormat::UINT16) ||
+                  format_byte == static_cast<uint8_t>(SpectrogramFormat::FLOAT16)) &&
+                 payload >= 0 &&
+                 std::fseek(file, static_cast<long>(HEADER_SIZE), SEEK_SET) == 0;
+    const uint64_t count = static_cast<uint64_t>(num_frames) * num_bins;
+    if (!valid || count * 2 != static_cast<uint64_t>(payload)) {
+        std::fclose(file);
+        return false;
+    }
+
+    SpectrogramFormat format = static_cast<SpectrogramFormat>(format_byte);
+    out->config.sample_rate = get_u32(&header[8]);
+    out->config.window_length = get_u32(&header[12]);
+    out->config.hop = get_u32(&header[16]);
+    out->config.num_bins = num_bins;
+    out->config.num_threads = 0;
+    out->num_frames = num_frames;
+
+    std::vector<uint8_t> raw(static_cast<size_t>(count) * 2);
+    bool ok = std::fread(raw.data(), 1, raw.size(), file) == raw.size();
+    std::fclose(file);
+    if (!ok) {
+        return false;
+    }
+
+    out->magnitudes.resize(static_cast<size_t>(count));
+    for (size_t i = 0; i < out->magnitudes.size(); ++i) {
+        uint16_t v = get_u16(&raw[i * 2]);
+        if (format == SpectrogramFormat::FLOAT16) {
+            // Writers clamp to [0, 65504]; keep Inf/NaN/negatives out of the cast
+            float f = half_to_float(v);
+            out->magnitudes[i] = (f >= 0.0f && f <= 65504.0f) ? static_cast<fixed_t>(f)
+                               : (f > 65504.0f) ? 65504 : 0;
+        } else {
+            out->magnitudes[i] = static_cast<fixed_t>(v);
+        }
+    }
+    return true;
+}
+
+uint16_t float_to_half(float value) {
+    uint32_t f;
+    std::memcpy(&f, &value, sizeof(f));
+
+    uint32_t sign = (f >> 16) & 0x8000;
+    uint32_t raw_exp = (f >> 23) & 0xFF;
+    uint32_t mant = f & 0x7FFFFF;
+    int32_t exp = static_cast<int32_t>(raw_exp) - 127 + 15;
+
+    if (raw_exp == 0xFF) {
+        return static_cast<uint16_t>(sign | 0x7C00 | (mant ? 0x200 : 0));  // Inf/NaN
+    }
+    if (exp >= 31) {
+        return static_cast<uint16_t>(sign | 0x7C00);  // Overflow to Inf
+    }
+    if (exp <= 0) {
+        // Subnormal half (or underflow to zero)
+        if (exp < -10) {
+            return static_cast<uint16_t>(sign);
+        }
+        mant |= 0x800000;
+        uint32_t shift = static_cast<uint32_t>(14 - exp);
+        uint32_t half_mant = mant >> shift;
+        uint32_t rem = mant & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (rem > halfway || (rem == halfway && (half_mant & 1))) {
+            ++half_mant;
+        }
+        return static_cast<uint16_t>(sign | half_mant);
+    }
+
+    uint32_t half = sign | (static_cast<uint32_t>(exp) << 10) | (mant >> 13);
+    uint32_t rem = mant & 0x1FFF;
+    if (rem > 0x1000 || (rem == 0x1000 && (half & 1))) {
+        ++half;  // Carry into the exponent is the correct rounding
+    }
+    return static_cast<uint16_t>(half);
+}
+
+float half_to_float(uint16_t value) {
+    uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+    uint32_t exp = (value >> 10) & 0x1F;
+    uint32_t mant = value & 0x3FF;
+    uint32_t f;
+
+    if (exp == 0) {
+        if (mant == 0) {
+            f = sign;
+        } else {
+            // Normalize subnormal
+            uint32_t e = 127 - 15 + 1;
+            while ((mant & 0x400) == 0) {
+                mant <<= 1;
+                --e;
+            }
+            mant &= 0x3FF;
+            f = sign | (e << 23) | (mant << 13);
+        }
+    } else if (exp == 31) {
+        f = sign | 0x7F800000 | (mant << 13);
+    } else {
+        f = sign | ((exp - 15 + 127) << 23) | (mant << 13);
+    }
+
+    float result;
+    std::memcpy(&result, &f, sizeof(result));
+    return result;
+}
+
+} // namespace host
+} // namespace spectral_gate
@@ -0,0 +1,102 @@
+#ifndef STFT_H
+#define STFT_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "hal/hal_interface.h"
+
+namespace spectral_gate {
+namespace host {
+
+/**
+ * @brief On-disk storage format for spectrogram magnitudes
+ */
+enum class SpectrogramFormat : uint8_t {
+    UINT16 = 0,     // Saturating unsigned 16-bit magnitude (int16 input counts)
+    FLOAT16 = 1     // IEEE 754 half precision
+};
+
+/**
+ * @brief STFT framing configuration
+ */
+struct StftConfig {
+    size_t window_length;       // Samples per frame (as on device)
+    size_t hop;                 // Samples between frame starts
+    size_t num_bins;            // Frequency bins per frame
+    uint32_t sample_rate;       // Sample rate in Hz
+    unsigned num_threads;       // Worker threads (0 = hardware concurrency)
+};
+
+/**
+ * @brief Spectrogram: num_frames x num_bins magnitudes, frame-major
+ */
+struct Spectrogram {
+    StftConfig config;
+    size_t num_frames;
+    std::vector<hal::fixed_t> magnitudes;
+
+    const hal::fixed_t* frame(size_t index) const {
+        return &magnitudes[index * config.num_bins];
+    }
+};
+
+/**
+ * @brief Default framing: device window, no overlap
+ */
+StftConfig get_default_stft_config();
+
+/**
+ * @brief Compute a spectrogram over a long recording
+ *
+ * Frames are split into chunks processed in parallel. Each chunk reads
+ * the window_length - hop samples of overlap past its last frame start
+ * directly from the shared recording, so chunk boundaries need no
+ * stitching. Every frame is exactly
+ * SpectralProcessor::compute_magnitude_spectrum() of that window.
+ *
+ * @param samples Recording samples
+ * @param num_samples Number of samples
+ * @param config Framing configuration
+ * @param out Receives the spectrogram
+ * @return false if the configuration is invalid
+ */
+bool compute_stft(
+    const int16_t* samples,
+    size_t num_samples,
+    const StftConfig& config,
+    Spectrogram* out
+);
+
+/**
+ * @brief Write spectrogram file (".sgsp": 32-byte header + magnitudes)
+ * @return true on success
+ */
+bool write_spectrogram(
+    const std::string& path,
+    const Spectrogram& spectrogram,
+    SpectrogramFormat format
+);
+
+/**
+ * @brief Read spectrogram file written by write_spectrogram()
+ * @return false if the file cannot be read, has an unknown format, or
+ *         its frame/bin counts do not match the payload size
+ */
+bool read_spectrogram(const std::string& path, Spectrogram* out);
+
+/**
+ * @brief Convert float to IEEE 754 half (round to nearest even)
+ */
+uint16_t float_to_half(float value);
+
+/**
+ * @brief Convert IEEE 754 half to float
+ */
+float half_to_float(uint16_t value);
+
+} // namespace host
+} // namespace spectral_gate
+
+#endif // STFT_H
@@ -0,0 +1,182 @@
+#include "threshold_tuner.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cstdio>
+#include "core/inference.h"
+#include "core/pipeline.h"
+#include "core/spectral.h"
+
+namespace spectral_gate {
+namespace host {
+
+using namespace hal;
+
+namespace {
+    // Windows handed to a worker at a time when collecting inputs
+    constexpr size_t WINDOWS_PER_CHUNK = 32;
+
+    // Candidates handed to a worker at a time when sweeping
+    constexpr size_t CANDIDATES_PER_CHUNK = 64;
+
+    bool transmits(core::Decision d) {
+        return d != core::Decision::SLEEP;
+    }
+}
+
+void collect_decision_inputs(
+    const Dataset& dataset,
+    FeatureCache* cache,
+    unsigned num_threads,
+    DecisionInputs* inputs
+) {
+    const size_t windows = dataset.windows.size();
+    inputs->spectral.resize(windows);
+    inputs->inference.resize(windows);
+    inputs->battery_mv.resize(windows);
+    inputs->labels.resize(windows);
+
+    parallel_for(windows, num_threads, WINDOWS_PER_CHUNK,
+        [&](size_t begin, size_t end, unsigned /*worker*/) {
+            core::SpectralProcessor processor(NUM_SPECTRAL_BINS, dataset.sample_rate);
+            core::InferenceEngine engine = core::create_default_engine();
+            fixed_t features[core::WindowPipeline::MAX_FEATURES];
+
+            // Same stages as WindowPipeline::process_window()
+            for (size_t w = begin; w < end; ++w) {
+                const DatasetWindow& window = dataset.windows[w];
+                size_t num_features = 0;
+                inputs->spectral[w] = process_with_features_cached(
+                    cache, processor, window.samples.data(), window.samples.size(),
+                    features, core::WindowPipeline::MAX_FEATURES, &num_features);
+                inputs->inference[w] = engine.run(features, num_features);
+                inputs->battery_mv[w] = window.battery_mv;
+                inputs->labels[w] = window.label;
+            }
+        });
+}
+
+TunerGrid get_default_tuner_grid() {
+    TunerGrid grid;
+    for (int t = 30; t <= 95; t += 5) {
+        grid.base_confidence_thresholds.push_back(static_cast<float>(t) / 100.0f);
+    }
+    grid.low_battery_multipliers = {1.0f, 1.1f, 1.2f, 1.3f, 1.5f};
+    grid.critical_battery_multipliers = {1.0f, 1.25f, 1.5f, 1.75f, 2.0f};
+    grid.min_peaks = {1, 2, 3, 4};
+    grid.min_peak_magnitudes = {0.005f, 0.01f, 0.02f, 0.05f, 0.1f};
+    return grid;
+}
+
+std::vector<core::ThresholdConfig> expand_tuner_grid(const TunerGrid& grid) {
+    std::vector<core::ThresholdConfig> candidates;
+    for (float base : grid.base_confidence_thresholds) {
+        for (float low : grid.low_battery_multipliers) {
+            for (float critical : grid.critical_battery_multipliers) {
+                for (uint8_t peaks : grid.min_peaks) {
+                    for (float gate : grid.min_peak_magnitudes) {
+                        core::ThresholdConfig config;
+                        config.base_confidence_threshold = float_to_fixed(base);
+                        config.low_battery_multiplier = float_to_fixed(low);
+                        config.critical_battery_multiplier = float_to_fixed(critical);
+                        config.min_peaks_for_detection = peaks;
+                        config.min_peak_magnitude = float_to_fixed(gate);
+                        candidates.push_back(config);
+                    }
+                }
+            }
+        }
+    }
+    return candidates;
+}
+
+std::vector<TunerResult> sweep_thresholds(
+    const DecisionInputs& inputs,
+    const std::vector<core::ThresholdConfig>& candidates,
+    double tx_uj,
+    unsigned num_threads
+) {
+    const size_t windows = inputs.spectral.size();
+    std::vector<TunerResult> results(candidates.size());
+
+    parallel_for(candidates.size(), num_threads, CANDIDATES_PER_CHUNK,
+        [&](size_t begin, size_t end, unsigned /*worker*/) {
+            std::vector<core::Decision> decisions(windows);
+            for (size_t c = begin; c < end; ++c) {
+                core::evaluate_structure_batch(
+                    inputs.spectral.data(), inputs.inference.data(), inputs.battery_mv.data(),
+                    windows, candidates[c], decisions.data());
+
+                TunerResult result = {candidates[c], 0, 0, 0, 0, 0.0};
+                for (size_t w = 0; w < windows; ++w) {
+                    core::Decision d = decisions[w];
+                    result.alerts += (d == core::Decision::TX_ALERT) ? 1 : 0;
+                    result.uncertain += (d == core::Decision::TX_UNCERTAIN) ? 1 : 0;
+                    if (inputs.labels[w] == WindowLabel::ANOMALY && !transmits(d)) {
+                        ++result.missed_alerts;
+                    } else if (inputs.labels[w] == WindowLabel::NORMAL && transmits(d)) {
+                        ++result.false_transmissions;
+                    }
+                }
+                if (windows > 0) {
+                    result.tx_energy_uj = static_cast<double>(result.alerts + result.uncertain) *
+                                          tx_uj / static_cast<double>(windows);
+                }
+                results[c] = result;
+            }
+        });
+    return results;
+}
+
+void rank_tuner_results(std::vector<TunerResult>* results) {
+    std::stable_sort(results->begin(), results->end(),
+        [](const TunerResult& a, const TunerResult& b) {
+            if (a.missed_alerts != b.missed_alerts) {
+                return a.missed_alerts < b.missed_alerts;
+            }
+            size_t tx_a = a.alerts + a.uncertain;
+            size_t tx_b = b.alerts + b.uncertain;
+            if (tx_a != tx_b) {
+                return tx_a < tx_b;
+            }
+            return a.false_transmissions < b.false_transmissions;
+        });
+}
+
+void print_tuner_results(std::ostream& out, const std::vector<TunerResult>& results,
+                         size_t windows, size_t limit) {
+    out << "  base    low   crit peaks    gate   alerts uncertain  missed  false_tx  tx_uJ/window\n";
+    size_t shown = (limit < results.size()) ? limit : results.size();
+    for (size_t i = 0; i < shown; ++i) {
+        const TunerResult& r = results[i];
+        char line[128];
+        std::snprintf(line, sizeof(line),
+                      "%6.2f %6.2f %6.2f %5u %7.3f %8zu %9zu %7zu %9zu %13.2f\n",
+                      fixed_to_float(r.config.base_confidence_threshold),
+                      fixed_to_float(r.config.low_battery_multiplier),
+                      fixed_to_float(r.config.critical_battery_multiplier),
+                      r.config.min_peaks_for_detection,
+                      fixed_to_float(r.config.min_peak_magnitude),
+                      r.alerts, r.uncertain, r.missed_alerts, r.false_transmissions,
+                      r.tx_energy_uj);
+        out << line;
+    }
+    out << "(" << shown << " of " << results.size() << " candidates, " << windows << " windows)\n";
+}
+
+void write_tuner_csv(std::ostream& out, const std::vector<TunerResult>& results) {
+    out << "base_confidence_threshold,low_battery_multiplier,critical_battery_multiplier,"
+        << "min_peaks_for_detection,min_peak_magnitude,alerts,uncertain,missed_alerts,"
+        << "false_transmissions,tx_energy_uj\n";
+    for (const TunerResult& r : results) {
+        out << fixed_to_float(r.config.base_confidence_threshold) << ","
+            << fixed_to_float(r.config.low_battery_multiplier) << ","
+            << fixed_to_float(r.config.critical_battery_multiplier) << ","
+            << static_cast<int>(r.config.min_peaks_for_detection) << ","
+            << fixed_to_float(r.config.min_peak_magnitude) << ","
+            << r.alerts << "," << r.uncertain << "," << r.missed_alerts << ","
+            << r.false_transmissions << "," << r.tx_energy_uj << "\n";
+    }
+}
+
+} // namespace host
+} // namespace spectral_gate
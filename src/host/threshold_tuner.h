@@ -0,0 +1,99 @@
+#ifndef THRESHOLD_TUNER_H
+#define THRESHOLD_TUNER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+#include "core/decision.h"
+#include "dataset.h"
+#include "feature_cache.h"
+
+namespace spectral_gate {
+namespace host {
+
+/**
+ * @brief Decision inputs for every window of a dataset
+ *
+ * Everything evaluate_structure() reads, so a threshold sweep never
+ * re-runs the spectral or inference stages.
+ */
+struct DecisionInputs {
+    std::vector<core::SpectralResult> spectral;
+    std::vector<core::InferenceResult> inference;
+    std::vector<uint16_t> battery_mv;
+    std::vector<WindowLabel> labels;
+};
+
+/**
+ * @brief Run the window pipeline (no pre-filter or similarity cache)
+ *        once per window and keep its decision inputs
+ * @param cache Optional feature cache; hits skip the spectral stage
+ * @param num_threads Worker count (0 = hardware concurrency)
+ */
+void collect_decision_inputs(
+    const Dataset& dataset,
+    FeatureCache* cache,
+    unsigned num_threads,
+    DecisionInputs* inputs
+);
+
+/**
+ * @brief Values swept per ThresholdConfig field; the tuner evaluates
+ *        their cross product
+ */
+struct TunerGrid {
+    std::vector<float> base_confidence_thresholds;
+    std::vector<float> low_battery_multipliers;
+    std::vector<float> critical_battery_multipliers;
+    std::vector<uint8_t> min_peaks;
+    std::vector<float> min_peak_magnitudes;
+};
+
+TunerGrid get_default_tuner_grid();
+
+std::vector<core::ThresholdConfig> expand_tuner_grid(const TunerGrid& grid);
+
+/**
+ * @brief Outcome of one candidate over the dataset
+ *
+ * Missed alerts are anomaly-labeled windows that SLEEP; false
+ * transmissions are normal-labeled windows that transmit.
+ */
+struct TunerResult {
+    core::ThresholdConfig config;
+    size_t alerts;                  // TX_ALERT
+    size_t uncertain;               // TX_UNCERTAIN
+    size_t missed_alerts;
+    size_t false_transmissions;
+    double tx_energy_uj;            // Per window, transmissions x tx_uj
+};
+
+/**
+ * @brief Score every candidate with evaluate_structure_batch()
+ * @param tx_uj Energy charged per transmission
+ * @param num_threads Worker count (0 = hardware concurrency)
+ * @return One result per candidate, in candidate order
+ */
+std::vector<TunerResult> sweep_thresholds(
+    const DecisionInputs& inputs,
+    const std::vector<core::ThresholdConfig>& candidates,
+    double tx_uj,
+    unsigned num_threads
+);
+
+/**
+ * @brief Order by missed alerts, then transmissions, then false
+ *        transmissions (fewest first)
+ */
+void rank_tuner_results(std::vector<TunerResult>* results);
+
+void print_tuner_results(std::ostream& out, const std::vector<TunerResult>& results,
+                         size_t windows, size_t limit);
+
+void write_tuner_csv(std::ostream& out, const std::vector<TunerResult>& results);
+
+} // namespace host
+} // namespace spectral_gate
+
+#endif // THRESHOLD_TUNER_H
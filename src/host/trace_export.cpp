@@ -0,0 +1,98 @@
+#include "trace_export.h"
+#include "core/trace.h"
+#include <cstdio>
+#include <fstream>
+
+namespace spectral_gate {
+namespace host {
+
+#if defined(SPECTRAL_GATE_TRACE)
+
+namespace {
+    // Trace names are static identifiers, but thread names may come
+    // from callers
+    std::string json_escape(const char* text) {
+        std::string out;
+        for (const char* p = text; *p != '\0'; ++p) {
+            if (*p == '"' || *p == '\\') {
+                out += '\\';
+                out += *p;
+            } else if (static_cast<unsigned char>(*p) < 0x20) {
+                out += ' ';
+            } else {
+                out += *p;
+            }
+        }
+        return out;
+    }
+
+    // Microseconds with nanosecond precision, as Chrome expects
+    std::string format_us(uint64_t ns) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%llu.%03llu",
+                      static_cast<unsigned long long>(ns / 1000),
+                      static_cast<unsigned long long>(ns % 1000));
+        return buffer;
+    }
+}
+
+bool write_chrome_trace(const std::string& path) {
+    std::vector<core::trace::ThreadTrace> threads = core::trace::snapshot();
+
+    uint64_t origin = UINT64_MAX;
+    uint64_t dropped = 0;
+    for (const auto& t : threads) {
+        dropped += t.dropped;
+        for (const auto& e : t.events) {
+            if (e.start_ns < origin) origin = e.start_ns;
+        }
+    }
+    if (origin == UINT64_MAX) {
+        origin = 0;
+    }
+
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+
+    out << "{\"displayTimeUnit\": \"ns\", \"otherData\": {\"dropped_events\": " << dropped
+        << "}, \"traceEvents\": [\n";
+    bool first = true;
+    auto separator = [&]() -> std::ofstream& {
+        out << (first ? "  " : ",\n  ");
+        first = false;
+        return out;
+    };
+
+    for (const auto& t : threads) {
+        if (t.name != nullptr) {
+            separator() << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << t.tid
+                        << ", \"args\": {\"name\": \"" << json_escape(t.name) << "\"}}";
+        }
+        for (const auto& e : t.events) {
+            separator() << "{\"name\": \"" << json_escape(e.name)
+                        << "\", \"cat\": \"" << core::trace_category_name(e.category)
+                        << "\", \"pid\": 1, \"tid\": " << t.tid
+                        << ", \"ts\": " << format_us(e.start_ns - origin);
+            if (e.instant) {
+                out << ", \"ph\": \"i\", \"s\": \"t\"}";
+            } else {
+                out << ", \"ph\": \"X\", \"dur\": " << format_us(e.duration_ns) << "}";
+            }
+        }
+    }
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
+
+#else
+
+bool write_chrome_trace(const std::string& /*path*/) {
+    return false;
+}
+
+#endif
+
+} // namespace host
+} // namespace spectral_gate
@@ -0,0 +1,24 @@
+#ifndef TRACE_EXPORT_H
+#define TRACE_EXPORT_H
+
+#include <string>
+
+namespace spectral_gate {
+namespace host {
+
+/**
+ * @brief Write all recorded trace rings as Chrome trace-event JSON
+ *
+ * The file opens in Perfetto (ui.perfetto.dev) or chrome://tracing. Each
+ * recording thread becomes one track; timestamps are relative to the
+ * earliest event. Call after workers have stopped recording.
+ *
+ * @param path Output .json path
+ * @return false if tracing is compiled out or the file cannot be written
+ */
+bool write_chrome_trace(const std::string& path);
+
+} // namespace host
+} // namespace spectral_gate
+
+#endif // TRACE_EXPORT_H
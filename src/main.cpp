@@ -1,3 +1,4 @@
+#include <cstdio>
 #include <iostream>
 #include <iomanip>
 #include <memory>
@@ -6,17 +7,34 @@
 #include "hal/hal_interface.h"
 #include "hal/hal_mock.h"
 #include "core/decision.h"
+#include "core/event_ring.h"
 #include "core/inference.h"
 #include "core/spectral.h"
 
+#if defined(SPECTRAL_GATE_HOST)
+#include <cstdlib>
+#include <fstream>
+#include <cstring>
+#include <vector>
+#include "host/decision_log.h"
+#include "host/metrics.h"
+#include "host/scenario.h"
+
+// Scenario played by the demo; the build copies it next to the binary
+#ifndef SPECTRAL_GATE_DEMO_SCENARIO
+#define SPECTRAL_GATE_DEMO_SCENARIO "energy_adaptive_demo.csv"
+#endif
+#endif
+
 using namespace spectral_gate;
 
 /**
  * @brief Spectral-Gate Energy-Adaptive Demo
  * 
  * This program demonstrates the "Energy-Adaptive" capabilities of the firmware.
- * It simulates a full day of operation showing how decision thresholds adapt
- * based on battery level:
+ * It plays a day of node operation from a scenario file
+ * (data/scenarios/energy_adaptive_demo.csv) on the mock HAL's virtual clock,
+ * showing how decision thresholds adapt based on battery level:
  *   - Phase 1 (Morning): High battery, low confidence → TX_UNCERTAIN (Active Learning)
  *   - Phase 2 (Evening): Low battery, low confidence → SLEEP (Energy Conservation)
  *   - Phase 3 (Damage):  Low battery, high confidence → TX_ALERT (Safety Critical)
@@ -67,162 +85,143 @@ void print_csv_footer() {
 }
 
 //=============================================================================
-// Demo Scenario Helpers
+// Metrics (host builds only)
 //=============================================================================
 
-struct DemoScenario {
-    const char* time;
-    const char* phase;
-    uint16_t battery_mv;
-    float confidence;           // 0.0 to 1.0
-    uint8_t predicted_class;    // 0=normal, 1=anomaly, 2=uncertain
-    uint8_t num_peaks;
-    float peak_magnitude;
-};
+#if defined(SPECTRAL_GATE_HOST)
+/**
+ * @brief Series exported by the demo (see README "Metrics")
+ */
+struct DemoMetrics {
+    host::Counter& windows;
+    host::Counter& sleep_decisions;
+    host::Counter& alert_decisions;
+    host::Counter& uncertain_decisions;
+    host::Gauge& skip_ratio;
+    host::Gauge& battery_mv;
+    host::Histogram& confidence;
 
-float calculate_effective_threshold(uint16_t battery_mv, const core::ThresholdConfig& config) {
-    float base = hal::fixed_to_float(config.base_confidence_threshold);
-    
-    if (battery_mv < hal::BATTERY_CRITICAL_MV) {
-        return base * hal::fixed_to_float(config.critical_battery_multiplier);
-    } else if (battery_mv < hal::BATTERY_LOW_MV) {
-        return base * hal::fixed_to_float(config.low_battery_multiplier);
+    explicit DemoMetrics(host::MetricsRegistry& registry)
+        : windows(registry.counter("spectral_gate_windows_total",
+                                   "Windows evaluated")),
+          sleep_decisions(registry.counter("spectral_gate_decisions_total",
+                                           "Decisions by outcome", "decision=\"SLEEP\"")),
+          alert_decisions(registry.counter("spectral_gate_decisions_total",
+                                           "Decisions by outcome", "decision=\"TX_ALERT\"")),
+          uncertain_decisions(registry.counter("spectral_gate_decisions_total",
+                                               "Decisions by outcome", "decision=\"TX_UNCERTAIN\"")),
+          skip_ratio(registry.gauge("spectral_gate_skip_ratio",
+                                    "Fraction of windows gated to sleep")),
+          battery_mv(registry.gauge("spectral_gate_battery_millivolts",
+                                    "Last battery reading")),
+          confidence(registry.histogram("spectral_gate_confidence",
+                                        "Model confidence per window",
+                                        {0.5, 0.6, 0.65, 0.75, 0.9, 0.975, 0.99}))
+    {
+        char label[32];
+        std::snprintf(label, sizeof(label), "checksum=\"%08x\"",
+                      core::create_default_engine().get_model_checksum());
+        registry.gauge("spectral_gate_model_info", "Loaded model (value is always 1)", label).set(1.0);
     }
-    return base;
-}
 
-const char* get_decision_reason(core::Decision decision, uint16_t battery_mv, 
-                                 uint8_t predicted_class, float confidence, float threshold) {
-    switch (decision) {
-        case core::Decision::TX_UNCERTAIN:
-            return "Active Learn";
-        case core::Decision::TX_ALERT:
-            return "Safety Crit";
-        case core::Decision::SLEEP:
-            if (predicted_class == 2 && battery_mv < hal::BATTERY_LOW_MV) {
-                return "Energy Veto";
-            } else if (predicted_class == 1 && confidence < threshold) {
-                return "Low Conf";
-            } else if (predicted_class == 0) {
-                return "Normal Op";
-            }
-            return "Conserve";
-        default:
-            return "Unknown";
+    void record(core::Decision decision, uint16_t battery, float probability) {
+        windows.inc();
+        switch (decision) {
+            case core::Decision::SLEEP:        sleep_decisions.inc(); break;
+            case core::Decision::TX_ALERT:     alert_decisions.inc(); break;
+            case core::Decision::TX_UNCERTAIN: uncertain_decisions.inc(); break;
+        }
+        skip_ratio.set(static_cast<double>(sleep_decisions.value()) /
+                       static_cast<double>(windows.value()));
+        battery_mv.set(battery);
+        confidence.observe(probability);
     }
+};
+
+/**
+ * @brief Binary decision log (--log); replaces the table output
+ */
+using DemoLog = host::DecisionLogWriter;
+
+/**
+ * @brief The demo scenario next to the binary, else the source-tree copy
+ *        relative to the working directory
+ */
+std::string default_scenario_path(const char* argv0) {
+    std::string binary = (argv0 != nullptr) ? argv0 : "";
+    size_t slash = binary.find_last_of("/\\");
+    std::string beside = (slash == std::string::npos ? std::string() : binary.substr(0, slash + 1)) +
+                         SPECTRAL_GATE_DEMO_SCENARIO;
+    if (std::ifstream(beside)) {
+        return beside;
+    }
+    return std::string("data/scenarios/") + SPECTRAL_GATE_DEMO_SCENARIO;
 }
+#endif
 
 //=============================================================================
 // Main Demo Function
 //=============================================================================
 
-void run_energy_adaptive_demo(hal::MockHAL& mock_hal) {
+#if defined(SPECTRAL_GATE_HOST)
+/**
+ * @brief Run the demo scenario and render it as a table
+ * @return false if a step did not make its expected decision
+ */
+bool run_energy_adaptive_demo(hal::MockHAL& mock_hal, const host::Scenario& scenario,
+                              DemoMetrics* metrics, DemoLog* log) {
+    const bool print_table = (log == nullptr);
     core::ThresholdConfig config = core::get_default_config();
     
-    // Define demo scenarios that demonstrate energy-adaptive behavior
-    // Key insight: Same "low confidence" data produces different decisions based on battery
-    DemoScenario scenarios[] = {
-        // Phase 1: Morning - High Battery (4100mV)
-        // Low confidence uncertain data → TX_UNCERTAIN (can afford active learning)
-        {"06:00", "PHASE 1: MORNING - High Energy, Abundant Resources", 4100, 0.55f, 2, 3, 0.5f},
-        {"07:00", nullptr, 4100, 0.58f, 2, 3, 0.5f},
-        {"08:00", nullptr, 4050, 0.52f, 2, 3, 0.5f},
-        {"09:00", nullptr, 4000, 0.60f, 2, 4, 0.5f},
-        
-        // Phase 2: Evening - Low Battery (2900mV < CRITICAL)
-        // Same low confidence data → SLEEP (must conserve energy)
-        {"17:00", "PHASE 2: EVENING - Low Energy, Conservation Mode", 2900, 0.55f, 2, 3, 0.5f},
-        {"18:00", nullptr, 2850, 0.58f, 2, 3, 0.5f},
-        {"19:00", nullptr, 2800, 0.52f, 2, 3, 0.5f},
-        {"20:00", nullptr, 2750, 0.60f, 2, 4, 0.5f},
-        
-        // Phase 3: Damage Detected - Still Low Battery
-        // High confidence anomaly → TX_ALERT (safety critical overrides energy conservation)
-        // Note: Critical threshold = 65% * 1.5 = 97.5%, so confidence must exceed this
-        {"21:00", "PHASE 3: DAMAGE DETECTED - Safety Critical Override", 2700, 0.98f, 1, 5, 0.9f},
-        {"21:30", nullptr, 2650, 0.99f, 1, 6, 0.95f},
-        {"22:00", nullptr, 2600, 0.985f, 1, 5, 0.85f},
-        {"22:30", nullptr, 2550, 0.995f, 1, 7, 0.98f},
-    };
-    
-    print_csv_header();
-    print_csv_table_header();
-    
-    const char* current_phase = nullptr;
-    uint32_t tx_uncertain_count = 0;
-    uint32_t tx_alert_count = 0;
-    uint32_t sleep_count = 0;
+    if (print_table) {
+        print_csv_header();
+        print_csv_table_header();
+    }
     
-    for (const auto& scenario : scenarios) {
-        // Print phase separator if entering new phase
-        if (scenario.phase != nullptr && scenario.phase != current_phase) {
-            if (current_phase != nullptr) {
-                // Add visual separator between phases
+    // The runner drives the node (virtual clock, event ring, transmissions);
+    // the demo only renders, logs and counts each step
+    std::string current_phase;
+    host::ScenarioResult result = host::run_scenario(scenario, config, mock_hal,
+        [&](const host::ScenarioStep& step, const host::ScenarioStepOutcome& outcome) {
+            const float probability = hal::fixed_to_float(outcome.inference.confidence);
+            
+            // Print phase separator if entering new phase
+            if (!step.phase.empty() && step.phase != current_phase) {
+                if (print_table) {
+                    print_csv_separator(step.phase.c_str());
+                }
+                current_phase = step.phase;
             }
-            print_csv_separator(scenario.phase);
-            current_phase = scenario.phase;
-        }
-        
-        // Configure mock HAL with scenario parameters
-        mock_hal.set_battery_voltage(scenario.battery_mv);
-        
-        // Create spectral result
-        core::SpectralResult spectral_result;
-        spectral_result.dominant_frequency = hal::float_to_fixed(150.0f);
-        spectral_result.peak_magnitude = hal::float_to_fixed(scenario.peak_magnitude);
-        spectral_result.spectral_centroid = hal::float_to_fixed(200.0f);
-        spectral_result.num_peaks = scenario.num_peaks;
-        
-        // Create inference result with controlled values
-        core::InferenceResult inference_result;
-        inference_result.confidence = hal::float_to_fixed(scenario.confidence);
-        inference_result.predicted_class = scenario.predicted_class;
-        
-        // Calculate effective threshold for display
-        float effective_threshold = calculate_effective_threshold(scenario.battery_mv, config);
-        
-        // Run decision logic
-        core::Decision decision = core::evaluate_structure(
-            spectral_result,
-            inference_result,
-            scenario.battery_mv,
-            config
-        );
-        
-        // Get decision reason
-        const char* reason = get_decision_reason(
-            decision, scenario.battery_mv, scenario.predicted_class,
-            scenario.confidence, effective_threshold
-        );
-        
-        // Print CSV row
-        print_csv_row(
-            scenario.time,
-            scenario.battery_mv,
-            scenario.confidence,
-            effective_threshold,
-            core::decision_to_string(decision),
-            reason
-        );
-        
-        // Track statistics
-        switch (decision) {
-            case core::Decision::TX_UNCERTAIN:
-                ++tx_uncertain_count;
-                mock_hal.transmit_alert(0, static_cast<uint8_t>(scenario.confidence * 100));
-                break;
-            case core::Decision::TX_ALERT:
-                ++tx_alert_count;
-                mock_hal.transmit_alert(1, static_cast<uint8_t>(scenario.confidence * 100));
-                break;
-            case core::Decision::SLEEP:
-                ++sleep_count;
-                mock_hal.enter_sleep(1000);
-                break;
-        }
+            
+            if (print_table) {
+                char time[16];
+                host::format_log_time(outcome.time_s, time, sizeof(time));
+                print_csv_row(
+                    time,
+                    outcome.battery_mv,
+                    probability,
+                    hal::fixed_to_float(outcome.threshold),
+                    core::decision_to_string(outcome.decision),
+                    core::decision_reason_to_string(outcome.reason)
+                );
+            }
+            if (log != nullptr) {
+                log->append(host::make_decision_record(
+                    outcome.time_s, 0, outcome.battery_mv,
+                    outcome.spectral, outcome.inference, outcome.decision, config));
+            }
+            if (metrics != nullptr) {
+                metrics->record(outcome.decision, outcome.battery_mv, probability);
+            }
+        });
+    
+    if (print_table) {
+        print_csv_footer();
     }
     
-    print_csv_footer();
+    const uint32_t sleep_count = result.decisions[static_cast<size_t>(core::Decision::SLEEP)];
+    const uint32_t tx_alert_count = result.decisions[static_cast<size_t>(core::Decision::TX_ALERT)];
+    const uint32_t tx_uncertain_count = result.decisions[static_cast<size_t>(core::Decision::TX_UNCERTAIN)];
     
     // Print summary
     std::cout << "\n";
@@ -244,24 +243,118 @@ void run_energy_adaptive_demo(hal::MockHAL& mock_hal) {
     std::cout << "  HAL Statistics:\n";
     std::cout << "  ───────────────\n";
     std::cout << "  • Total Transmissions: " << mock_hal.get_transmit_count() << "\n";
-    std::cout << "  • Total Sleep Time:    " << mock_hal.get_total_sleep_ms() << " ms\n";
+    std::cout << "  • Total Sleep Time:    " << mock_hal.get_total_sleep_ms() << " ms (virtual)\n";
     std::cout << "\n";
     std::cout << "════════════════════════════════════════════════════════════════════════════════\n";
+    
+    if (!result.passed()) {
+        std::cerr << "\n";
+        host::print_scenario_report(std::cerr, std::vector<host::ScenarioResult>(1, result));
+        return false;
+    }
+    return true;
 }
+#endif
 
 //=============================================================================
 // Entry Point
 //=============================================================================
 
 int main(int argc, char* argv[]) {
-    (void)argc;
-    (void)argv;
-    
     // Create Mock HAL (Dependency Injection)
     hal::MockHAL mock_hal(hal::BATTERY_NOMINAL_MV);
-    
-    // Run the energy-adaptive demo scenario
-    run_energy_adaptive_demo(mock_hal);
-    
+
+#if defined(SPECTRAL_GATE_HOST)
+    const char* metrics_path = nullptr;
+    const char* log_path = nullptr;
+    const char* events_path = nullptr;
+    std::string scenario_path = default_scenario_path(argv[0]);
+    uint32_t metrics_interval_ms = 1000;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--metrics") == 0 && i + 1 < argc) {
+            metrics_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--metrics-interval") == 0 && i + 1 < argc) {
+            metrics_interval_ms = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--log") == 0 && i + 1 < argc) {
+            log_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--events") == 0 && i + 1 < argc) {
+            events_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--scenario") == 0 && i + 1 < argc) {
+            scenario_path = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--metrics PATH] [--metrics-interval MS] [--log PATH] [--events PATH]"
+                      << " [--scenario PATH]\n";
+            return 1;
+        }
+    }
+
+    std::vector<host::Scenario> scenarios;
+    std::string error;
+    if (!host::load_scenarios(scenario_path, &scenarios, &error)) {
+        std::cerr << error << "\n";
+        return 1;
+    }
+    if (scenarios.size() != 1) {
+        std::cerr << scenario_path << ": the demo plays exactly one scenario, found "
+                  << scenarios.size() << "\n";
+        return 1;
+    }
+    bool passed = true;
+
+    DemoLog log;
+    if (log_path != nullptr && !log.open(log_path)) {
+        std::cerr << "Failed to open decision log " << log_path << "\n";
+        return 1;
+    }
+    DemoLog* demo_log = (log_path != nullptr) ? &log : nullptr;
+
+    if (metrics_path != nullptr) {
+        host::MetricsRegistry registry;
+        DemoMetrics metrics(registry);
+        host::MetricsFileWriter writer(registry, metrics_path, metrics_interval_ms);
+        writer.start();
+        passed = run_energy_adaptive_demo(mock_hal, scenarios[0], &metrics, demo_log);
+        if (!writer.stop()) {
+            std::cerr << "Failed to write metrics to " << metrics_path << "\n";
+            return 1;
+        }
+    } else {
+        passed = run_energy_adaptive_demo(mock_hal, scenarios[0], nullptr, demo_log);
+    }
+
+    if (demo_log != nullptr && !log.close()) {
+        std::cerr << "Failed to write decision log " << log_path << "\n";
+        return 1;
+    }
+
+    if (events_path != nullptr) {
+        // Event capture: the batches received over the radio followed by
+        // the flash event log; both use the same batch encoding
+        std::ofstream events(events_path, std::ios::binary);
+        for (const std::vector<uint8_t>& frame : mock_hal.get_transmitted_frames()) {
+            if (frame.size() > core::ALERT_HEADER_BYTES) {
+                events.write(reinterpret_cast<const char*>(frame.data() + core::ALERT_HEADER_BYTES),
+                             static_cast<std::streamsize>(frame.size() - core::ALERT_HEADER_BYTES));
+            }
+        }
+        const std::vector<uint8_t>& flash_log = mock_hal.get_flash_log();
+        events.write(reinterpret_cast<const char*>(flash_log.data()),
+                     static_cast<std::streamsize>(flash_log.size()));
+        if (!events) {
+            std::cerr << "Failed to write events to " << events_path << "\n";
+            return 1;
+        }
+    }
+    return passed ? 0 : 1;
+#else
+    (void)argc;
+    (void)argv;
+    (void)mock_hal;
+
+    // Scenarios are files parsed and run by the host library
+    std::cout << "The energy-adaptive demo plays data/scenarios/energy_adaptive_demo.csv"
+              << " and needs a host build.\n";
     return 0;
+#endif
 }
@@ -0,0 +1,363 @@
+/**
+ * @file alloc_test_main.cpp
+ * @brief Zero-heap and stack-budget checks for the per-window path
+ *
+ * Built as its own executable because it replaces the global allocation
+ * functions for the whole program. Every operator new / malloc call is
+ * counted while a check is armed; the steady-state window path must not
+ * make any. Stack usage is measured by painting a thread's stack with a
+ * known pattern before running the path and scanning for the deepest
+ * overwritten byte afterwards.
+ */
+
+#include <iostream>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <pthread.h>
+
+#include "hal/hal_interface.h"
+#include "hal/hal_mock.h"
+#include "core/decision.h"
+#include "core/event_ring.h"
+#include "core/inference.h"
+#include "core/pipeline.h"
+#include "core/prefilter.h"
+#include "core/similarity.h"
+#include "core/spectral.h"
+
+using namespace spectral_gate;
+
+// Simple test framework macros. Checks are not assert(): they must hold in
+// release (NDEBUG) builds too, and a failure makes main() return non-zero.
+static unsigned g_failed_checks = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    std::cout << "Running " #name "... "; \
+    unsigned failed_before = g_failed_checks; \
+    test_##name(); \
+    std::cout << (g_failed_checks == failed_before ? "PASSED\n" : "FAILED\n"); \
+} while(0)
+
+#define CHECK(cond, text) do { \
+    if (!(cond)) { \
+        std::cerr << "\n" << __FILE__ << ":" << __LINE__ << ": check failed: " << text << "\n"; \
+        ++g_failed_checks; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) CHECK((a) == (b), #a " == " #b " (" << (a) << " vs " << (b) << ")")
+#define ASSERT_TRUE(x) CHECK(x, #x)
+#define ASSERT_FALSE(x) CHECK(!(x), "!(" #x ")")
+
+//=============================================================================
+// Allocation counting
+//=============================================================================
+
+namespace {
+    std::atomic<bool> g_armed{false};
+    std::atomic<uint64_t> g_new_calls{0};
+    std::atomic<uint64_t> g_malloc_calls{0};
+
+    void count(std::atomic<uint64_t>& counter) {
+        if (g_armed.load(std::memory_order_relaxed)) {
+            counter.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void* counted_new(size_t size) {
+        count(g_new_calls);
+        void* p = std::malloc(size != 0 ? size : 1);
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+
+    void* counted_new_aligned(size_t size, std::align_val_t align) {
+        count(g_new_calls);
+        size_t alignment = static_cast<size_t>(align);
+        size_t rounded = ((size != 0 ? size : 1) + alignment - 1) / alignment * alignment;
+        void* p = std::aligned_alloc(alignment, rounded);
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+
+    /**
+     * @brief Counts allocations made between construction and stop()
+     */
+    class AllocationGuard {
+    public:
+        AllocationGuard() {
+            g_new_calls.store(0, std::memory_order_relaxed);
+            g_malloc_calls.store(0, std::memory_order_relaxed);
+            g_armed.store(true, std::memory_order_seq_cst);
+        }
+        ~AllocationGuard() { stop(); }
+
+        void stop() { g_armed.store(false, std::memory_order_seq_cst); }
+
+        uint64_t new_calls() const { return g_new_calls.load(std::memory_order_relaxed); }
+        uint64_t malloc_calls() const { return g_malloc_calls.load(std::memory_order_relaxed); }
+    };
+}
+
+void* operator new(size_t size) { return counted_new(size); }
+void* operator new[](size_t size) { return counted_new(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    try { return counted_new(size); } catch (...) { return nullptr; }
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    try { return counted_new(size); } catch (...) { return nullptr; }
+}
+void* operator new(size_t size, std::align_val_t align) { return counted_new_aligned(size, align); }
+void* operator new[](size_t size, std::align_val_t align) { return counted_new_aligned(size, align); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+
+#if defined(__GLIBC__)
+// glibc exports its allocator under __libc_* names, so the C entry points
+// can be replaced too (catches allocations from C code and libstdc++ internals)
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* p, size_t size);
+
+void* malloc(size_t size) {
+    count(g_malloc_calls);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count_, size_t size) {
+    count(g_malloc_calls);
+    return __libc_calloc(count_, size);
+}
+
+void* realloc(void* p, size_t size) {
+    count(g_malloc_calls);
+    return __libc_realloc(p, size);
+}
+}
+#define SG_ALLOC_COUNTS_MALLOC 1
+#endif
+
+//=============================================================================
+// Stack painting
+//=============================================================================
+
+namespace {
+    constexpr size_t PAINTED_STACK_SIZE = 256 * 1024;
+    constexpr uint8_t STACK_PAINT = 0xA5;
+
+    struct StackProbe {
+        void (*body)(void*);
+        void* arg;
+        uintptr_t entry_sp;     // Address of a local in the thread entry frame
+    };
+
+    void* painted_entry(void* raw) {
+        StackProbe* probe = static_cast<StackProbe*>(raw);
+        volatile uint8_t marker = 0;
+        probe->entry_sp = reinterpret_cast<uintptr_t>(&marker);
+        probe->body(probe->arg);
+        return nullptr;
+    }
+
+    /**
+     * @brief Run body on a thread whose stack was painted beforehand
+     * @return Bytes of stack used below the thread entry frame
+     *
+     * Measured from the entry frame rather than the top of the mapping,
+     * since glibc keeps the thread descriptor and static TLS at the top of
+     * a user-supplied stack. Assumes a downward-growing stack.
+     */
+    size_t measure_stack(void (*body)(void*), void* arg) {
+        void* stack = nullptr;
+        if (posix_memalign(&stack, 4096, PAINTED_STACK_SIZE) != 0) {
+            return 0;
+        }
+        std::memset(stack, STACK_PAINT, PAINTED_STACK_SIZE);
+
+        StackProbe probe = {body, arg, 0};
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        pthread_attr_setstack(&attr, stack, PAINTED_STACK_SIZE);
+        pthread_t thread;
+        bool started = pthread_create(&thread, &attr, painted_entry, &probe) == 0;
+        pthread_attr_destroy(&attr);
+        if (!started) {
+            std::free(stack);
+            return 0;
+        }
+        pthread_join(thread, nullptr);
+
+        const uint8_t* bytes = static_cast<const uint8_t*>(stack);
+        size_t deepest = 0;
+        while (deepest < PAINTED_STACK_SIZE && bytes[deepest] == STACK_PAINT) {
+            ++deepest;
+        }
+        uintptr_t low = reinterpret_cast<uintptr_t>(stack) + deepest;
+        std::free(stack);
+        return (probe.entry_sp > low) ? static_cast<size_t>(probe.entry_sp - low) : 0;
+    }
+}
+
+//=============================================================================
+// Per-window path fixture
+//=============================================================================
+
+namespace {
+    constexpr size_t WINDOW = 256;
+    constexpr size_t NUM_WINDOWS = 16;
+    constexpr size_t WARMUP_WINDOWS = 4;
+
+    // Stack budget for one window on the host build. Host builds may be
+    // unoptimised and carry latency/trace probes, so this bounds growth
+    // rather than predicting the device figure.
+    constexpr size_t STACK_BUDGET_BYTES = 16 * 1024;
+
+    struct WindowPathRun {
+        int16_t windows[NUM_WINDOWS][WINDOW];
+        int16_t frames[NUM_WINDOWS][WINDOW * hal::NUM_AXES];
+        bool with_prefilter;
+        bool with_cache;
+        uint64_t new_calls;
+        uint64_t malloc_calls;
+        uint32_t decisions[3];
+    };
+
+    void fill_inputs(WindowPathRun* run) {
+        hal::MockHAL mock(hal::BATTERY_NOMINAL_MV);
+        for (size_t w = 0; w < NUM_WINDOWS; ++w) {
+            mock.set_signal_frequency(static_cast<uint32_t>(40 + 10 * (w % 4)));
+            mock.read_vibration_data(run->windows[w], WINDOW);
+            mock.read_vibration_frames(run->frames[w], WINDOW);
+        }
+    }
+
+    void window_path_body(void* arg) {
+        WindowPathRun* run = static_cast<WindowPathRun*>(arg);
+
+        core::SpectralProcessor proc(64, 1000);
+        core::InferenceEngine engine = core::create_default_engine();
+        core::WindowPipeline pipeline(proc, engine, core::get_default_config());
+        core::PreFilter prefilter = core::create_default_prefilter(1000, 50);
+        core::SimilarityCache cache(2);
+        if (run->with_prefilter) pipeline.set_prefilter(&prefilter);
+        if (run->with_cache) pipeline.set_similarity_cache(&cache);
+        alignas(4) static uint8_t ring_area[hal::EVENT_RING_AREA_BYTES];
+        core::EventRing events(ring_area, sizeof(ring_area));
+        events.reset();
+
+        // Warm-up: lets one-time per-thread state (latency shards) settle
+        for (size_t w = 0; w < WARMUP_WINDOWS; ++w) {
+            pipeline.process_window(run->windows[w], WINDOW, hal::BATTERY_NOMINAL_MV);
+        }
+
+        AllocationGuard guard;
+        for (size_t w = WARMUP_WINDOWS; w < NUM_WINDOWS; ++w) {
+            uint16_t battery = (w % 2 == 0) ? hal::BATTERY_NOMINAL_MV : 2900;
+            core::WindowOutcome outcome = pipeline.process_window(run->windows[w], WINDOW, battery);
+            ++run->decisions[static_cast<size_t>(outcome.decision)];
+
+            // Event record into the ring, batch encoded for the next frame
+            events.push(core::make_event_record(
+                static_cast<uint32_t>(w), battery, outcome.inference, outcome.decision,
+                core::DecisionReason::NORMAL_OPERATION));
+            uint8_t frame_batch[hal::MAX_FRAME_BYTES];
+            size_t num_events = 0;
+            events.encode_batch(frame_batch, sizeof(frame_batch), &num_events);
+            events.commit(num_events);
+
+            // Multi-axis path and batched inference
+            core::MultiAxisResult multi = proc.process_frames(run->frames[w], WINDOW);
+            (void)multi;
+            hal::fixed_t features[2 * core::WindowPipeline::MAX_FEATURES];
+            size_t n = proc.extract_features(run->windows[w], WINDOW, features,
+                                             core::WindowPipeline::MAX_FEATURES);
+            std::memcpy(features + n, features, n * sizeof(hal::fixed_t));
+            core::InferenceResult batch[2];
+            engine.run_batch(features, n, 2, batch);
+        }
+        guard.stop();
+        run->new_calls = guard.new_calls();
+        run->malloc_calls = guard.malloc_calls();
+    }
+}
+
+//=============================================================================
+// Tests
+//=============================================================================
+
+TEST(counting_hooks_see_allocations) {
+    AllocationGuard guard;
+    int* p = new int(7);
+    delete p;
+    guard.stop();
+    ASSERT_TRUE(guard.new_calls() >= 1u);
+#if defined(SG_ALLOC_COUNTS_MALLOC)
+    ASSERT_TRUE(guard.malloc_calls() >= 1u);
+#endif
+}
+
+TEST(stack_painting_sees_deep_frames) {
+    size_t used = measure_stack([](void*) {
+        volatile uint8_t buffer[32 * 1024];
+        for (size_t i = 0; i < sizeof(buffer); i += 64) buffer[i] = 1;
+    }, nullptr);
+    ASSERT_TRUE(used >= 32u * 1024u);
+}
+
+TEST(window_path_is_allocation_free) {
+    static WindowPathRun run;
+    for (int variant = 0; variant < 2; ++variant) {
+        std::memset(&run, 0, sizeof(run));
+        fill_inputs(&run);
+        run.with_prefilter = (variant == 1);
+        run.with_cache = (variant == 1);
+
+        size_t stack_bytes = measure_stack(window_path_body, &run);
+
+        std::cout << "\n  " << (variant == 0 ? "bare" : "prefilter+cache")
+                  << ": " << (NUM_WINDOWS - WARMUP_WINDOWS) << " windows, "
+                  << run.new_calls << " operator new, " << run.malloc_calls << " malloc, "
+                  << "peak stack " << stack_bytes << " B (budget "
+                  << STACK_BUDGET_BYTES << " B) ";
+
+        ASSERT_EQ(run.decisions[0] + run.decisions[1] + run.decisions[2],
+                  static_cast<uint32_t>(NUM_WINDOWS - WARMUP_WINDOWS));
+        ASSERT_EQ(run.new_calls, 0u);
+        ASSERT_EQ(run.malloc_calls, 0u);
+        ASSERT_TRUE(stack_bytes > 0);
+        CHECK(stack_bytes <= STACK_BUDGET_BYTES,
+              "peak stack " << stack_bytes << " B over the " << STACK_BUDGET_BYTES << " B budget");
+    }
+}
+
+int main() {
+    std::cout << "\n=== Spectral-Gate Allocation Tests ===\n\n";
+
+    RUN_TEST(counting_hooks_see_allocations);
+    RUN_TEST(stack_painting_sees_deep_frames);
+    RUN_TEST(window_path_is_allocation_free);
+
+    if (g_failed_checks != 0) {
+        std::cout << "\n=== " << g_failed_checks << " checks failed ===\n\n";
+        return 1;
+    }
+    std::cout << "\n=== All tests passed! ===\n\n";
+    return 0;
+}
@@ -1,12 +1,39 @@
 #include <iostream>
-#include <cassert>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "hal/hal_interface.h"
 #include "hal/hal_mock.h"
 #include "core/decision.h"
+#include "core/event_ring.h"
 #include "core/inference.h"
 #include "core/spectral.h"
+#include "core/prefilter.h"
+#include "core/latency_probe.h"
+#include "core/pipeline.h"
+#include "core/trace.h"
+#include "core/similarity.h"
+#include "host/dataset.h"
+#include "host/decision_log.h"
+#include "host/error_budget.h"
+#include "host/event_decoder.h"
+#include "host/feature_cache.h"
+#include "host/golden.h"
+#include "host/incremental.h"
+#include "host/log_query.h"
+#include "host/metrics.h"
+#include "host/replay.h"
+#include "host/scenario.h"
+#include "host/stft.h"
+#include "host/threshold_tuner.h"
+#include "host/trace_export.h"
+#include "model_weights.h"
 
 using namespace spectral_gate;
 
@@ -18,9 +45,17 @@ using namespace spectral_gate;
     std::cout << "PASSED\n"; \
 } while(0)
 
-#define ASSERT_EQ(a, b) assert((a) == (b))
-#define ASSERT_TRUE(x) assert(x)
-#define ASSERT_FALSE(x) assert(!(x))
+// Checks stay on in release (NDEBUG) builds, unlike assert()
+#define CHECK(cond, text) do { \
+    if (!(cond)) { \
+        std::cerr << "\n" << __FILE__ << ":" << __LINE__ << ": check failed: " << text << "\n"; \
+        std::abort(); \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) CHECK((a) == (b), #a " == " #b)
+#define ASSERT_TRUE(x) CHECK(x, #x)
+#define ASSERT_FALSE(x) CHECK(!(x), "!(" #x ")")
 
 // Test fixed-point math
 TEST(fixed_point_conversion) {
@@ -106,6 +141,54 @@ TEST(decision_battery_threshold_scaling) {
     ASSERT_TRUE(result2 != core::Decision::TX_ALERT);
 }
 
+TEST(decision_activity_gate_is_configurable) {
+    core::SpectralResult spectral{};
+    spectral.num_peaks = 3;
+    spectral.peak_magnitude = hal::float_to_fixed(0.05f);
+    
+    core::InferenceResult inference{};
+    inference.confidence = hal::float_to_fixed(0.85f);
+    inference.predicted_class = 1;
+    
+    // Below the default gate
+    core::ThresholdConfig config = core::get_default_config();
+    ASSERT_EQ(core::evaluate_structure(spectral, inference, hal::BATTERY_NOMINAL_MV, config),
+              core::Decision::SLEEP);
+    
+    config.min_peak_magnitude = hal::float_to_fixed(0.02f);
+    ASSERT_EQ(core::evaluate_structure(spectral, inference, hal::BATTERY_NOMINAL_MV, config),
+              core::Decision::TX_ALERT);
+}
+
+TEST(decision_batch_matches_scalar) {
+    // Sweep inputs across every branch: peaks, gate, class, battery regime
+    const size_t n = 360;
+    std::vector<core::SpectralResult> spectral(n);
+    std::vector<core::InferenceResult> inference(n);
+    std::vector<uint16_t> battery(n);
+    const uint16_t levels[] = {4100, 3300, 3299, 3000, 2999};
+    for (size_t i = 0; i < n; ++i) {
+        spectral[i] = core::SpectralResult{};
+        spectral[i].num_peaks = static_cast<uint8_t>(i % 5);
+        spectral[i].peak_magnitude = hal::float_to_fixed(0.04f * static_cast<float>((i / 5) % 4));
+        inference[i].predicted_class = static_cast<uint8_t>((i / 20) % 3);
+        inference[i].confidence = hal::float_to_fixed(0.05f * static_cast<float>(i % 21));
+        battery[i] = levels[(i / 60) % 5];
+    }
+    
+    core::ThresholdConfig configs[2] = {core::get_default_config(), core::get_default_config()};
+    configs[1].min_peak_magnitude = hal::float_to_fixed(0.05f);
+    configs[1].critical_battery_multiplier = hal::float_to_fixed(1.1f);
+    std::vector<core::Decision> decisions(n);
+    for (const auto& config : configs) {
+        core::evaluate_structure_batch(spectral.data(), inference.data(), battery.data(),
+                                       n, config, decisions.data());
+        for (size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(decisions[i], core::evaluate_structure(spectral[i], inference[i], battery[i], config));
+        }
+    }
+}
+
 // Test mock HAL
 TEST(mock_hal_vibration_data) {
     hal::MockHAL mock;
@@ -136,6 +219,1198 @@ TEST(spectral_processor_basic) {
     ASSERT_TRUE(result.peak_magnitude > 0);
 }
 
+TEST(mock_hal_vibration_frames) {
+    hal::MockHAL mock;
+    int16_t frames[64 * hal::NUM_AXES];
+    
+    size_t read = mock.read_vibration_frames(frames, 64);
+    ASSERT_EQ(read, 64u);
+}
+
+TEST(spectral_frames_match_single_axis) {
+    core::SpectralProcessor proc(64, 1000);
+    
+    constexpr size_t N = 256;
+    int16_t frames[N * hal::NUM_AXES];
+    int16_t channels[hal::NUM_AXES][N];
+    for (size_t i = 0; i < N; ++i) {
+        channels[0][i] = static_cast<int16_t>(1000 * std::sin(2.0 * 3.14159 * 50 * i / 1000));
+        channels[1][i] = static_cast<int16_t>(700 * std::sin(2.0 * 3.14159 * 120 * i / 1000));
+        channels[2][i] = static_cast<int16_t>(4096 + 300 * std::sin(2.0 * 3.14159 * 50 * i / 1000));
+        for (size_t a = 0; a < hal::NUM_AXES; ++a) {
+            frames[i * hal::NUM_AXES + a] = channels[a][i];
+        }
+    }
+    
+    core::MultiAxisResult multi = proc.process_frames(frames, N);
+    for (size_t a = 0; a < hal::NUM_AXES; ++a) {
+        core::SpectralResult single = proc.process(channels[a], N);
+        ASSERT_EQ(multi.axes[a].peak_magnitude, single.peak_magnitude);
+        ASSERT_EQ(multi.axes[a].dominant_frequency, single.dominant_frequency);
+        ASSERT_EQ(multi.axes[a].spectral_centroid, single.spectral_centroid);
+        ASSERT_EQ(multi.axes[a].num_peaks, single.num_peaks);
+    }
+    ASSERT_TRUE(multi.vector_magnitude.peak_magnitude >= multi.axes[0].peak_magnitude);
+    
+    hal::fixed_t features[(hal::NUM_AXES + 1) * 64];
+    size_t count = proc.extract_frame_features(frames, N, features, sizeof(features) / sizeof(features[0]));
+    ASSERT_EQ(count, (hal::NUM_AXES + 1) * 64);
+    
+    hal::fixed_t x_features[64];
+    proc.extract_features(channels[0], N, x_features, 64);
+    for (size_t i = 0; i < 64; ++i) {
+        ASSERT_EQ(features[i], x_features[i]);
+    }
+}
+
+TEST(spectral_wide_sample_types) {
+    core::SpectralProcessor proc(64, 1000);
+    
+    constexpr size_t N = 256;
+    int16_t narrow[N];
+    hal::int24_t packed[N];
+    int32_t wide[N];
+    float normalized[N];
+    for (size_t i = 0; i < N; ++i) {
+        narrow[i] = static_cast<int16_t>(1000 * std::sin(2.0 * 3.14159 * 50 * i / 1000));
+        packed[i] = hal::int24_t::from_int32(narrow[i] * 256);
+        wide[i] = narrow[i] * 256;
+        normalized[i] = narrow[i] / 32768.0f;
+    }
+    ASSERT_EQ(packed[3].to_int32(), narrow[3] * 256);
+    
+    core::SpectralResult r16 = proc.process(narrow, N);
+    core::SpectralResult r24 = proc.process(packed, N);
+    core::SpectralResult r32 = proc.process(wide, N);
+    core::SpectralResult rf = proc.process(normalized, N);
+    
+    // Wider types report 24-bit counts: same spectrum shape, 256x magnitude
+    ASSERT_EQ(r24.dominant_frequency, r16.dominant_frequency);
+    ASSERT_EQ(r32.dominant_frequency, r16.dominant_frequency);
+    ASSERT_EQ(rf.dominant_frequency, r16.dominant_frequency);
+    ASSERT_EQ(r24.peak_magnitude, r32.peak_magnitude);
+    ASSERT_TRUE(std::abs(r24.peak_magnitude - r16.peak_magnitude * 256) <= 256);
+    ASSERT_TRUE(std::abs(rf.peak_magnitude - r24.peak_magnitude) <= 256);
+    
+    // Out-of-range and NaN float samples clamp instead of overflowing
+    ASSERT_EQ(hal::SampleTraits<float>::to_acc(2.0f), 8388607);
+    ASSERT_EQ(hal::SampleTraits<float>::to_acc(-2.0f), -8388607);
+    ASSERT_EQ(hal::SampleTraits<float>::to_acc(std::nanf("")), 0);
+    ASSERT_EQ(hal::SampleTraits<int32_t>::to_acc(-8388608), -8388607);
+    ASSERT_EQ(hal::SampleTraits<int32_t>::to_acc(1 << 30), 8388607);
+}
+
+TEST(acquisition_buffer_types) {
+    hal::MockHAL mock;
+    hal::AcquisitionBuffer<int16_t, 64> narrow;
+    hal::AcquisitionBuffer<hal::int24_t, 64> packed;
+    hal::AcquisitionBuffer<float, 64> normalized;
+    
+    ASSERT_EQ(hal::acquire(mock, narrow), 64u);
+    ASSERT_EQ(hal::acquire(mock, packed), 64u);
+    ASSERT_EQ(hal::acquire(mock, normalized), 64u);
+    for (size_t i = 0; i < normalized.count; ++i) {
+        ASSERT_TRUE(normalized.samples[i] >= -1.0f && normalized.samples[i] < 1.0f);
+    }
+    
+    // int32 and int24 acquisitions of the same stream carry the same
+    // 24-bit samples, sub-LSB noise included, into process()
+    hal::AcquisitionBuffer<int32_t, 256> wide;
+    hal::AcquisitionBuffer<hal::int24_t, 256> packed_window;
+    mock.set_vibration_pattern(1);
+    mock.set_seed(7);
+    ASSERT_EQ(hal::acquire(mock, wide), 256u);
+    mock.set_seed(7);
+    ASSERT_EQ(hal::acquire(mock, packed_window), 256u);
+    bool sub_lsb = false;
+    for (size_t i = 0; i < wide.count; ++i) {
+        ASSERT_EQ(hal::SampleTraits<int32_t>::to_acc(wide.samples[i]), packed_window.samples[i].to_int32());
+        sub_lsb = sub_lsb || (wide.samples[i] & 0xFF) != 0;
+    }
+    ASSERT_TRUE(sub_lsb);
+    
+    core::SpectralProcessor proc(64, 1000);
+    core::SpectralResult r32 = proc.process(wide.samples, wide.count);
+    core::SpectralResult r24 = proc.process(packed_window.samples, packed_window.count);
+    ASSERT_EQ(r32.peak_magnitude, r24.peak_magnitude);
+    ASSERT_EQ(r32.dominant_frequency, r24.dominant_frequency);
+    ASSERT_EQ(r32.spectral_centroid, r24.spectral_centroid);
+}
+
+// Test pre-filter
+TEST(prefilter_removes_dc_and_keeps_state) {
+    core::PreFilter streamed = core::create_default_prefilter(1000, 50);
+    core::PreFilter whole = core::create_default_prefilter(1000, 50);
+    ASSERT_EQ(streamed.get_num_sections(), 3u);
+    
+    constexpr size_t N = 2048;
+    int16_t input[N];
+    for (size_t i = 0; i < N; ++i) {
+        input[i] = static_cast<int16_t>(4096 + 1000 * std::sin(2.0 * 3.14159 * 120 * i / 1000));
+    }
+    
+    // Filtering in windows must match filtering in one block
+    int16_t a[N];
+    int16_t b[N];
+    for (size_t w = 0; w < N; w += 256) {
+        streamed.process(&input[w], &a[w], 256);
+    }
+    whole.process(input, b, N);
+    for (size_t i = 0; i < N; ++i) {
+        ASSERT_EQ(a[i], b[i]);
+    }
+    
+    // After settling, the DC bin is gone while the 120 Hz tone survives
+    int64_t sum = 0;
+    int16_t peak = 0;
+    for (size_t i = N - 512; i < N; ++i) {
+        sum += a[i];
+        if (a[i] > peak) peak = a[i];
+    }
+    ASSERT_TRUE(std::abs(sum / 512) < 50);
+    ASSERT_TRUE(peak > 800);
+}
+
+TEST(prefilter_notch_attenuates_mains) {
+    core::PreFilter filter;
+    filter.add_section(core::design_notch(50.0f, 1000, 10.0f));
+    
+    constexpr size_t N = 2048;
+    int16_t signal[N];
+    for (size_t i = 0; i < N; ++i) {
+        signal[i] = static_cast<int16_t>(8000 * std::sin(2.0 * 3.14159265 * 50 * i / 1000));
+    }
+    filter.process(signal, signal, N);
+    
+    int16_t peak = 0;
+    for (size_t i = N - 256; i < N; ++i) {
+        if (std::abs(signal[i]) > peak) peak = static_cast<int16_t>(std::abs(signal[i]));
+    }
+    ASSERT_TRUE(peak < 400);
+}
+
+// Test window pipeline
+TEST(pipeline_matches_separate_stages) {
+    core::SpectralProcessor proc(64, 1000);
+    core::InferenceEngine engine = core::create_default_engine();
+    core::ThresholdConfig config = core::get_default_config();
+    core::WindowPipeline pipeline(proc, engine, config);
+    
+    int16_t samples[256];
+    for (size_t i = 0; i < 256; ++i) {
+        samples[i] = static_cast<int16_t>(
+            3000 * std::sin(2.0 * 3.14159 * 50 * i / 1000) +
+            2000 * std::sin(2.0 * 3.14159 * 237 * i / 1000));
+    }
+    
+    core::SpectralResult spectral = proc.process(samples, 256);
+    hal::fixed_t features[64];
+    size_t count = proc.extract_features(samples, 256, features, 64);
+    core::InferenceResult inference = engine.run(features, count);
+    core::Decision decision = core::evaluate_structure(
+        spectral, inference, hal::BATTERY_NOMINAL_MV, config);
+    
+    core::WindowOutcome outcome = pipeline.process_window(samples, 256, hal::BATTERY_NOMINAL_MV);
+    ASSERT_EQ(outcome.spectral.peak_magnitude, spectral.peak_magnitude);
+    ASSERT_EQ(outcome.spectral.spectral_centroid, spectral.spectral_centroid);
+    ASSERT_EQ(outcome.spectral.num_peaks, spectral.num_peaks);
+    ASSERT_EQ(outcome.inference.confidence, inference.confidence);
+    ASSERT_EQ(outcome.inference.predicted_class, inference.predicted_class);
+    ASSERT_EQ(outcome.decision, decision);
+}
+
+TEST(inference_batch_matches_single) {
+    core::InferenceEngine engine = core::create_default_engine();
+    core::SpectralProcessor proc(engine.get_input_size(), 1000);
+    const size_t inputs = engine.get_input_size();
+    const size_t batch = 11;  // Not a multiple of the tile
+    
+    std::vector<hal::fixed_t> features(inputs * batch);
+    int16_t window[256];
+    for (size_t b = 0; b < batch; ++b) {
+        for (size_t i = 0; i < 256; ++i) {
+            window[i] = static_cast<int16_t>(
+                (1000 + 300 * b) * std::sin(2.0 * 3.14159 * (20 + 30 * b) * i / 1000));
+        }
+        proc.extract_features(window, 256, &features[b * inputs], inputs);
+    }
+    
+    std::vector<core::InferenceResult> results(batch);
+    engine.run_batch(features.data(), inputs, batch, results.data());
+    for (size_t b = 0; b < batch; ++b) {
+        core::InferenceResult single = engine.run(&features[b * inputs], inputs);
+        ASSERT_EQ(results[b].confidence, single.confidence);
+        ASSERT_EQ(results[b].predicted_class, single.predicted_class);
+    }
+}
+
+// Test latency instrumentation
+TEST(latency_buckets_are_monotonic) {
+    namespace lb = core::latency_buckets;
+    ASSERT_EQ(lb::index_of(0), 0u);
+    ASSERT_EQ(lb::index_of(15), 15u);
+    ASSERT_EQ(lb::index_of(~uint64_t(0)), lb::NUM_BUCKETS - 1);
+    
+    // Every value maps to a bucket whose lower bound is within 1/16 below it
+    for (uint64_t v = 1; v < (uint64_t(1) << 36); v = v * 3 + 1) {
+        size_t index = lb::index_of(v);
+        uint64_t lower = lb::lower_bound(index);
+        ASSERT_TRUE(lower <= v);
+        ASSERT_TRUE(v - lower <= v / 16);
+        ASSERT_TRUE(index + 1 == lb::NUM_BUCKETS || lb::lower_bound(index + 1) > v);
+    }
+}
+
+TEST(pipeline_latency_probes_record_stages) {
+    core::SpectralProcessor proc(64, 1000);
+    core::InferenceEngine engine = core::create_default_engine();
+    core::WindowPipeline pipeline(proc, engine, core::get_default_config());
+    
+    int16_t window[256];
+    for (size_t i = 0; i < 256; ++i) {
+        window[i] = static_cast<int16_t>(3000 * std::sin(2.0 * 3.14159 * 50 * i / 1000));
+    }
+    
+    core::latency::reset();
+    for (int w = 0; w < 5; ++w) {
+        pipeline.process_window(window, 256, hal::BATTERY_NOMINAL_MV);
+    }
+    
+    core::LatencySummary window_latency = core::latency::get_summary(core::LatencyStage::WINDOW);
+    core::LatencySummary spectral = core::latency::get_summary(core::LatencyStage::SPECTRAL);
+    core::LatencySummary prefilter = core::latency::get_summary(core::LatencyStage::PREFILTER);
+    if (core::latency::ENABLED) {
+        ASSERT_EQ(window_latency.count, 5u);
+        ASSERT_EQ(spectral.count, 5u);
+        ASSERT_EQ(prefilter.count, 0u);  // No pre-filter attached
+        ASSERT_TRUE(spectral.p50_ns > 0.0);
+        ASSERT_TRUE(window_latency.mean_ns >= spectral.mean_ns);
+        
+        // Short-lived workers hand their shard on; their samples stay counted
+        for (int t = 0; t < 64; ++t) {
+            std::thread worker([] { SG_LATENCY_PROBE(PREFILTER); });
+            worker.join();
+        }
+        ASSERT_EQ(core::latency::get_summary(core::LatencyStage::PREFILTER).count, 64u);
+    } else {
+        ASSERT_EQ(window_latency.count, 0u);
+    }
+}
+
+TEST(trace_records_stages_and_model_swap) {
+    core::SpectralProcessor proc(64, 1000);
+    core::InferenceEngine engine = core::create_default_engine();
+    core::InferenceEngine replacement = core::create_default_engine();
+    core::WindowPipeline pipeline(proc, engine, core::get_default_config());
+    core::SimilarityCache cache(1);
+    pipeline.set_similarity_cache(&cache);
+    
+    int16_t window[256];
+    for (size_t i = 0; i < 256; ++i) {
+        window[i] = static_cast<int16_t>(3000 * std::sin(2.0 * 3.14159 * 50 * i / 1000));
+    }
+    
+    core::trace::clear();
+    core::trace::set_enabled(true);
+    pipeline.process_window(window, 256, hal::BATTERY_NOMINAL_MV);
+    pipeline.set_engine(replacement);
+    pipeline.process_window(window, 256, hal::BATTERY_NOMINAL_MV);
+    core::trace::set_enabled(false);
+    pipeline.process_window(window, 256, hal::BATTERY_NOMINAL_MV);  // Not recorded
+    
+    // The swap dropped cached results, so both recorded windows ran the model
+    ASSERT_EQ(cache.get_stats().hits, 1u);
+    
+    if (core::trace::COMPILED_IN) {
+        size_t windows = 0;
+        size_t inferences = 0;
+        size_t swaps = 0;
+        for (const auto& t : core::trace::snapshot()) {
+            for (const auto& e : t.events) {
+                std::string name = e.name;
+                if (name == "window") ++windows;
+                if (name == "inference") ++inferences;
+                if (name == "model_swap" && e.instant) ++swaps;
+            }
+        }
+        ASSERT_EQ(windows, 2u);
+        ASSERT_EQ(inferences, 2u);
+        ASSERT_EQ(swaps, 1u);
+        
+        const char* path = "test_trace.json";
+        bool written = host::write_chrome_trace(path);
+        ASSERT_TRUE(written);
+        std::FILE* f = std::fopen(path, "rb");
+        ASSERT_TRUE(f != nullptr);
+        char head[32] = {};
+        ASSERT_TRUE(std::fread(head, 1, sizeof(head) - 1, f) > 0);
+        std::fclose(f);
+        std::remove(path);
+        ASSERT_TRUE(std::strstr(head, "displayTimeUnit") != nullptr);
+        
+        // Rings of finished threads are reused, so more short-lived
+        // threads than MAX_THREADS are all recorded
+        const size_t num_threads = 2 * core::trace::MAX_THREADS;
+        core::trace::clear();
+        core::trace::set_enabled(true);
+        for (size_t i = 0; i < num_threads; ++i) {
+            std::thread([] { SG_TRACE_INSTANT(WORKER, "short_worker"); }).join();
+        }
+        core::trace::set_enabled(false);
+        std::vector<core::trace::ThreadTrace> threads = core::trace::snapshot();
+        size_t short_workers = 0;
+        for (const auto& t : threads) {
+            for (const auto& e : t.events) {
+                if (std::string(e.name) == "short_worker") ++short_workers;
+            }
+        }
+        ASSERT_EQ(short_workers, num_threads);
+        ASSERT_TRUE(threads.size() <= core::trace::MAX_THREADS);
+    }
+}
+
+// Test similarity cache
+TEST(similarity_signature_locality) {
+    hal::fixed_t a[64];
+    hal::fixed_t b[64];
+    for (size_t i = 0; i < 64; ++i) {
+        a[i] = (i == 10) ? hal::FIXED_ONE : hal::float_to_fixed(0.05f);
+        b[i] = a[i];
+    }
+    b[40] = hal::float_to_fixed(0.06f);  // Tiny perturbation
+    
+    uint32_t sa = core::compute_band_signature(a, 64);
+    uint32_t sb = core::compute_band_signature(b, 64);
+    ASSERT_EQ(sa, sb);
+    
+    b[40] = hal::FIXED_ONE;  // New strong peak in another band
+    sb = core::compute_band_signature(b, 64);
+    ASSERT_TRUE(core::signature_distance(sa, sb) >= 1);
+    
+    // The widest range matches any cached signature
+    core::SimilarityCache any(255);
+    core::InferenceResult cached{};
+    cached.predicted_class = 1;
+    core::InferenceResult found{};
+    any.insert(0x00000000u, cached);
+    ASSERT_TRUE(any.lookup(0xFFFFFFFFu, &found));
+    ASSERT_EQ(found.predicted_class, 1);
+}
+
+TEST(pipeline_similarity_cache_reuses_inference) {
+    core::SpectralProcessor proc(64, 1000);
+    core::InferenceEngine engine = core::create_default_engine();
+    core::WindowPipeline pipeline(proc, engine, core::get_default_config());
+    core::SimilarityCache cache(1);
+    pipeline.set_similarity_cache(&cache);
+    
+    int16_t window[256];
+    core::WindowOutcome first{};
+    for (int w = 0; w < 4; ++w) {
+        for (size_t i = 0; i < 256; ++i) {
+            window[i] = static_cast<int16_t>(3000 * std::sin(2.0 * 3.14159 * 50 * i / 1000) + w);
+        }
+        core::WindowOutcome outcome = pipeline.process_window(window, 256, hal::BATTERY_NOMINAL_MV);
+        if (w == 0) first = outcome;
+        ASSERT_EQ(outcome.inference.confidence, first.inference.confidence);
+        ASSERT_EQ(outcome.decision, first.decision);
+    }
+    
+    ASSERT_EQ(cache.get_stats().lookups, 4u);
+    ASSERT_EQ(cache.get_stats().hits, 3u);
+    ASSERT_EQ(cache.get_hit_rate_percent(), 75);
+}
+
+// Test host STFT engine
+TEST(stft_matches_device_spectrum) {
+    std::vector<int16_t> recording(4096);
+    for (size_t i = 0; i < recording.size(); ++i) {
+        recording[i] = static_cast<int16_t>(
+            2000 * std::sin(2.0 * 3.14159 * (40 + i / 64) * i / 1000));
+    }
+    
+    host::StftConfig config = host::get_default_stft_config();
+    config.hop = 96;  // Overlapping frames
+    config.num_threads = 4;
+    host::Spectrogram parallel;
+    bool computed = host::compute_stft(recording.data(), recording.size(), config, &parallel);
+    ASSERT_TRUE(computed);
+    ASSERT_EQ(parallel.num_frames, (4096u - 256u) / 96u + 1u);
+    
+    config.num_threads = 1;
+    host::Spectrogram serial;
+    computed = host::compute_stft(recording.data(), recording.size(), config, &serial);
+    ASSERT_TRUE(computed);
+    ASSERT_TRUE(parallel.magnitudes == serial.magnitudes);
+    
+    core::SpectralProcessor proc(64, 1000);
+    hal::fixed_t expected[64];
+    for (size_t f = 0; f < parallel.num_frames; f += 7) {
+        proc.compute_magnitude_spectrum(&recording[f * 96], 256, expected);
+        for (size_t k = 0; k < 64; ++k) {
+            ASSERT_EQ(parallel.frame(f)[k], expected[k]);
+        }
+    }
+}
+
+TEST(stft_file_round_trip) {
+    ASSERT_EQ(host::half_to_float(host::float_to_half(1.0f)), 1.0f);
+    ASSERT_EQ(host::half_to_float(host::float_to_half(2047.0f)), 2047.0f);
+    ASSERT_EQ(host::half_to_float(host::float_to_half(-0.5f)), -0.5f);
+    ASSERT_TRUE(std::abs(host::half_to_float(host::float_to_half(30000.0f)) - 30000.0f) <= 16.0f);
+    
+    host::Spectrogram spectrogram;
+    spectrogram.config = host::get_default_stft_config();
+    spectrogram.config.num_bins = 4;
+    spectrogram.num_frames = 2;
+    spectrogram.magnitudes = {0, 1, 300, 70000, 5, 6, 7, 8};
+    
+    const char* path = "test_spectrogram.sgsp";
+    host::Spectrogram loaded;
+    bool written = host::write_spectrogram(path, spectrogram, host::SpectrogramFormat::UINT16);
+    ASSERT_TRUE(written);
+    bool read = host::read_spectrogram(path, &loaded);
+    ASSERT_TRUE(read);
+    ASSERT_EQ(loaded.num_frames, 2u);
+    ASSERT_EQ(loaded.config.num_bins, 4u);
+    ASSERT_EQ(loaded.magnitudes[2], 300);
+    ASSERT_EQ(loaded.magnitudes[3], 0xFFFF);  // Saturated
+    
+    written = host::write_spectrogram(path, spectrogram, host::SpectrogramFormat::FLOAT16);
+    ASSERT_TRUE(written);
+    read = host::read_spectrogram(path, &loaded);
+    ASSERT_TRUE(read);
+    ASSERT_EQ(loaded.magnitudes[2], 300);
+    
+    // Corrupt format byte, inflated frame count and truncation are rejected
+    std::vector<uint8_t> bytes;
+    std::FILE* f = std::fopen(path, "rb");
+    ASSERT_TRUE(f != nullptr);
+    int c;
+    while ((c = std::fgetc(f)) != EOF) bytes.push_back(static_cast<uint8_t>(c));
+    std::fclose(f);
+    for (int corruption = 0; corruption < 3; ++corruption) {
+        std::vector<uint8_t> bad = bytes;
+        if (corruption == 0) bad[6] = 7;
+        if (corruption == 1) bad[27] = 0x40;  // num_frames high byte
+        if (corruption == 2) bad.resize(bad.size() - 2);
+        f = std::fopen(path, "wb");
+        ASSERT_TRUE(f != nullptr);
+        std::fwrite(bad.data(), 1, bad.size(), f);
+        std::fclose(f);
+        read = host::read_spectrogram(path, &loaded);
+        ASSERT_FALSE(read);
+    }
+    std::remove(path);
+}
+
+TEST(inference_narrow_output_range_is_uniform) {
+    // One input, two outputs: raw outputs {100, 0} LSB, a range just
+    // above the "nearly equal" cut-off but below 256 LSB
+    const int8_t weights[] = {1, 0};
+    const int8_t biases[] = {0, 0};
+    core::InferenceEngine engine(weights, biases, 1, 2, hal::FIXED_ONE);
+    hal::fixed_t feature = 100 << 7;
+    
+    core::InferenceResult result = engine.run(&feature, 1);
+    ASSERT_EQ(result.predicted_class, 0);
+    ASSERT_EQ(result.confidence, hal::FIXED_ONE / 2);
+}
+
+// Test golden-vector corpus against every kernel variant
+TEST(golden_corpus_matches_all_variants) {
+    host::GoldenCorpus corpus;
+    bool loaded = host::load_golden_corpus(SPECTRAL_GATE_GOLDEN_CORPUS, &corpus);
+    ASSERT_TRUE(loaded);
+    ASSERT_TRUE(corpus.cases.size() > 0);
+    ASSERT_EQ(corpus.model_checksum, core::create_default_engine().get_model_checksum());
+    
+    // Every decision outcome is pinned by at least one vector
+    bool seen[3] = {false, false, false};
+    for (const auto& c : corpus.cases) {
+        seen[static_cast<size_t>(c.decision)] = true;
+    }
+    ASSERT_TRUE(seen[0] && seen[1] && seen[2]);
+    
+    std::vector<host::GoldenVariantReport> reports;
+    bool passed = true;
+    for (const auto& variant : host::get_golden_variants()) {
+        reports.push_back(host::check_golden_variant(corpus, variant, host::get_exact_tolerance()));
+        passed = passed && reports.back().passed;
+    }
+    if (!passed) {
+        std::cout << "\n";
+        host::print_golden_reports(std::cout, reports);
+    }
+    ASSERT_TRUE(passed);
+    
+    // Save/load round trip is lossless
+    const char* path = "test_golden.txt";
+    bool saved = host::save_golden_corpus(path, corpus);
+    ASSERT_TRUE(saved);
+    host::GoldenCorpus reloaded;
+    bool reloaded_ok = host::load_golden_corpus(path, &reloaded);
+    ASSERT_TRUE(reloaded_ok);
+    std::remove(path);
+    ASSERT_EQ(reloaded.cases.size(), corpus.cases.size());
+    ASSERT_TRUE(reloaded.cases.back().samples == corpus.cases.back().samples);
+    ASSERT_TRUE(reloaded.cases.back().features == corpus.cases.back().features);
+}
+
+// Test double-precision reference against the fixed-point path
+TEST(reference_tracks_fixed_path) {
+    hal::MockHAL mock;
+    mock.set_vibration_pattern(1);
+    mock.set_signal_frequency(120);
+    mock.set_signal_amplitude(16000);
+    mock.set_noise_level(200);
+    int16_t samples[hal::VIBRATION_BUFFER_SIZE];
+    mock.read_vibration_data(samples, hal::VIBRATION_BUFFER_SIZE);
+    
+    core::SpectralProcessor spectral(hal::NUM_SPECTRAL_BINS, 1000);
+    host::ReferenceSpectralProcessor reference(hal::NUM_SPECTRAL_BINS, 1000);
+    core::SpectralResult result = spectral.process(samples, hal::VIBRATION_BUFFER_SIZE);
+    host::ReferenceSpectralResult exact = reference.process(samples, hal::VIBRATION_BUFFER_SIZE);
+    ASSERT_EQ(host::to_fixed(exact).dominant_frequency, result.dominant_frequency);
+    
+    // Same features in: the engines differ only by Q15.16 rounding
+    hal::fixed_t features[hal::NUM_SPECTRAL_BINS];
+    double dequantized[hal::NUM_SPECTRAL_BINS];
+    size_t n = spectral.extract_features(samples, hal::VIBRATION_BUFFER_SIZE,
+                                         features, hal::NUM_SPECTRAL_BINS);
+    for (size_t i = 0; i < n; ++i) {
+        dequantized[i] = static_cast<double>(features[i]) / hal::FIXED_ONE;
+    }
+    core::InferenceEngine engine = core::create_default_engine();
+    core::InferenceResult fixed = engine.run(features, n);
+    host::ReferenceInferenceResult ref = host::create_reference_engine().run(dequantized, n);
+    ASSERT_EQ(fixed.predicted_class, ref.predicted_class);
+    ASSERT_TRUE(std::fabs(hal::fixed_to_float(fixed.confidence) - ref.confidence) < 0.01);
+}
+
+// Test error budget over a synthetic dataset
+TEST(error_budget_synthetic_dataset) {
+    host::Dataset dataset;
+    dataset.window_length = hal::VIBRATION_BUFFER_SIZE;
+    dataset.sample_rate = 1000;
+    host::append_synthetic_windows(1, 24, &dataset);
+    ASSERT_EQ(dataset.windows.size(), static_cast<size_t>(24));
+    ASSERT_EQ(dataset.windows[2].label, host::WindowLabel::ANOMALY);
+    
+    core::SpectralProcessor spectral(hal::NUM_SPECTRAL_BINS, dataset.sample_rate);
+    core::InferenceEngine engine = core::create_default_engine();
+    host::ErrorBudgetReport report = host::run_error_budget(
+        dataset, spectral, engine,
+        host::ReferenceSpectralProcessor(hal::NUM_SPECTRAL_BINS, dataset.sample_rate),
+        host::create_reference_engine(), core::get_default_config());
+    
+    ASSERT_EQ(report.windows, static_cast<size_t>(24));
+    ASSERT_EQ(report.spectrum.count, 24 * hal::NUM_SPECTRAL_BINS);
+    ASSERT_TRUE(report.spectrum.snr_db() > 6.0);
+    ASSERT_TRUE(report.inference.snr_db() > 40.0);
+    ASSERT_TRUE(report.decision_flips <= report.windows);
+}
+
+// Test threshold sweep over cached decision inputs
+TEST(threshold_sweep_matches_pipeline) {
+    host::Dataset dataset;
+    dataset.window_length = hal::VIBRATION_BUFFER_SIZE;
+    dataset.sample_rate = 1000;
+    host::append_synthetic_windows(3, 48, &dataset);
+    
+    host::DecisionInputs inputs;
+    host::collect_decision_inputs(dataset, nullptr, 2, &inputs);
+    ASSERT_EQ(inputs.spectral.size(), dataset.windows.size());
+    
+    core::ThresholdConfig loose = core::get_default_config();
+    loose.min_peak_magnitude = hal::float_to_fixed(0.005f);
+    std::vector<core::ThresholdConfig> candidates = {core::get_default_config(), loose};
+    std::vector<host::TunerResult> results = host::sweep_thresholds(inputs, candidates, 2000.0, 2);
+    ASSERT_EQ(results.size(), candidates.size());
+    
+    // Counts agree with running the whole pipeline per window
+    core::SpectralProcessor spectral(hal::NUM_SPECTRAL_BINS, dataset.sample_rate);
+    core::InferenceEngine engine = core::create_default_engine();
+    for (size_t c = 0; c < candidates.size(); ++c) {
+        core::WindowPipeline pipeline(spectral, engine, candidates[c]);
+        size_t transmissions = 0;
+        size_t missed = 0;
+        for (const auto& window : dataset.windows) {
+            std::vector<int16_t> samples = window.samples;
+            core::Decision d = pipeline.process_window(samples.data(), samples.size(),
+                                                       window.battery_mv).decision;
+            transmissions += (d != core::Decision::SLEEP) ? 1 : 0;
+            missed += (window.label == host::WindowLabel::ANOMALY && d == core::Decision::SLEEP) ? 1 : 0;
+        }
+        ASSERT_EQ(results[c].alerts + results[c].uncertain, transmissions);
+        ASSERT_EQ(results[c].missed_alerts, missed);
+    }
+    ASSERT_TRUE(results[1].missed_alerts <= results[0].missed_alerts);
+}
+
+// Test on-disk feature cache
+TEST(feature_cache_round_trip) {
+    const char* path = "test_feature_cache.bin";
+    std::remove(path);
+    
+    hal::MockHAL mock;
+    int16_t windows[3][hal::VIBRATION_BUFFER_SIZE];
+    for (auto& w : windows) {
+        mock.read_vibration_data(w, hal::VIBRATION_BUFFER_SIZE);
+    }
+    core::SpectralProcessor processor(hal::NUM_SPECTRAL_BINS, 1000);
+    hal::fixed_t expected[3][hal::NUM_SPECTRAL_BINS];
+    core::SpectralResult expected_spectral[3];
+    size_t n = 0;
+    
+    {
+        host::FeatureCache cache;
+        bool opened = cache.open(path);
+        ASSERT_TRUE(opened);
+        for (size_t i = 0; i < 3; ++i) {
+            expected_spectral[i] = host::process_with_features_cached(
+                &cache, processor, windows[i], hal::VIBRATION_BUFFER_SIZE,
+                expected[i], hal::NUM_SPECTRAL_BINS, &n);
+        }
+        ASSERT_EQ(cache.get_stats().misses, 3u);
+        ASSERT_EQ(cache.size(), static_cast<size_t>(3));
+    }
+    
+    // A torn record at the tail is dropped on reopen
+    FILE* f = std::fopen(path, "ab");
+    ASSERT_TRUE(f != nullptr);
+    const uint8_t garbage[20] = {1, 2, 3};
+    std::fwrite(garbage, 1, sizeof(garbage), f);
+    std::fclose(f);
+    
+    host::FeatureCache cache;
+    bool reopened = cache.open(path);
+    ASSERT_TRUE(reopened);
+    ASSERT_EQ(cache.size(), static_cast<size_t>(3));
+    for (size_t i = 0; i < 3; ++i) {
+        hal::fixed_t features[hal::NUM_SPECTRAL_BINS];
+        core::SpectralResult spectral = host::process_with_features_cached(
+            &cache, processor, windows[i], hal::VIBRATION_BUFFER_SIZE,
+            features, hal::NUM_SPECTRAL_BINS, &n);
+        ASSERT_EQ(n, hal::NUM_SPECTRAL_BINS);
+        ASSERT_EQ(std::memcmp(features, expected[i], sizeof(features)), 0);
+        ASSERT_EQ(spectral.peak_magnitude, expected_spectral[i].peak_magnitude);
+        ASSERT_EQ(spectral.num_peaks, expected_spectral[i].num_peaks);
+    }
+    ASSERT_EQ(cache.get_stats().hits, 3u);
+    
+    // A different spectral configuration does not match
+    core::SpectralProcessor other(hal::NUM_SPECTRAL_BINS, 2000);
+    ASSERT_TRUE(host::hash_spectral_config(other) != host::hash_spectral_config(processor));
+    cache.close();
+    std::remove(path);
+}
+
+// Test incremental re-evaluation
+TEST(incremental_reruns_only_invalidated_stages) {
+    host::Dataset dataset;
+    dataset.window_length = hal::VIBRATION_BUFFER_SIZE;
+    dataset.sample_rate = 1000;
+    host::append_synthetic_windows(5, 40, &dataset);
+    
+    host::IncrementalEvaluator evaluator(hal::NUM_SPECTRAL_BINS, dataset.sample_rate);
+    host::IncrementalStats stats = evaluator.evaluate(dataset, 2);
+    ASSERT_EQ(stats.spectral_runs, static_cast<size_t>(40));
+    ASSERT_EQ(stats.decision_runs, static_cast<size_t>(40));
+    
+    // Nothing changed
+    stats = evaluator.evaluate(dataset, 2);
+    ASSERT_EQ(stats.spectral_runs + stats.inference_runs + stats.decision_runs, static_cast<size_t>(0));
+    
+    // Thresholds only: decisions rerun, and match a full evaluation
+    core::ThresholdConfig config = core::get_default_config();
+    config.min_peak_magnitude = hal::float_to_fixed(0.005f);
+    evaluator.set_config(config);
+    stats = evaluator.evaluate(dataset, 2);
+    ASSERT_EQ(stats.spectral_runs, static_cast<size_t>(0));
+    ASSERT_EQ(stats.inference_runs, static_cast<size_t>(0));
+    ASSERT_EQ(stats.decision_runs, static_cast<size_t>(40));
+    core::SpectralProcessor spectral(hal::NUM_SPECTRAL_BINS, dataset.sample_rate);
+    core::InferenceEngine engine = core::create_default_engine();
+    core::WindowPipeline pipeline(spectral, engine, config);
+    for (size_t w = 0; w < dataset.windows.size(); ++w) {
+        std::vector<int16_t> samples = dataset.windows[w].samples;
+        core::WindowOutcome outcome = pipeline.process_window(
+            samples.data(), samples.size(), dataset.windows[w].battery_mv);
+        ASSERT_EQ(evaluator.get_decisions()[w], outcome.decision);
+        ASSERT_EQ(evaluator.get_inference()[w].confidence, outcome.inference.confidence);
+    }
+    
+    // Model only: inference and decisions rerun
+    int8_t biases[MODEL_OUTPUT_SIZE] = {};
+    core::InferenceEngine other(MODEL_WEIGHTS, biases, MODEL_INPUT_SIZE, MODEL_OUTPUT_SIZE, MODEL_SCALE_FACTOR);
+    evaluator.set_engine(other);
+    stats = evaluator.evaluate(dataset, 2);
+    ASSERT_EQ(stats.spectral_runs, static_cast<size_t>(0));
+    ASSERT_EQ(stats.inference_runs, static_cast<size_t>(40));
+    
+    // One edited window and one new window
+    dataset.windows[7].samples[0] ^= 1;
+    dataset.windows.push_back(dataset.windows[0]);
+    dataset.windows.back().samples[1] ^= 1;
+    stats = evaluator.evaluate(dataset, 2);
+    ASSERT_EQ(stats.spectral_runs, static_cast<size_t>(2));
+    ASSERT_EQ(stats.decision_runs, static_cast<size_t>(2));
+}
+
+// Test columnar decision log
+TEST(decision_log_round_trip) {
+    const char* path = "test_decision_log.sgdl";
+    core::ThresholdConfig config = core::get_default_config();
+    
+    // More than one block, cycling through battery regimes and classes
+    const size_t n = host::DecisionLogWriter::BLOCK_RECORDS + 37;
+    host::DecisionColumns expected;
+    {
+        host::DecisionLogWriter writer;
+        bool opened = writer.open(path);
+        ASSERT_TRUE(opened);
+        for (size_t i = 0; i < n; ++i) {
+            core::SpectralResult spectral{};
+            spectral.dominant_frequency = hal::float_to_fixed(150.0f);
+            spectral.peak_magnitude = hal::float_to_fixed(0.5f);
+            spectral.num_peaks = static_cast<uint8_t>(2 + i % 3);
+            core::InferenceResult inference{};
+            inference.confidence = hal::float_to_fixed(static_cast<float>(i % 100) / 100.0f);
+            inference.predicted_class = static_cast<uint8_t>(i % 3);
+            uint16_t battery = static_cast<uint16_t>(2800 + (i % 4) * 400);
+            core::Decision decision = core::evaluate_structure(spectral, inference, battery, config);
+            host::DecisionRecord record = host::make_decision_record(
+                static_cast<uint32_t>(i * 60), static_cast<uint16_t>(i % 7), battery,
+                spectral, inference, decision, config);
+            expected.push_back(record);
+            bool appended = writer.append(record);
+            ASSERT_TRUE(appended);
+        }
+        bool closed = writer.close();
+        ASSERT_TRUE(closed);
+        ASSERT_EQ(writer.get_records(), static_cast<uint64_t>(n));
+    }
+    
+    host::DecisionColumns columns;
+    bool read = host::read_decision_log(path, &columns);
+    ASSERT_TRUE(read);
+    ASSERT_EQ(columns.size(), n);
+    ASSERT_TRUE(columns.time_s == expected.time_s);
+    ASSERT_TRUE(columns.node_id == expected.node_id);
+    ASSERT_TRUE(columns.battery_mv == expected.battery_mv);
+    ASSERT_TRUE(columns.confidence == expected.confidence);
+    ASSERT_TRUE(columns.threshold == expected.threshold);
+    ASSERT_TRUE(columns.decision == expected.decision);
+    ASSERT_TRUE(columns.reason == expected.reason);
+    
+    // Same row layout as the demo table
+    host::DecisionColumns first;
+    first.push_back(columns.row(0));
+    std::ostringstream table;
+    host::print_decision_table(table, first);
+    ASSERT_TRUE(table.str().find("│ 00:00    │       2800 │        0.0% │     97.5% │ SLEEP       │ Normal Op     │") !=
+                std::string::npos);
+    
+    // A torn final block keeps the complete block before it
+    FILE* f = std::fopen(path, "ab");
+    ASSERT_TRUE(f != nullptr);
+    const uint8_t garbage[12] = {5, 0, 0, 0};
+    std::fwrite(garbage, 1, sizeof(garbage), f);
+    std::fclose(f);
+    columns.clear();
+    ASSERT_TRUE(!host::read_decision_log(path, &columns));
+    ASSERT_EQ(columns.size(), n);
+    std::remove(path);
+}
+
+// Test indexed decision log queries against a brute-force scan
+TEST(log_query_matches_scan) {
+    const char* path = "test_log_query.sgdl";
+    const std::string index_path = std::string(path) + ".sgdx";
+    std::remove(index_path.c_str());
+    
+    // Three blocks; 9 nodes report once a minute
+    const size_t n = 2 * host::DecisionLogWriter::BLOCK_RECORDS + 500;
+    {
+        host::DecisionLogWriter writer;
+        bool opened = writer.open(path);
+        ASSERT_TRUE(opened);
+        for (size_t i = 0; i < n; ++i) {
+            host::DecisionRecord record{};
+            record.time_s = static_cast<uint32_t>((i / 9) * 60);
+            record.node_id = static_cast<uint16_t>(100 + i % 9);
+            record.battery_mv = static_cast<uint16_t>(4100 - (i % 13) * 100);
+            record.confidence = hal::float_to_fixed(static_cast<float>(i % 10) / 10.0f);
+            record.decision = static_cast<core::Decision>((i * 7 / 3) % 3);
+            bool appended = writer.append(record);
+            ASSERT_TRUE(appended);
+        }
+        bool closed = writer.close();
+        ASSERT_TRUE(closed);
+    }
+    host::DecisionColumns all;
+    bool read = host::read_decision_log(path, &all);
+    ASSERT_TRUE(read);
+    
+    host::LogQuery queries[4];
+    queries[0] = host::get_default_log_query();
+    queries[1] = host::get_default_log_query();
+    queries[1].filter_decision = true;
+    queries[1].decision = core::Decision::TX_UNCERTAIN;
+    queries[1].from_s = 60000;
+    queries[1].to_s = 90000;
+    queries[2] = queries[1];
+    queries[2].filter_node = true;
+    queries[2].node_id = 104;
+    queries[3] = host::get_default_log_query();
+    queries[3].filter_node = true;
+    queries[3].node_id = 7;     // Not in the log
+    
+    for (int pass = 0; pass < 2; ++pass) {
+        host::DecisionLogIndex index;
+        bool opened = index.open(path, 3, false);
+        ASSERT_TRUE(opened);
+        ASSERT_EQ(index.loaded_from_file(), pass == 1);
+        ASSERT_EQ(index.get_records(), static_cast<uint64_t>(n));
+        ASSERT_EQ(index.get_nodes().size(), static_cast<size_t>(9));
+        
+        for (const host::LogQuery& q : queries) {
+            host::LogQueryStats stats;
+            std::vector<host::NodeAggregate> result = index.aggregate(q, 4, &stats);
+            
+            std::vector<uint64_t> expected(9, 0);
+            std::vector<uint16_t> min_mv(9, 0xFFFF);
+            for (size_t i = 0; i < all.size(); ++i) {
+                if ((q.filter_node && all.node_id[i] != q.node_id) ||
+                    all.time_s[i] < q.from_s || all.time_s[i] > q.to_s ||
+                    (q.filter_decision && all.decision[i] != q.decision)) {
+                    continue;
+                }
+                size_t slot = all.node_id[i] - 100;
+                ++expected[slot];
+                min_mv[slot] = (all.battery_mv[i] < min_mv[slot]) ? all.battery_mv[i] : min_mv[slot];
+            }
+            uint64_t matched = 0;
+            size_t nodes = 0;
+            for (size_t slot = 0; slot < 9; ++slot) {
+                matched += expected[slot];
+                nodes += (expected[slot] > 0) ? 1 : 0;
+            }
+            ASSERT_EQ(result.size(), nodes);
+            ASSERT_EQ(stats.records_matched, matched);
+            for (const host::NodeAggregate& a : result) {
+                ASSERT_EQ(a.windows, expected[a.node_id - 100]);
+                ASSERT_EQ(a.min_battery_mv, min_mv[a.node_id - 100]);
+            }
+            if (q.to_s != 0xFFFFFFFFu) {
+                // The time index skips stripes outside the range
+                ASSERT_TRUE(stats.stripes_scanned < stats.stripes_total);
+            }
+        }
+    }
+    std::remove(path);
+    std::remove(index_path.c_str());
+}
+
+// Test metrics registry
+TEST(event_ring_survives_reset_and_flushes) {
+    hal::MockHAL mock_hal(hal::BATTERY_NOMINAL_MV);
+    core::ThresholdConfig config = core::get_default_config();
+    
+    core::EventRing ring(mock_hal.get_event_ring_area(), hal::EVENT_RING_AREA_BYTES);
+    bool restored_empty = ring.restore();
+    ASSERT_FALSE(restored_empty);
+    ASSERT_EQ(ring.pending(), static_cast<size_t>(0));
+    
+    // Overfill; one large time jump exercises the absolute-time escape
+    const size_t n = ring.capacity() + 40;
+    std::vector<core::EventRecord> pushed;
+    for (size_t i = 0; i < n; ++i) {
+        core::InferenceResult inference{};
+        inference.confidence = hal::float_to_fixed(static_cast<float>(i % 100) / 100.0f);
+        inference.predicted_class = static_cast<uint8_t>(i % 3);
+        uint16_t battery = static_cast<uint16_t>(2800 + (i % 4) * 400);
+        core::SpectralResult spectral{};
+        core::Decision decision = core::evaluate_structure(spectral, inference, battery, config);
+        core::DecisionReason reason = core::get_decision_reason(
+            decision, inference, battery, core::get_effective_threshold(battery, config));
+        uint32_t time_s = static_cast<uint32_t>(i * 60 + (i >= n - 10 ? 200000 : 0));
+        pushed.push_back(core::make_event_record(time_s, battery, inference, decision, reason));
+        ring.push(pushed.back());
+    }
+    ASSERT_EQ(ring.pending(), ring.capacity());
+    ASSERT_EQ(ring.get_dropped(), 40u);
+    ASSERT_TRUE(ring.needs_spill());
+    
+    // Warm reset: a fresh ring over the same retained area keeps everything
+    core::EventRing restored(mock_hal.get_event_ring_area(), hal::EVENT_RING_AREA_BYTES);
+    bool restored_full = restored.restore();
+    ASSERT_TRUE(restored_full);
+    ASSERT_EQ(restored.pending(), ring.capacity());
+    
+    // Piggyback the oldest events on an alert frame
+    bool sent = core::transmit_alert_with_events(mock_hal, restored, 1, 99, 12345);
+    ASSERT_TRUE(sent);
+    ASSERT_EQ(mock_hal.get_transmitted_frames().size(), static_cast<size_t>(1));
+    const std::vector<uint8_t>& frame = mock_hal.get_transmitted_frames()[0];
+    ASSERT_TRUE(frame.size() <= hal::MAX_FRAME_BYTES);
+    host::AlertFrame alert;
+    std::vector<host::DecodedEvent> radio;
+    bool decoded_frame = host::decode_alert_frame(frame.data(), frame.size(), &alert, &radio);
+    ASSERT_TRUE(decoded_frame);
+    ASSERT_EQ(alert.time_s, 12345u);
+    ASSERT_TRUE(!radio.empty());
+    ASSERT_EQ(radio.front().sequence, 40u);
+    ASSERT_EQ(restored.pending(), ring.capacity() - radio.size());
+    
+    // Spill the rest to flash; pad like the flash driver does
+    size_t spilled = core::spill_events(mock_hal, restored, true);
+    ASSERT_EQ(spilled + radio.size(), ring.capacity());
+    ASSERT_EQ(restored.pending(), static_cast<size_t>(0));
+    
+    std::vector<uint8_t> capture(frame.begin() + core::ALERT_HEADER_BYTES, frame.end());
+    capture.insert(capture.end(), 5, 0xFF);
+    capture.insert(capture.end(), mock_hal.get_flash_log().begin(), mock_hal.get_flash_log().end());
+    capture.insert(capture.end(), mock_hal.get_flash_log().begin(), mock_hal.get_flash_log().end());
+    std::vector<host::DecodedEvent> decoded;
+    host::EventDecodeStats stats;
+    bool decoded_log = host::decode_event_log(capture.data(), capture.size(), &decoded, &stats);
+    ASSERT_TRUE(decoded_log);
+    ASSERT_EQ(stats.padding_bytes, static_cast<size_t>(5));
+    
+    // Duplicate flash batches collapse; nothing is missing after the drop
+    host::sort_events(&decoded);
+    ASSERT_EQ(decoded.size(), ring.capacity());
+    ASSERT_EQ(host::count_missing_events(decoded), 0u);
+    for (const host::DecodedEvent& e : decoded) {
+        const core::EventRecord& expected = pushed[e.sequence];
+        ASSERT_EQ(e.event.time_s, expected.time_s);
+        ASSERT_EQ(e.event.battery_mv, expected.battery_mv);
+        ASSERT_EQ(e.event.confidence_pct, expected.confidence_pct);
+        ASSERT_EQ(e.event.flags, expected.flags);
+    }
+    host::DecisionRecord record = host::event_to_decision_record(decoded.back(), 7, config);
+    ASSERT_EQ(record.node_id, 7);
+    ASSERT_TRUE(record.decision == core::event_decision(pushed.back()));
+    
+    // A torn batch stops decoding and keeps what came before
+    std::vector<uint8_t> torn(mock_hal.get_flash_log().begin(), mock_hal.get_flash_log().end() - 3);
+    std::vector<host::DecodedEvent> partial;
+    bool decoded_torn = host::decode_event_log(torn.data(), torn.size(), &partial, &stats);
+    ASSERT_FALSE(decoded_torn);
+    ASSERT_TRUE(partial.size() < spilled);
+}
+
+TEST(replay_matches_logged_decisions) {
+    host::Dataset dataset;
+    dataset.window_length = 256;
+    dataset.sample_rate = 1000;
+    host::append_synthetic_windows(3, 60, &dataset);
+    
+    // Log the node's decisions; every third window is also uploaded raw
+    host::ReplayConfig config = host::get_default_replay_config();
+    core::SpectralProcessor processor(config.num_bins, config.sample_rate);
+    core::InferenceEngine engine = core::create_default_engine();
+    core::WindowPipeline pipeline(processor, engine, config.thresholds);
+    host::DecisionColumns log;
+    std::vector<host::ReplayWindow> uploads;
+    for (size_t i = 0; i < dataset.windows.size(); ++i) {
+        const host::DatasetWindow& window = dataset.windows[i];
+        std::vector<int16_t> samples = window.samples;
+        core::WindowOutcome outcome = pipeline.process_window(samples.data(), samples.size(), window.battery_mv);
+        uint16_t node = static_cast<uint16_t>(i % 6);
+        uint32_t time_s = static_cast<uint32_t>((dataset.windows.size() - i) * 60);
+        log.push_back(host::make_decision_record(time_s, node, window.battery_mv, outcome.spectral,
+                                                 outcome.inference, outcome.decision, config.thresholds));
+        if (i % 3 == 0) {
+            uploads.push_back({node, time_s, window.samples});
+        }
+    }
+    
+    // Same code, same config: nothing diverges
+    host::ReplayReport same = host::replay_decisions(log, uploads, config);
+    ASSERT_EQ(same.nodes.size(), static_cast<size_t>(6));
+    ASSERT_TRUE(same.divergences.empty());
+    uint64_t records = 0;
+    uint64_t pipelined = 0;
+    for (const host::NodeReplaySummary& s : same.nodes) {
+        ASSERT_EQ(s.records, s.replayed_features + s.replayed_pipeline + s.skipped);
+        records += s.records;
+        pipelined += s.replayed_pipeline;
+    }
+    ASSERT_EQ(records, 60u);
+    ASSERT_EQ(pipelined, 20u);
+    
+    // Stricter config: divergences match a direct evaluation, and the
+    // report does not depend on the thread count
+    config.thresholds.base_confidence_threshold = hal::float_to_fixed(0.9f);
+    config.thresholds.min_peaks_for_detection = 1;
+    config.num_threads = 1;
+    host::ReplayReport serial = host::replay_decisions(log, uploads, config);
+    config.num_threads = 4;
+    host::ReplayReport parallel = host::replay_decisions(log, uploads, config);
+    ASSERT_FALSE(serial.divergences.empty());
+    ASSERT_EQ(serial.divergences.size(), parallel.divergences.size());
+    for (size_t i = 0; i < serial.divergences.size(); ++i) {
+        const host::ReplayDivergence& d = serial.divergences[i];
+        ASSERT_EQ(d.row, parallel.divergences[i].row);
+        ASSERT_TRUE(d.replayed_decision == parallel.divergences[i].replayed_decision);
+        if (i > 0) {
+            const host::ReplayDivergence& prev = serial.divergences[i - 1];
+            ASSERT_TRUE(prev.node_id < d.node_id || (prev.node_id == d.node_id && prev.time_s <= d.time_s));
+        }
+        
+        host::DecisionRecord r = log.row(d.row);
+        core::SpectralResult spectral{};
+        spectral.dominant_frequency = r.dominant_frequency;
+        spectral.peak_magnitude = r.peak_magnitude;
+        spectral.num_peaks = r.num_peaks;
+        core::InferenceResult inference{};
+        inference.confidence = r.confidence;
+        inference.predicted_class = r.predicted_class;
+        ASSERT_TRUE(d.replayed_decision ==
+                    core::evaluate_structure(spectral, inference, r.battery_mv, config.thresholds));
+    }
+    
+    std::ostringstream text;
+    host::print_replay_report(text, serial, 5);
+    ASSERT_TRUE(text.str().find("Replayed 60 records from 6 nodes") != std::string::npos);
+}
+
+TEST(scenario_runner_parallel_matches_serial) {
+    std::istringstream csv(
+        "# comment\n"
+        "scenario,time,phase,battery_mv,signal,frequency_hz,confidence,class,peaks,magnitude,expect\n"
+        "edges,06:00,\"Morning, nominal\",4100,features,,0.55,2,3,0.5,TX_UNCERTAIN\n"
+        "edges,06:00:30,,2900,features,,0.55,2,3,0.5,SLEEP\n"
+        "edges,07:00,,,features,,0.99,1,5,0.9,TX_ALERT\n"
+        "signals,0,,3700,noise,,,,,,\n"
+        "signals,10,,,sine,200,,,,,\n"
+        "edges,08:00,,3700,features,,0.50,1,3,0.5,TX_ALERT\n"
+        "signals,20,,,anomaly,,,,,,\n");
+    std::vector<host::Scenario> scenarios;
+    std::string error;
+    bool parsed = host::parse_scenarios(csv, "inline", &scenarios, &error);
+    ASSERT_TRUE(parsed);
+    ASSERT_EQ(scenarios.size(), static_cast<size_t>(2));
+    ASSERT_EQ(scenarios[0].steps.size(), static_cast<size_t>(4));
+    ASSERT_TRUE(scenarios[0].steps[0].phase == "Morning, nominal");
+    ASSERT_EQ(scenarios[0].steps[1].time_s, 6u * 3600 + 30);
+    ASSERT_FALSE(scenarios[0].steps[2].battery_set);
+    ASSERT_TRUE(scenarios[1].steps[1].signal == host::ScenarioSignal::SINE);
+    ASSERT_EQ(scenarios[1].steps[1].frequency_hz, 200u);
+    
+    // Bad input names the line
+    const char* bad[] = {
+        "scenario,time,signal,bogus\nx,0,noise,1\n",
+        "scenario,time,signal\nx,10,noise\nx,5,noise\n",
+        "scenario,time,signal,confidence\nx,0,features,0.5\n",
+        "scenario,time,signal\nx,4294968,noise\n",             // Past the uint32 ms clock
+        "scenario,time,signal\nx,1193:02:48,noise\n",
+        "scenario,time,signal,min_magnitude\nx,0,noise,1.5\n",
+    };
+    for (const char* text : bad) {
+        std::istringstream in(text);
+        std::vector<host::Scenario> rejected;
+        parsed = host::parse_scenarios(in, "bad", &rejected, &error);
+        ASSERT_FALSE(parsed);
+        ASSERT_TRUE(error.compare(0, 4, "bad:") == 0);
+    }
+    std::istringstream longest("scenario,time,signal\nx,1193:02:47,noise\n");
+    std::vector<host::Scenario> last_ms;
+    parsed = host::parse_scenarios(longest, "longest", &last_ms, &error);
+    ASSERT_TRUE(parsed);
+    ASSERT_EQ(last_ms[0].steps[0].time_s, 4294967u);
+
+    // The last edges step expects the wrong decision
+    core::ThresholdConfig config = core::get_default_config();
+    std::vector<host::ScenarioResult> serial;
+    for (const host::Scenario& scenario : scenarios) {
+        hal::MockHAL hal(hal::BATTERY_NOMINAL_MV);
+        hal.set_verbose(false);
+        serial.push_back(host::run_scenario(scenario, config, hal, host::ScenarioStepCallback()));
+        ASSERT_EQ(hal.get_tick_ms(), scenario.steps.back().time_s * 1000);
+        ASSERT_TRUE(hal.get_flash_log().size() + hal.get_transmitted_frames().size() > 0);
+    }
+    ASSERT_EQ(serial[0].checked, static_cast<size_t>(4));
+    ASSERT_EQ(serial[0].failures.size(), static_cast<size_t>(1));
+    ASSERT_EQ(serial[0].failures[0].line, static_cast<size_t>(8));
+    ASSERT_TRUE(serial[0].failures[0].actual == core::Decision::TX_UNCERTAIN);
+    ASSERT_TRUE(serial[1].passed());
+    
+    std::vector<host::ScenarioResult> parallel = host::run_scenarios(scenarios, config, 4);
+    ASSERT_EQ(parallel.size(), serial.size());
+    for (size_t i = 0; i < serial.size(); ++i) {
+        ASSERT_TRUE(parallel[i].name == serial[i].name);
+        ASSERT_EQ(parallel[i].failures.size(), serial[i].failures.size());
+        ASSERT_EQ(parallel[i].transmissions, serial[i].transmissions);
+        for (size_t d = 0; d < 3; ++d) {
+            ASSERT_EQ(parallel[i].decisions[d], serial[i].decisions[d]);
+        }
+    }
+    
+    std::ostringstream report;
+    host::print_scenario_report(report, parallel);
+    ASSERT_TRUE(report.str().find("2 scenarios: 1 passed, 1 failed") != std::string::npos);
+}
+
+TEST(metrics_counter_sums_thread_shards) {
+    host::MetricsRegistry registry;
+    host::Counter& counter = registry.counter("test_total", "Test counter");
+    host::Histogram& histogram = registry.histogram("test_seconds", "Test histogram", {1.0, 2.0});
+    
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 1000; ++i) {
+                counter.inc();
+                histogram.observe(1.5);
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    
+    ASSERT_EQ(counter.value(), 4000u);
+    ASSERT_TRUE(&registry.counter("test_total", "Test counter") == &counter);
+    std::vector<uint64_t> buckets = histogram.bucket_counts();
+    ASSERT_EQ(buckets.size(), 3u);
+    ASSERT_EQ(buckets[0], 0u);
+    ASSERT_EQ(buckets[1], 4000u);
+    ASSERT_TRUE(std::fabs(histogram.sum() - 6000.0) < 1e-6);
+}
+
+TEST(metrics_prometheus_text_format) {
+    host::MetricsRegistry registry;
+    registry.counter("req_total", "Requests", "code=\"200\"").inc(3);
+    registry.counter("req_total", "Requests", "code=\"500\"").inc();
+    registry.gauge("depth", "Queue depth").set(2.5);
+    registry.histogram("lat", "Latency", {0.1}).observe(0.05);
+    
+    std::string text = registry.render();
+    ASSERT_TRUE(text.find("# TYPE req_total counter\n") != std::string::npos);
+    ASSERT_EQ(text.find("# HELP req_total"), text.rfind("# HELP req_total"));
+    ASSERT_TRUE(text.find("req_total{code=\"200\"} 3\n") != std::string::npos);
+    ASSERT_TRUE(text.find("req_total{code=\"500\"} 1\n") != std::string::npos);
+    ASSERT_TRUE(text.find("depth 2.5\n") != std::string::npos);
+    ASSERT_TRUE(text.find("lat_bucket{le=\"0.1\"} 1\n") != std::string::npos);
+    ASSERT_TRUE(text.find("lat_bucket{le=\"+Inf\"} 1\n") != std::string::npos);
+    ASSERT_TRUE(text.find("lat_count 1\n") != std::string::npos);
+    
+    const char* path = "test_metrics.prom";
+    bool written = registry.write_textfile(path);
+    ASSERT_TRUE(written);
+    std::FILE* f = std::fopen(path, "rb");
+    ASSERT_TRUE(f != nullptr);
+    std::string read_back;
+    char buffer[256];
+    size_t n;
+    while ((n = std::fread(buffer, 1, sizeof(buffer), f)) > 0) read_back.append(buffer, n);
+    std::fclose(f);
+    std::remove(path);
+    ASSERT_TRUE(read_back == text);
+}
+
 int main() {
     std::cout << "\n=== Spectral-Gate Unit Tests ===\n\n";
     
@@ -144,9 +1419,40 @@ int main() {
     RUN_TEST(decision_sleep_on_low_activity);
     RUN_TEST(decision_alert_on_high_confidence);
     RUN_TEST(decision_battery_threshold_scaling);
+    RUN_TEST(decision_activity_gate_is_configurable);
+    RUN_TEST(decision_batch_matches_scalar);
     RUN_TEST(mock_hal_vibration_data);
     RUN_TEST(mock_hal_battery);
     RUN_TEST(spectral_processor_basic);
+    RUN_TEST(mock_hal_vibration_frames);
+    RUN_TEST(spectral_frames_match_single_axis);
+    RUN_TEST(spectral_wide_sample_types);
+    RUN_TEST(acquisition_buffer_types);
+    RUN_TEST(prefilter_removes_dc_and_keeps_state);
+    RUN_TEST(prefilter_notch_attenuates_mains);
+    RUN_TEST(pipeline_matches_separate_stages);
+    RUN_TEST(inference_batch_matches_single);
+    RUN_TEST(latency_buckets_are_monotonic);
+    RUN_TEST(pipeline_latency_probes_record_stages);
+    RUN_TEST(trace_records_stages_and_model_swap);
+    RUN_TEST(similarity_signature_locality);
+    RUN_TEST(pipeline_similarity_cache_reuses_inference);
+    RUN_TEST(stft_matches_device_spectrum);
+    RUN_TEST(stft_file_round_trip);
+    RUN_TEST(inference_narrow_output_range_is_uniform);
+    RUN_TEST(golden_corpus_matches_all_variants);
+    RUN_TEST(reference_tracks_fixed_path);
+    RUN_TEST(error_budget_synthetic_dataset);
+    RUN_TEST(threshold_sweep_matches_pipeline);
+    RUN_TEST(feature_cache_round_trip);
+    RUN_TEST(incremental_reruns_only_invalidated_stages);
+    RUN_TEST(decision_log_round_trip);
+    RUN_TEST(log_query_matches_scan);
+    RUN_TEST(event_ring_survives_reset_and_flushes);
+    RUN_TEST(replay_matches_logged_decisions);
+    RUN_TEST(scenario_runner_parallel_matches_serial);
+    RUN_TEST(metrics_counter_sums_thread_shards);
+    RUN_TEST(metrics_prometheus_text_format);
     
     std::cout << "\n=== All tests passed! ===\n\n";
     return 0;
@@ -0,0 +1,189 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "core/op_counter.h"
+#include "core/pipeline.h"
+#include "core/prefilter.h"
+#include "core/similarity.h"
+#include "hal/hal_mock.h"
+#include "host/cycle_model.h"
+
+using namespace spectral_gate;
+
+/**
+ * @brief Cortex-M33 per-window cost estimator
+ * 
+ * Runs the window pipeline on MockHAL data with the instrumented core,
+ * then converts the counted operations into estimated cycles, time and
+ * energy per stage using the M33 cost table.
+ */
+
+namespace {
+
+void print_usage() {
+    std::cout << "Usage: spectral_cycle_model [options]\n"
+              << "  --windows N      Windows to average over (default 32)\n"
+              << "  --length N       Samples per window (default 256)\n"
+              << "  --bins N         Frequency bins (default 64)\n"
+              << "  --no-prefilter   Skip the biquad pre-filter\n"
+              << "  --similarity     Enable the similarity cache\n"
+              << "  --table PATH     Cost table overrides (key = value)\n"
+              << "  --csv PATH       Write per-stage estimates as CSV\n";
+}
+
+struct StageRow {
+    core::OpStage stage;
+    core::OpCounts counts;
+    host::CostEstimate cost;
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t num_windows = 32;
+    size_t window_length = hal::VIBRATION_BUFFER_SIZE;
+    size_t num_bins = hal::NUM_SPECTRAL_BINS;
+    bool use_prefilter = true;
+    bool use_similarity = false;
+    std::string csv_path;
+    host::CycleCostTable table = host::get_default_m33_cost_table();
+    
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--no-prefilter") == 0) {
+            use_prefilter = false;
+            continue;
+        }
+        if (std::strcmp(arg, "--similarity") == 0) {
+            use_similarity = true;
+            continue;
+        }
+        
+        const char* value = (i + 1 < argc) ? argv[++i] : nullptr;
+        if (value == nullptr) {
+            print_usage();
+            return 1;
+        }
+        
+        if (std::strcmp(arg, "--windows") == 0) {
+            num_windows = std::strtoul(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--length") == 0) {
+            window_length = std::strtoul(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--bins") == 0) {
+            num_bins = std::strtoul(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--table") == 0) {
+            if (!host::load_cost_table(value, &table)) {
+                std::cerr << "Failed to load cost table " << value << "\n";
+                return 1;
+            }
+        } else if (std::strcmp(arg, "--csv") == 0) {
+            csv_path = value;
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+    
+    if (!core::OP_COUNTING_ENABLED) {
+        std::cerr << "Built without SPECTRAL_GATE_OP_COUNT; no operations counted\n";
+        return 1;
+    }
+    if (num_windows == 0 || window_length == 0 || num_bins == 0 ||
+        num_bins > core::WindowPipeline::MAX_FEATURES) {
+        print_usage();
+        return 1;
+    }
+    
+    const uint32_t sample_rate = 1000;
+    hal::MockHAL hal;
+    hal.set_vibration_pattern(1);
+    core::SpectralProcessor processor(num_bins, sample_rate);
+    core::InferenceEngine engine = core::create_default_engine();
+    core::WindowPipeline pipeline(processor, engine, core::get_default_config());
+    
+    core::PreFilter prefilter = core::create_default_prefilter(sample_rate, 50);
+    if (use_prefilter) {
+        pipeline.set_prefilter(&prefilter);
+    }
+    core::SimilarityCache cache(1);
+    if (use_similarity) {
+        pipeline.set_similarity_cache(&cache);
+    }
+    
+    // MockHAL acquisition runs outside spectral_core, so only the
+    // pipeline stages are counted
+    std::vector<int16_t> window(window_length);
+    core::ops::reset();
+    for (size_t w = 0; w < num_windows; ++w) {
+        hal.read_vibration_data(window.data(), window.size());
+        pipeline.process_window(window.data(), window.size(), hal.get_battery_voltage_mv());
+    }
+    
+    std::vector<StageRow> rows;
+    core::OpCounts total = {};
+    for (size_t s = 0; s < core::NUM_OP_STAGES; ++s) {
+        StageRow row;
+        row.stage = static_cast<core::OpStage>(s);
+        row.counts = core::ops::get(row.stage);
+        row.cost = host::estimate_cost(row.counts, static_cast<double>(num_windows), table);
+        for (size_t i = 0; i < core::NUM_OP_CLASSES; ++i) {
+            total.ops[i] += row.counts.ops[i];
+        }
+        rows.push_back(row);
+    }
+    host::CostEstimate total_cost =
+        host::estimate_cost(total, static_cast<double>(num_windows), table);
+    
+    // Per-window table
+    std::cout << "Per-window estimate (" << num_windows << " windows, length "
+              << window_length << ", " << num_bins << " bins, "
+              << table.clock_hz / 1e6 << " MHz)\n";
+    std::cout << std::left << std::setw(12) << "stage" << std::right;
+    for (size_t i = 0; i < core::NUM_OP_CLASSES; ++i) {
+        std::cout << std::setw(11) << core::op_class_name(static_cast<core::OpClass>(i));
+    }
+    std::cout << std::setw(13) << "cycles" << std::setw(11) << "us" << std::setw(11) << "uJ" << "\n";
+    
+    auto print_row = [&](const char* name, const core::OpCounts& counts, const host::CostEstimate& cost) {
+        std::cout << std::left << std::setw(12) << name << std::right << std::fixed;
+        for (size_t i = 0; i < core::NUM_OP_CLASSES; ++i) {
+            std::cout << std::setw(11) << std::setprecision(0)
+                      << static_cast<double>(counts.ops[i]) / static_cast<double>(num_windows);
+        }
+        std::cout << std::setw(13) << std::setprecision(0) << cost.cycles
+                  << std::setw(11) << std::setprecision(1) << cost.microseconds
+                  << std::setw(11) << std::setprecision(2) << cost.microjoules << "\n";
+    };
+    for (const auto& row : rows) {
+        print_row(core::op_stage_name(row.stage), row.counts, row.cost);
+    }
+    print_row("total", total, total_cost);
+    
+    if (!csv_path.empty()) {
+        std::ofstream out(csv_path);
+        out << "stage";
+        for (size_t i = 0; i < core::NUM_OP_CLASSES; ++i) {
+            out << "," << core::op_class_name(static_cast<core::OpClass>(i));
+        }
+        out << ",cycles,us,uj\n";
+        for (const auto& row : rows) {
+            out << core::op_stage_name(row.stage);
+            for (size_t i = 0; i < core::NUM_OP_CLASSES; ++i) {
+                out << "," << static_cast<double>(row.counts.ops[i]) / static_cast<double>(num_windows);
+            }
+            out << "," << row.cost.cycles << "," << row.cost.microseconds
+                << "," << row.cost.microjoules << "\n";
+        }
+        if (!out) {
+            std::cerr << "Failed to write " << csv_path << "\n";
+            return 1;
+        }
+    }
+    
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "host/dataset.h"
+#include "host/error_budget.h"
+
+using namespace spectral_gate;
+
+/**
+ * @brief Error-budget report for the fixed-point path
+ *
+ * Runs the device path (SpectralProcessor, InferenceEngine) and the
+ * double-precision reference (host/reference.h) over a dataset and prints
+ * per-stage SNR and decision-flip rates. Run it before and after an
+ * approximation change to see what accuracy the speedup costs.
+ */
+
+namespace {
+
+constexpr uint32_t SAMPLE_RATE = 1000;
+
+void print_usage() {
+    std::cout << "Usage: spectral_error_budget [options]\n"
+              << "  --dataset PATH    Manifest of recordings (path battery_mv [normal|anomaly])\n"
+              << "  --synthetic N     Add N seeded MockHAL windows (default 64 without --dataset)\n"
+              << "  --seed N          MockHAL noise seed (default 1)\n"
+              << "  --hop N           Samples between recording windows (default window length)\n"
+              << "  --csv PATH        Also write metric,value rows to PATH\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string manifest_path;
+    std::string csv_path;
+    size_t synthetic = 0;
+    bool synthetic_set = false;
+    uint32_t seed = 1;
+    size_t hop = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[++i] : nullptr;
+        if (value == nullptr) {
+            print_usage();
+            return 1;
+        }
+
+        if (std::strcmp(arg, "--dataset") == 0) {
+            manifest_path = value;
+        } else if (std::strcmp(arg, "--synthetic") == 0) {
+            synthetic = std::strtoul(value, nullptr, 10);
+            synthetic_set = true;
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--hop") == 0) {
+            hop = std::strtoul(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--csv") == 0) {
+            csv_path = value;
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    if (manifest_path.empty() && !synthetic_set) {
+        synthetic = 64;
+    }
+
+    host::Dataset dataset;
+    dataset.window_length = hal::VIBRATION_BUFFER_SIZE;
+    dataset.sample_rate = SAMPLE_RATE;
+    if (!manifest_path.empty() && !host::load_dataset_manifest(manifest_path, hop, &dataset)) {
+        std::cerr << "Failed to load dataset " << manifest_path << "\n";
+        return 1;
+    }
+    host::append_synthetic_windows(seed, synthetic, &dataset);
+    if (dataset.windows.empty()) {
+        std::cerr << "Dataset has no windows\n";
+        return 1;
+    }
+
+    core::SpectralProcessor spectral(hal::NUM_SPECTRAL_BINS, dataset.sample_rate);
+    core::InferenceEngine engine = core::create_default_engine();
+    host::ReferenceSpectralProcessor reference_spectral(hal::NUM_SPECTRAL_BINS, dataset.sample_rate);
+    host::ReferenceInferenceEngine reference_engine = host::create_reference_engine();
+
+    host::ErrorBudgetReport report = host::run_error_budget(
+        dataset, spectral, engine, reference_spectral, reference_engine,
+        core::get_default_config());
+    host::print_error_budget(std::cout, report);
+
+    if (!csv_path.empty()) {
+        std::ofstream csv(csv_path);
+        if (!csv) {
+            std::cerr << "Failed to write " << csv_path << "\n";
+            return 1;
+        }
+        host::write_error_budget_csv(csv, report);
+    }
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "host/decision_log.h"
+#include "host/event_decoder.h"
+
+using namespace spectral_gate;
+
+/**
+ * @brief Node event decoder
+ *
+ * Decodes event batches from a flash event log dump and/or a radio
+ * capture (spectral_gate --events), merges them by sequence number,
+ * reports gaps, and prints the events as the decision table or converts
+ * them to a decision log for spectral_log / spectral_query.
+ */
+
+namespace {
+
+void print_usage() {
+    std::cout << "Usage: spectral_events DUMP [DUMP...] [options]\n"
+              << "  --node N          Node id for the decoded records (default 0)\n"
+              << "  --log PATH        Write the events as a decision log\n"
+              << "  --format F        table (default) or csv\n";
+}
+
+bool read_file(const std::string& path, std::vector<uint8_t>* data) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    data->assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> dumps;
+    std::string log_path;
+    uint16_t node_id = 0;
+    bool csv = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strncmp(arg, "--", 2) != 0) {
+            dumps.push_back(arg);
+            continue;
+        }
+        const char* value = (i + 1 < argc) ? argv[++i] : nullptr;
+        if (value == nullptr) {
+            print_usage();
+            return 1;
+        }
+
+        if (std::strcmp(arg, "--node") == 0) {
+            node_id = static_cast<uint16_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--log") == 0) {
+            log_path = value;
+        } else if (std::strcmp(arg, "--format") == 0 && std::strcmp(value, "table") == 0) {
+            csv = false;
+        } else if (std::strcmp(arg, "--format") == 0 && std::strcmp(value, "csv") == 0) {
+            csv = true;
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+    if (dumps.empty()) {
+        print_usage();
+        return 1;
+    }
+
+    std::vector<host::DecodedEvent> events;
+    bool complete = true;
+    for (const std::string& path : dumps) {
+        std::vector<uint8_t> data;
+        if (!read_file(path, &data)) {
+            std::cerr << "Failed to read " << path << "\n";
+            return 1;
+        }
+        host::EventDecodeStats stats;
+        if (!host::decode_event_log(data.data(), data.size(), &events, &stats)) {
+            std::cerr << "Warning: " << path << " has undecodable data after "
+                      << stats.events << " events\n";
+            complete = false;
+        }
+        std::cerr << path << ": " << stats.batches << " batches, " << stats.events << " events, "
+                  << stats.padding_bytes << " padding bytes\n";
+    }
+
+    host::sort_events(&events);
+    uint64_t missing = host::count_missing_events(events);
+    if (!events.empty()) {
+        std::cerr << "Sequences " << events.front().sequence << ".." << events.back().sequence
+                  << ": " << events.size() << " events, " << missing << " missing\n";
+    }
+
+    core::ThresholdConfig config = core::get_default_config();
+    host::DecisionColumns columns;
+    columns.reserve(events.size());
+    for (const host::DecodedEvent& e : events) {
+        columns.push_back(host::event_to_decision_record(e, node_id, config));
+    }
+
+    if (csv) {
+        host::write_decision_csv(std::cout, columns);
+    } else {
+        host::print_decision_table(std::cout, columns);
+    }
+
+    if (!log_path.empty()) {
+        host::DecisionLogWriter writer;
+        bool ok = writer.open(log_path);
+        for (size_t i = 0; ok && i < columns.size(); ++i) {
+            ok = writer.append(columns.row(i));
+        }
+        if (!ok || !writer.close()) {
+            std::cerr << "Failed to write decision log " << log_path << "\n";
+            return 1;
+        }
+    }
+    return complete ? 0 : 2;
+}
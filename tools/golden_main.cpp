@@ -0,0 +1,285 @@
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "hal/hal_mock.h"
+#include "host/golden.h"
+#include "host/recording.h"
+
+using namespace spectral_gate;
+
+/**
+ * @brief Golden-vector corpus generator and differential checker
+ *
+ * --generate runs the reference (scalar) path over synthetic MockHAL
+ * windows, hand-built edge cases and optional recordings, and writes the
+ * expected outputs. Only regenerate when a change is meant to alter
+ * results, and review the diff. --check runs every kernel variant against
+ * an existing corpus and prints per-field differences.
+ */
+
+namespace {
+
+constexpr uint32_t SAMPLE_RATE = 1000;
+
+void print_usage() {
+    std::cout << "Usage: spectral_golden --generate PATH [options]\n"
+              << "       spectral_golden --check PATH [tolerances]\n"
+              << "  --seed N               MockHAL noise seed (default 1)\n"
+              << "  --recording PATH       Add windows from a raw int16 recording (repeatable)\n"
+              << "  --recording-windows N  Windows taken per recording (default 8)\n"
+              << "  --tol-spectral LSB     Allowed spectral difference (default 0)\n"
+              << "  --tol-features LSB     Allowed feature difference (default 0)\n"
+              << "  --tol-confidence LSB   Allowed confidence difference (default 0)\n";
+}
+
+// Battery levels cycled over cases so every threshold regime is covered
+const uint16_t BATTERY_LEVELS[] = {
+    4100,                       // Nominal
+    3500,                       // Between low and nominal
+    3200,                       // Low
+    2900                        // Critical
+};
+
+struct CaseBuilder {
+    core::SpectralProcessor spectral;
+    core::InferenceEngine engine;
+    core::ThresholdConfig config;
+    host::GoldenCorpus* corpus;
+
+    void add(const std::string& name, const std::vector<int16_t>& samples) {
+        size_t k = corpus->cases.size();
+        uint16_t battery = BATTERY_LEVELS[k % (sizeof(BATTERY_LEVELS) / sizeof(BATTERY_LEVELS[0]))];
+        corpus->cases.push_back(host::make_golden_case(
+            name, samples.data(), samples.size(), battery, spectral, engine, config));
+    }
+};
+
+void add_edge_cases(CaseBuilder* builder) {
+    const size_t n = hal::VIBRATION_BUFFER_SIZE;
+    std::vector<int16_t> w(n);
+
+    std::fill(w.begin(), w.end(), 0);
+    builder->add("zeros", w);
+
+    std::fill(w.begin(), w.end(), 4096);
+    builder->add("dc_1g", w);
+
+    std::fill(w.begin(), w.end(), 0);
+    w[n / 2] = 32767;
+    builder->add("impulse", w);
+
+    for (size_t i = 0; i < n; ++i) w[i] = ((i / 5) % 2 == 0) ? 32767 : -32768;
+    builder->add("square_full_scale", w);
+
+    for (size_t i = 0; i < n; ++i) w[i] = static_cast<int16_t>(-32768 + static_cast<int32_t>(i * 65535 / (n - 1)));
+    builder->add("ramp_full_scale", w);
+
+    for (size_t i = 0; i < n; ++i) w[i] = (i % 2 == 0) ? 12000 : -12000;
+    builder->add("nyquist", w);
+}
+
+void add_synthetic_cases(CaseBuilder* builder, uint32_t seed) {
+    hal::MockHAL mock;
+    mock.set_seed(seed);
+    std::vector<int16_t> w(hal::VIBRATION_BUFFER_SIZE);
+
+    const uint32_t frequencies[] = {10, 50, 100, 150, 237, 400, 490};
+    mock.set_vibration_pattern(1);
+    mock.set_signal_amplitude(8000);
+    mock.set_noise_level(500);
+    for (uint32_t f : frequencies) {
+        mock.set_signal_frequency(f);
+        mock.read_vibration_data(w.data(), w.size());
+        builder->add("sine_" + std::to_string(f) + "hz", w);
+    }
+
+    // Loud tone: the DFT accumulators see near-full-scale input
+    mock.set_signal_frequency(120);
+    mock.set_signal_amplitude(30000);
+    mock.set_noise_level(2000);
+    mock.read_vibration_data(w.data(), w.size());
+    builder->add("sine_120hz_loud", w);
+
+    mock.set_vibration_pattern(0);
+    const int16_t noise_levels[] = {100, 4000};
+    for (int16_t level : noise_levels) {
+        mock.set_noise_level(level);
+        mock.read_vibration_data(w.data(), w.size());
+        builder->add("noise_" + std::to_string(level), w);
+    }
+
+    mock.set_vibration_pattern(2);
+    mock.set_noise_level(500);
+    const int16_t amplitudes[] = {2000, 8000, 20000};
+    for (int16_t amplitude : amplitudes) {
+        mock.set_signal_amplitude(amplitude);
+        for (int repeat = 0; repeat < 2; ++repeat) {
+            mock.read_vibration_data(w.data(), w.size());
+            builder->add("anomaly_" + std::to_string(amplitude) + "_" + std::to_string(repeat), w);
+        }
+    }
+}
+
+// Two-tone windows searched for ones that reach each decision, so every
+// branch of evaluate_structure() is pinned (plain synthetic windows
+// mostly end in SLEEP)
+void add_decision_coverage(CaseBuilder* builder, size_t per_decision) {
+    const size_t n = hal::VIBRATION_BUFFER_SIZE;
+    const double pi = 3.14159265358979;
+    size_t found[3] = {0, 0, 0};
+    std::vector<int16_t> w(n);
+
+    const int16_t amplitudes[] = {8000, 20000, 32000};
+    for (int16_t amplitude : amplitudes) {
+        for (uint32_t f1 = 10; f1 < SAMPLE_RATE / 2; f1 += 13) {
+            for (uint32_t f2 = f1 + 13; f2 < SAMPLE_RATE / 2; f2 += 13) {
+                for (size_t i = 0; i < n; ++i) {
+                    double t = static_cast<double>(i) / SAMPLE_RATE;
+                    w[i] = static_cast<int16_t>(amplitude * 0.6 * std::sin(2.0 * pi * f1 * t) +
+                                                amplitude * 0.4 * std::sin(2.0 * pi * f2 * t));
+                }
+                for (uint16_t battery : BATTERY_LEVELS) {
+                    host::GoldenCase c = host::make_golden_case(
+                        "", w.data(), n, battery, builder->spectral, builder->engine, builder->config);
+                    size_t d = static_cast<size_t>(c.decision);
+                    if (found[d] >= per_decision) {
+                        continue;
+                    }
+                    c.name = std::string("tones_") + core::decision_to_string(c.decision) + "_" +
+                             std::to_string(found[d]);
+                    ++found[d];
+                    builder->corpus->cases.push_back(std::move(c));
+                }
+                if (found[0] >= per_decision && found[1] >= per_decision &&
+                    found[2] >= per_decision) {
+                    return;
+                }
+            }
+        }
+    }
+}
+
+bool add_recording(CaseBuilder* builder, const std::string& path, size_t max_windows) {
+    std::vector<int16_t> samples;
+    if (!host::load_recording(path, &samples)) {
+        return false;
+    }
+
+    const size_t n = hal::VIBRATION_BUFFER_SIZE;
+    size_t available = samples.size() / n;
+    size_t take = (available < max_windows) ? available : max_windows;
+    size_t slash = path.find_last_of("/\\");
+    std::string base = (slash == std::string::npos) ? path : path.substr(slash + 1);
+    for (char& ch : base) {
+        if (ch == ' ' || ch == '.') ch = '_';
+    }
+
+    // Evenly spaced windows across the recording
+    for (size_t k = 0; k < take; ++k) {
+        size_t start = (available * k / take) * n;
+        std::vector<int16_t> w(samples.begin() + start, samples.begin() + start + n);
+        builder->add("rec_" + base + "_" + std::to_string(k), w);
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string generate_path;
+    std::string check_path;
+    uint32_t seed = 1;
+    size_t recording_windows = 8;
+    std::vector<std::string> recordings;
+    host::GoldenTolerance tolerance = host::get_exact_tolerance();
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[++i] : nullptr;
+        if (value == nullptr) {
+            print_usage();
+            return 1;
+        }
+
+        if (std::strcmp(arg, "--generate") == 0) {
+            generate_path = value;
+        } else if (std::strcmp(arg, "--check") == 0) {
+            check_path = value;
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--recording") == 0) {
+            recordings.push_back(value);
+        } else if (std::strcmp(arg, "--recording-windows") == 0) {
+            recording_windows = std::strtoul(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--tol-spectral") == 0) {
+            tolerance.spectral_lsb = std::strtoll(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--tol-features") == 0) {
+            tolerance.feature_lsb = std::strtoll(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--tol-confidence") == 0) {
+            tolerance.confidence_lsb = std::strtoll(value, nullptr, 10);
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    if (generate_path.empty() == check_path.empty()) {
+        print_usage();
+        return 1;
+    }
+
+    if (!generate_path.empty()) {
+        host::GoldenCorpus corpus;
+        corpus.num_bins = hal::NUM_SPECTRAL_BINS;
+        corpus.sample_rate = SAMPLE_RATE;
+
+        CaseBuilder builder = {
+            core::SpectralProcessor(corpus.num_bins, corpus.sample_rate),
+            core::create_default_engine(),
+            core::get_default_config(),
+            &corpus
+        };
+        corpus.model_checksum = builder.engine.get_model_checksum();
+
+        add_edge_cases(&builder);
+        add_synthetic_cases(&builder, seed);
+        add_decision_coverage(&builder, 2);
+        for (const auto& path : recordings) {
+            if (!add_recording(&builder, path, recording_windows)) {
+                std::cerr << "Failed to read recording " << path << "\n";
+                return 1;
+            }
+        }
+
+        if (!host::save_golden_corpus(generate_path, corpus)) {
+            std::cerr << "Failed to write " << generate_path << "\n";
+            return 1;
+        }
+        std::cout << "Wrote " << corpus.cases.size() << " golden vectors to " << generate_path << "\n";
+        return 0;
+    }
+
+    host::GoldenCorpus corpus;
+    if (!host::load_golden_corpus(check_path, &corpus)) {
+        std::cerr << "Failed to load golden corpus " << check_path << "\n";
+        return 1;
+    }
+    if (corpus.model_checksum != core::create_default_engine().get_model_checksum()) {
+        std::cerr << "Golden corpus was generated with a different model; regenerate it\n";
+        return 1;
+    }
+
+    std::vector<host::GoldenVariantReport> reports;
+    bool passed = true;
+    for (const auto& variant : host::get_golden_variants()) {
+        reports.push_back(host::check_golden_variant(corpus, variant, tolerance));
+        passed = passed && reports.back().passed;
+    }
+    std::cout << corpus.cases.size() << " golden vectors\n";
+    host::print_golden_reports(std::cout, reports);
+    return passed ? 0 : 1;
+}
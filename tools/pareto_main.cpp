@@ -0,0 +1,121 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "core/op_counter.h"
+#include "host/dataset.h"
+#include "host/pareto.h"
+
+using namespace spectral_gate;
+
+/**
+ * @brief Accuracy-versus-energy explorer over pipeline configurations
+ *
+ * Evaluates the cross product of window length, pre-filter, similarity
+ * cache and decision thresholds over a labeled dataset, and prints the
+ * configurations on the F1 / energy-per-window Pareto frontier.
+ */
+
+namespace {
+
+constexpr uint32_t SAMPLE_RATE = 1000;
+
+void print_usage() {
+    std::cout << "Usage: spectral_pareto [options]\n"
+              << "  --dataset PATH    Manifest of labeled recordings (path battery_mv normal|anomaly)\n"
+              << "  --synthetic N     Add N seeded MockHAL windows (default 96 without --dataset)\n"
+              << "  --seed N          MockHAL noise seed (default 1)\n"
+              << "  --hop N           Samples between recording windows (default window length)\n"
+              << "  --threads N       Worker threads (default: hardware concurrency)\n"
+              << "  --table PATH      Cycle cost table overrides (key = value)\n"
+              << "  --tx-uj X         Energy per transmission in uJ (default 2000)\n"
+              << "  --csv PATH        Write every configuration as CSV\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string manifest_path;
+    std::string csv_path;
+    size_t synthetic = 0;
+    bool synthetic_set = false;
+    uint32_t seed = 1;
+    size_t hop = 0;
+    unsigned num_threads = 0;
+    host::EnergyModel energy = host::get_default_energy_model();
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[++i] : nullptr;
+        if (value == nullptr) {
+            print_usage();
+            return 1;
+        }
+
+        if (std::strcmp(arg, "--dataset") == 0) {
+            manifest_path = value;
+        } else if (std::strcmp(arg, "--synthetic") == 0) {
+            synthetic = std::strtoul(value, nullptr, 10);
+            synthetic_set = true;
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--hop") == 0) {
+            hop = std::strtoul(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            num_threads = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--table") == 0) {
+            if (!host::load_cost_table(value, &energy.compute)) {
+                std::cerr << "Failed to load cost table " << value << "\n";
+                return 1;
+            }
+        } else if (std::strcmp(arg, "--tx-uj") == 0) {
+            energy.tx_uj = std::strtod(value, nullptr);
+        } else if (std::strcmp(arg, "--csv") == 0) {
+            csv_path = value;
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    if (!core::OP_COUNTING_ENABLED) {
+        std::cerr << "Built without SPECTRAL_GATE_OP_COUNT; no operations counted\n";
+        return 1;
+    }
+    if (manifest_path.empty() && !synthetic_set) {
+        synthetic = 96;
+    }
+
+    host::Dataset dataset;
+    dataset.window_length = hal::VIBRATION_BUFFER_SIZE;
+    dataset.sample_rate = SAMPLE_RATE;
+    if (!manifest_path.empty() && !host::load_dataset_manifest(manifest_path, hop, &dataset)) {
+        std::cerr << "Failed to load dataset " << manifest_path << "\n";
+        return 1;
+    }
+    host::append_synthetic_windows(seed, synthetic, &dataset);
+    if (dataset.windows.empty()) {
+        std::cerr << "Dataset has no windows\n";
+        return 1;
+    }
+
+    host::ParetoStats stats;
+    std::vector<host::ParetoPoint> points = host::explore_pareto(
+        dataset, host::get_default_pareto_grid(), energy, num_threads, &stats);
+
+    std::cout << stats.configs << " configurations, " << stats.front_ends
+              << " cached front-ends, " << stats.windows << " windows\n";
+    host::print_pareto_frontier(std::cout, points);
+
+    if (!csv_path.empty()) {
+        std::ofstream csv(csv_path);
+        if (!csv) {
+            std::cerr << "Failed to write " << csv_path << "\n";
+            return 1;
+        }
+        host::write_pareto_csv(csv, points);
+    }
+    return 0;
+}
@@ -0,0 +1,175 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "host/log_query.h"
+
+using namespace spectral_gate;
+
+/**
+ * @brief Filtered per-node aggregates over a decision log
+ *
+ * Example: nodes that went TX_UNCERTAIN more than 20 times in the last
+ * week of the log:
+ *
+ *   spectral_query fleet.sgdl --decision TX_UNCERTAIN --last 604800 --min-count 21
+ */
+
+namespace {
+
+void print_usage() {
+    std::cout << "Usage: spectral_query LOG [options]\n"
+              << "  --node N          Only this node\n"
+              << "  --from S          Records at or after S seconds\n"
+              << "  --to S            Records at or before S seconds\n"
+              << "  --last S          Records in the last S seconds of the log\n"
+              << "  --decision D      SLEEP, TX_ALERT or TX_UNCERTAIN\n"
+              << "  --min-count N     Only nodes with at least N matching records\n"
+              << "  --threads N       Worker threads (default: hardware concurrency)\n"
+              << "  --index MODE      auto (default: reuse LOG.sgdx) or rebuild\n"
+              << "  --csv PATH        Write the aggregates as CSV\n";
+}
+
+bool parse_decision(const char* name, core::Decision* decision) {
+    const core::Decision all[] = {
+        core::Decision::SLEEP, core::Decision::TX_ALERT, core::Decision::TX_UNCERTAIN
+    };
+    for (core::Decision d : all) {
+        if (std::strcmp(name, core::decision_to_string(d)) == 0) {
+            *decision = d;
+            return true;
+        }
+    }
+    return false;
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        print_usage();
+        return 1;
+    }
+    std::string log_path = argv[1];
+    std::string csv_path;
+    host::LogQuery query = host::get_default_log_query();
+    uint32_t last_s = 0;
+    bool last_set = false;
+    uint64_t min_count = 1;
+    unsigned num_threads = 0;
+    bool rebuild = false;
+
+    for (int i = 2; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[++i] : nullptr;
+        if (value == nullptr) {
+            print_usage();
+            return 1;
+        }
+
+        if (std::strcmp(arg, "--node") == 0) {
+            query.filter_node = true;
+            query.node_id = static_cast<uint16_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--from") == 0) {
+            query.from_s = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--to") == 0) {
+            query.to_s = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--last") == 0) {
+            last_s = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+            last_set = true;
+        } else if (std::strcmp(arg, "--decision") == 0) {
+            if (!parse_decision(value, &query.decision)) {
+                print_usage();
+                return 1;
+            }
+            query.filter_decision = true;
+        } else if (std::strcmp(arg, "--min-count") == 0) {
+            min_count = std::strtoull(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            num_threads = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--index") == 0 && std::strcmp(value, "auto") == 0) {
+            rebuild = false;
+        } else if (std::strcmp(arg, "--index") == 0 && std::strcmp(value, "rebuild") == 0) {
+            rebuild = true;
+        } else if (std::strcmp(arg, "--csv") == 0) {
+            csv_path = value;
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    host::DecisionLogIndex index;
+    if (!index.open(log_path, num_threads, rebuild)) {
+        std::cerr << "Failed to index decision log " << log_path << "\n";
+        return 1;
+    }
+    double open_s = seconds_since(start);
+
+    if (last_set) {
+        uint32_t end = index.get_max_time();
+        query.from_s = (end > last_s) ? end - last_s : 0;
+    }
+
+    start = std::chrono::steady_clock::now();
+    host::LogQueryStats stats;
+    std::vector<host::NodeAggregate> aggregates = index.aggregate(query, num_threads, &stats);
+    double query_s = seconds_since(start);
+
+    std::cout << index.get_records() << " records, " << index.get_nodes().size() << " nodes, "
+              << index.get_num_stripes() << " stripes; index "
+              << (index.loaded_from_file() ? "loaded" : "built") << " in "
+              << open_s * 1000.0 << " ms\n\n";
+
+    std::cout << "  node   windows     sleep     alert uncertain  mean_conf  min_mV    first_s     last_s\n";
+    size_t shown = 0;
+    for (const host::NodeAggregate& a : aggregates) {
+        if (a.windows < min_count) {
+            continue;
+        }
+        char line[160];
+        std::snprintf(line, sizeof(line), "%6u %9llu %9llu %9llu %9llu %10.3f %7u %10u %10u\n",
+                      static_cast<unsigned>(a.node_id),
+                      static_cast<unsigned long long>(a.windows),
+                      static_cast<unsigned long long>(a.decisions[0]),
+                      static_cast<unsigned long long>(a.decisions[1]),
+                      static_cast<unsigned long long>(a.decisions[2]),
+                      a.mean_confidence(),
+                      static_cast<unsigned>(a.min_battery_mv),
+                      static_cast<unsigned>(a.first_s),
+                      static_cast<unsigned>(a.last_s));
+        std::cout << line;
+        ++shown;
+    }
+    std::cout << "(" << shown << " of " << aggregates.size() << " matching nodes; "
+              << stats.stripes_scanned << "/" << stats.stripes_total << " stripes in range, "
+              << stats.records_examined << " records examined, "
+              << stats.records_matched << " matched in " << query_s * 1000.0 << " ms)\n";
+
+    if (!csv_path.empty()) {
+        std::ofstream csv(csv_path);
+        csv << "node_id,windows,sleep,tx_alert,tx_uncertain,mean_confidence,min_battery_mv,first_s,last_s\n";
+        for (const host::NodeAggregate& a : aggregates) {
+            if (a.windows < min_count) {
+                continue;
+            }
+            csv << a.node_id << "," << a.windows << "," << a.decisions[0] << ","
+                << a.decisions[1] << "," << a.decisions[2] << "," << a.mean_confidence() << ","
+                << a.min_battery_mv << "," << a.first_s << "," << a.last_s << "\n";
+        }
+        if (!csv) {
+            std::cerr << "Failed to write " << csv_path << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "host/replay.h"
+
+using namespace spectral_gate;
+
+/**
+ * @brief Offline decision replay
+ *
+ * Re-runs every decision in one or more decision logs with the current
+ * code and a (possibly modified) threshold configuration, and reports
+ * where the replay disagrees with what the nodes logged. Example: what a
+ * base threshold of 0.7 would have changed, with uploaded raw windows
+ * going through the whole pipeline:
+ *
+ *   spectral_replay fleet.sgdl --windows uploads.txt --base 0.7
+ */
+
+namespace {
+
+void print_usage() {
+    std::cout << "Usage: spectral_replay LOG [LOG...] [options]\n"
+              << "  --windows PATH    Manifest of uploaded windows (node_id time_s recording)\n"
+              << "  --base X          Base confidence threshold (default 0.65)\n"
+              << "  --low X           Low-battery multiplier (default 1.2)\n"
+              << "  --critical X      Critical-battery multiplier (default 1.5)\n"
+              << "  --min-peaks N     Spectral peaks required (default 2)\n"
+              << "  --min-magnitude X Peak magnitude gate (default 0.1)\n"
+              << "  --threads N       Worker threads (default: hardware concurrency)\n"
+              << "  --show N          Divergent records to print (default 20)\n"
+              << "  --csv PATH        Write every divergent record as CSV\n";
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> log_paths;
+    std::string windows_path;
+    std::string csv_path;
+    host::ReplayConfig config = host::get_default_replay_config();
+    size_t show = 20;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strncmp(arg, "--", 2) != 0) {
+            log_paths.push_back(arg);
+            continue;
+        }
+        const char* value = (i + 1 < argc) ? argv[++i] : nullptr;
+        if (value == nullptr) {
+            print_usage();
+            return 1;
+        }
+
+        if (std::strcmp(arg, "--windows") == 0) {
+            windows_path = value;
+        } else if (std::strcmp(arg, "--base") == 0) {
+            config.thresholds.base_confidence_threshold = hal::float_to_fixed(std::strtof(value, nullptr));
+        } else if (std::strcmp(arg, "--low") == 0) {
+            config.thresholds.low_battery_multiplier = hal::float_to_fixed(std::strtof(value, nullptr));
+        } else if (std::strcmp(arg, "--critical") == 0) {
+            config.thresholds.critical_battery_multiplier = hal::float_to_fixed(std::strtof(value, nullptr));
+        } else if (std::strcmp(arg, "--min-peaks") == 0) {
+            config.thresholds.min_peaks_for_detection = static_cast<uint8_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--min-magnitude") == 0) {
+            config.thresholds.min_peak_magnitude = hal::float_to_fixed(std::strtof(value, nullptr));
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            config.num_threads = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--show") == 0) {
+            show = std::strtoul(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--csv") == 0) {
+            csv_path = value;
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+    if (log_paths.empty()) {
+        print_usage();
+        return 1;
+    }
+
+    host::DecisionColumns log;
+    for (const std::string& path : log_paths) {
+        size_t before = log.size();
+        if (!host::read_decision_log(path, &log)) {
+            if (log.size() == before) {
+                std::cerr << "Failed to read decision log " << path << "\n";
+                return 1;
+            }
+            std::cerr << "Warning: " << path << " ends in a torn block; replaying "
+                      << log.size() - before << " complete records\n";
+        }
+    }
+
+    std::vector<host::ReplayWindow> windows;
+    if (!windows_path.empty() && !host::load_replay_windows(windows_path, &windows)) {
+        std::cerr << "Failed to load windows from " << windows_path << "\n";
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    host::ReplayReport report = host::replay_decisions(log, windows, config);
+    double replay_s = seconds_since(start);
+
+    host::print_replay_report(std::cout, report, show);
+    std::cout << "(" << windows.size() << " uploaded windows; replay took "
+              << replay_s * 1000.0 << " ms)\n";
+
+    if (!csv_path.empty()) {
+        std::ofstream csv(csv_path);
+        host::write_replay_divergences_csv(csv, report);
+        if (!csv) {
+            std::cerr << "Failed to write " << csv_path << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "host/scenario.h"
+
+using namespace spectral_gate;
+
+/**
+ * @brief Scenario runner
+ *
+ * Runs every scenario in one or more scenario files (scenario.h; the demo
+ * and regression suites live in data/scenarios) through the real pipeline
+ * on MockHAL's virtual clock, in parallel, and reports pass/fail and
+ * runtime per scenario. Exits non-zero if any expectation fails:
+ *
+ *   spectral_scenarios data/scenarios/regression.csv --threads 8 --csv results.csv
+ */
+
+namespace {
+
+void print_usage() {
+    std::cout << "Usage: spectral_scenarios FILE [FILE...] [options]\n"
+              << "  --threads N       Worker threads (default: hardware concurrency)\n"
+              << "  --csv PATH        Write one row per scenario as CSV\n";
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> paths;
+    std::string csv_path;
+    unsigned num_threads = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strncmp(arg, "--", 2) != 0) {
+            paths.push_back(arg);
+            continue;
+        }
+        const char* value = (i + 1 < argc) ? argv[++i] : nullptr;
+        if (value == nullptr) {
+            print_usage();
+            return 1;
+        }
+
+        if (std::strcmp(arg, "--threads") == 0) {
+            num_threads = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--csv") == 0) {
+            csv_path = value;
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+    if (paths.empty()) {
+        print_usage();
+        return 1;
+    }
+
+    std::vector<host::Scenario> scenarios;
+    for (const std::string& path : paths) {
+        std::string error;
+        if (!host::load_scenarios(path, &scenarios, &error)) {
+            std::cerr << error << "\n";
+            return 1;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<host::ScenarioResult> results =
+        host::run_scenarios(scenarios, core::get_default_config(), num_threads);
+    double run_s = seconds_since(start);
+
+    host::print_scenario_report(std::cout, results);
+    std::cout << "(run took " << run_s * 1000.0 << " ms)\n";
+
+    if (!csv_path.empty()) {
+        std::ofstream csv(csv_path);
+        host::write_scenario_csv(csv, results);
+        if (!csv) {
+            std::cerr << "Failed to write " << csv_path << "\n";
+            return 1;
+        }
+    }
+
+    for (const host::ScenarioResult& result : results) {
+        if (!result.passed()) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,114 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "host/recording.h"
+#include "host/stft.h"
+#include "host/trace_export.h"
+#include "core/trace.h"
+
+using namespace spectral_gate;
+
+/**
+ * @brief Offline spectrogram generator
+ * 
+ * Computes device-identical magnitude spectra over a raw int16 recording
+ * and writes a compact .sgsp spectrogram file.
+ */
+
+void print_usage() {
+    std::cout << "Usage: spectral_stft <input.raw> <output.sgsp> [options]\n"
+              << "  --window N     Samples per frame (default 256)\n"
+              << "  --hop N        Samples between frames (default = window)\n"
+              << "  --bins N       Frequency bins (default 64)\n"
+              << "  --rate HZ      Sample rate (default 1000)\n"
+              << "  --threads N    Worker threads (default: all cores)\n"
+              << "  --format F     u16 | f16 (default u16)\n"
+              << "  --trace PATH   Write a Chrome trace of the worker threads\n";
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        print_usage();
+        return 1;
+    }
+    
+    std::string input = argv[1];
+    std::string output = argv[2];
+    host::StftConfig config = host::get_default_stft_config();
+    host::SpectrogramFormat format = host::SpectrogramFormat::UINT16;
+    bool hop_set = false;
+    std::string trace_path;
+    
+    for (int i = 3; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (value == nullptr) {
+            print_usage();
+            return 1;
+        }
+        
+        if (std::strcmp(arg, "--window") == 0) {
+            config.window_length = std::strtoul(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--hop") == 0) {
+            config.hop = std::strtoul(value, nullptr, 10);
+            hop_set = true;
+        } else if (std::strcmp(arg, "--bins") == 0) {
+            config.num_bins = std::strtoul(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--rate") == 0) {
+            config.sample_rate = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            config.num_threads = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--trace") == 0) {
+            trace_path = value;
+        } else if (std::strcmp(arg, "--format") == 0) {
+            format = (std::strcmp(value, "f16") == 0) ? host::SpectrogramFormat::FLOAT16
+                                                      : host::SpectrogramFormat::UINT16;
+        } else {
+            print_usage();
+            return 1;
+        }
+        ++i;
+    }
+    if (!hop_set) {
+        config.hop = config.window_length;
+    }
+    
+    std::vector<int16_t> samples;
+    if (!host::load_recording(input, &samples)) {
+        std::cerr << "Failed to read recording: " << input << "\n";
+        return 1;
+    }
+    
+    if (!trace_path.empty()) {
+        core::trace::set_enabled(true);
+        SG_TRACE_THREAD_NAME("main");
+    }
+    
+    host::Spectrogram spectrogram;
+    if (!host::compute_stft(samples.data(), samples.size(), config, &spectrogram)) {
+        std::cerr << "Invalid STFT configuration\n";
+        return 1;
+    }
+    
+    if (!host::write_spectrogram(output, spectrogram, format)) {
+        std::cerr << "Failed to write spectrogram: " << output << "\n";
+        return 1;
+    }
+    
+    if (!trace_path.empty()) {
+        core::trace::set_enabled(false);
+        if (!host::write_chrome_trace(trace_path)) {
+            std::cerr << "Failed to write trace: " << trace_path << "\n";
+            return 1;
+        }
+    }
+    
+    std::cout << "Frames: " << spectrogram.num_frames
+              << " | Bins: " << config.num_bins
+              << " | Window: " << config.window_length
+              << " | Hop: " << config.hop << "\n";
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "host/dataset.h"
+#include "host/threshold_tuner.h"
+
+using namespace spectral_gate;
+
+/**
+ * @brief ThresholdConfig grid search
+ *
+ * Runs the pipeline once per dataset window to cache the decision
+ * inputs, then scores every candidate configuration on the cached
+ * inputs. Prints the best candidates (fewest missed alerts, then fewest
+ * transmissions) next to get_default_config().
+ */
+
+namespace {
+
+constexpr uint32_t SAMPLE_RATE = 1000;
+
+void print_usage() {
+    std::cout << "Usage: spectral_tune [options]\n"
+              << "  --dataset PATH    Manifest of labeled recordings (path battery_mv normal|anomaly)\n"
+              << "  --synthetic N     Add N seeded MockHAL windows (default 240 without --dataset)\n"
+              << "  --seed N          MockHAL noise seed (default 1)\n"
+              << "  --hop N           Samples between recording windows (default window length)\n"
+              << "  --threads N       Worker threads (default: hardware concurrency)\n"
+              << "  --top N           Candidates to print (default 10)\n"
+              << "  --tx-uj X         Energy per transmission in uJ (default 2000)\n"
+              << "  --csv PATH        Write every candidate as CSV\n"
+              << "  --feature-cache PATH  Reuse/extend an on-disk feature cache\n";
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string manifest_path;
+    std::string csv_path;
+    std::string cache_path;
+    size_t synthetic = 0;
+    bool synthetic_set = false;
+    uint32_t seed = 1;
+    size_t hop = 0;
+    unsigned num_threads = 0;
+    size_t top = 10;
+    double tx_uj = 2000.0;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[++i] : nullptr;
+        if (value == nullptr) {
+            print_usage();
+            return 1;
+        }
+
+        if (std::strcmp(arg, "--dataset") == 0) {
+            manifest_path = value;
+        } else if (std::strcmp(arg, "--synthetic") == 0) {
+            synthetic = std::strtoul(value, nullptr, 10);
+            synthetic_set = true;
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--hop") == 0) {
+            hop = std::strtoul(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            num_threads = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--top") == 0) {
+            top = std::strtoul(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--tx-uj") == 0) {
+            tx_uj = std::strtod(value, nullptr);
+        } else if (std::strcmp(arg, "--csv") == 0) {
+            csv_path = value;
+        } else if (std::strcmp(arg, "--feature-cache") == 0) {
+            cache_path = value;
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    if (manifest_path.empty() && !synthetic_set) {
+        synthetic = 240;
+    }
+
+    host::Dataset dataset;
+    dataset.window_length = hal::VIBRATION_BUFFER_SIZE;
+    dataset.sample_rate = SAMPLE_RATE;
+    if (!manifest_path.empty() && !host::load_dataset_manifest(manifest_path, hop, &dataset)) {
+        std::cerr << "Failed to load dataset " << manifest_path << "\n";
+        return 1;
+    }
+    host::append_synthetic_windows(seed, synthetic, &dataset);
+    if (dataset.windows.empty()) {
+        std::cerr << "Dataset has no windows\n";
+        return 1;
+    }
+
+    host::FeatureCache cache;
+    if (!cache_path.empty() && !cache.open(cache_path)) {
+        std::cerr << "Failed to open feature cache " << cache_path << "\n";
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    host::DecisionInputs inputs;
+    host::collect_decision_inputs(dataset, cache_path.empty() ? nullptr : &cache, num_threads, &inputs);
+    double collect_s = seconds_since(start);
+
+    std::vector<core::ThresholdConfig> candidates =
+        host::expand_tuner_grid(host::get_default_tuner_grid());
+    start = std::chrono::steady_clock::now();
+    std::vector<host::TunerResult> results =
+        host::sweep_thresholds(inputs, candidates, tx_uj, num_threads);
+    double sweep_s = seconds_since(start);
+
+    std::cout << "Cached " << dataset.windows.size() << " windows in " << collect_s << " s; swept "
+              << candidates.size() << " candidates in " << sweep_s << " s\n";
+    if (!cache_path.empty()) {
+        host::FeatureCacheStats stats = cache.get_stats();
+        std::cout << "Feature cache: " << stats.hits << " hits, " << stats.misses << " misses, "
+                  << cache.size() << " entries\n";
+    }
+    std::cout << "\n";
+
+    std::cout << "Default configuration\n";
+    std::vector<host::TunerResult> baseline = host::sweep_thresholds(
+        inputs, {core::get_default_config()}, tx_uj, 1);
+    host::print_tuner_results(std::cout, baseline, dataset.windows.size(), 1);
+
+    if (!csv_path.empty()) {
+        std::ofstream csv(csv_path);
+        if (!csv) {
+            std::cerr << "Failed to write " << csv_path << "\n";
+            return 1;
+        }
+        host::write_tuner_csv(csv, results);
+    }
+
+    std::cout << "\nBest candidates\n";
+    host::rank_tuner_results(&results);
+    host::print_tuner_results(std::cout, results, dataset.windows.size(), top);
+    return 0;
+}